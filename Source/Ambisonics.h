@@ -0,0 +1,38 @@
+// Ambisonics.h - First-order ambisonic (AmbiX) encoding gains
+#pragma once
+
+#include <array>
+#include <cmath>
+
+//==============================================================================
+// AmbiX first order: ACN channel order (W, Y, Z, X) with SN3D normalization.
+// Gains come back in that lane order so one Float4 multiply-add encodes a
+// source into all four channels.
+//==============================================================================
+struct FoaEncoder {
+    static constexpr int NUM_CHANNELS = 4;
+
+    // First-order level of a diffuse (isotropic) field relative to W in SN3D
+    static constexpr float DIFFUSE_GAIN = 0.57735027f;   // 1 / sqrt(3)
+
+    // Stereo sources sit at +/-30 degrees azimuth
+    static constexpr float STEREO_SIN = 0.5f;
+    static constexpr float STEREO_COS = 0.86602540f;
+
+    // Direction as a listener-relative vector (front, left, up); any length
+    static std::array<float, 4> fromVector(float front, float left, float up)
+    {
+        const float length = std::sqrt(front * front + left * left + up * up);
+        if (length <= 0.0f)
+            return { 1.0f, 0.0f, 0.0f, 0.0f };
+        const float inv = 1.0f / length;
+        return { 1.0f, left * inv, up * inv, front * inv };
+    }
+
+    // Azimuth counter-clockwise from the front, elevation upwards (radians)
+    static std::array<float, 4> fromAngles(float azimuth, float elevation)
+    {
+        const float c = std::cos(elevation);
+        return { 1.0f, std::sin(azimuth) * c, std::sin(elevation), std::cos(azimuth) * c };
+    }
+};
@@ -1,28 +1,33 @@
 // DelayMemoryPool.h - Fixed for JUCE 8.0.12
 #pragma once
 
-#include <JuceHeader.h>
+#include "DspCore.h"
 #include <vector>
 
 class DelayMemoryPool {
 public:
     // Ensure size is a power of two for the bitwise mask to work safely
     DelayMemoryPool(size_t requestedSize = 131072)
-        : buffer(juce::nextPowerOfTwo((int)requestedSize), 0),
-        mask(buffer.size() - 1),
+        : buffer(dsp256::nextPowerOfTwo((int)requestedSize), 0),
         writePtr(0),
+        mask(buffer.size() - 1),
         sampleRate(44100.0)
     {
-        juce::Random rng;
-        for (auto& sample : buffer) {
-            sample = rng.nextInt(juce::Range<int32_t>(-100, 100));
-        }
+        fillNoiseFloor();
     }
 
     void prepare(double sr) {
         sampleRate = sr;
     }
 
+    // Reproducible noise floor and bit flips for offline regression renders.
+    // Refills the whole buffer, so not for the audio thread.
+    void setRandomSeed(int64_t seed) {
+        random.setSeed(seed);
+        fillNoiseFloor();
+        writePtr = 0;
+    }
+
     int32_t readContended(int offset, int effectID, bool& contention) {
         // Removed 'static' to prevent cross-instance interference
         int busArbiter = (int)writePtr;
@@ -30,7 +35,7 @@ public:
 
         if ((busArbiter % 4) != effectID % 4) {
             contention = true;
-            offset = juce::jmax(1, offset - 1);
+            offset = dsp256::jmax(1, offset - 1);
         }
 
         // Masking is now safe because size is forced to power of two
@@ -38,12 +43,31 @@ public:
         return buffer[readPos];
     }
 
+    // Linear-interpolated read for modulated delays (offset in samples, >= 1).
+    // Result stays in the raw fixed-point domain, just with a fractional part.
+    float readFractional(float offset) const {
+        float a, b, frac;
+        readFractionalTaps(offset, a, b, frac);
+        return a + (b - a) * frac;
+    }
+
+    // The two samples readFractional() blends and the fraction between them,
+    // for callers that interpolate several reads as one vector
+    void readFractionalTaps(float offset, float& a, float& b, float& frac) const {
+        const int whole = static_cast<int>(offset);
+        frac = offset - static_cast<float>(whole);
+        const size_t pos = static_cast<size_t>(static_cast<int64_t>(writePtr) - whole) & mask;
+        a = static_cast<float>(buffer[pos]);
+        b = static_cast<float>(buffer[(pos - 1) & mask]);
+    }
+
     void write(int32_t sample, int effectID) {
-        juce::ignoreUnused(effectID);
+        dsp256::ignoreUnused(effectID);
         buffer[writePtr] = sample;
         writePtr = (writePtr + 1) & mask;
 
-        if (juce::Random::getSystemRandom().nextInt(10000) < 1) {
+        // Per-pool generator: no shared state between instances or threads
+        if (random.nextInt(10000) < 1) {
             buffer[writePtr] ^= 0x01;
         }
     }
@@ -60,4 +84,11 @@ private:
     size_t writePtr;
     size_t mask;
     double sampleRate;
+    dsp256::Random random;        // Noise floor and bit-flip emulation
+
+    void fillNoiseFloor() {
+        for (auto& sample : buffer) {
+            sample = random.nextInt(dsp256::Range<int32_t>(-100, 100));
+        }
+    }
 };
\ No newline at end of file
@@ -0,0 +1,132 @@
+// DisplayText.h - Allocation-free number formatting for LCD readouts
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+//==============================================================================
+// Fixed-size, NUL-terminated text. Numbers are rounded to a fixed number of
+// decimals and written digit by digit: no heap, no locale, no printf.
+//==============================================================================
+struct DisplayText {
+    static constexpr int CAPACITY = 32;
+    static constexpr int MAX_DECIMALS = 6;
+
+    char text[CAPACITY] = {};
+    int length = 0;
+
+    const char* c_str() const noexcept { return text; }
+
+    void clear() noexcept
+    {
+        length = 0;
+        text[0] = '\0';
+    }
+
+    void append(char c) noexcept
+    {
+        if (length < CAPACITY - 1) {
+            text[length++] = c;
+            text[length] = '\0';
+        }
+    }
+
+    void append(const char* s) noexcept
+    {
+        while (*s != '\0')
+            append(*s++);
+    }
+
+    // Value as round(value * 10^decimals), e.g. from quantize()
+    void appendFixed(int64_t scaled, int decimals) noexcept
+    {
+        if (scaled < 0) {
+            append('-');
+            scaled = -scaled;
+        }
+
+        char digits[24];
+        int count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + scaled % 10);
+            scaled /= 10;
+        } while (scaled > 0 || count <= decimals);
+
+        while (count > 0) {
+            if (count == decimals)
+                append('.');
+            append(digits[--count]);
+        }
+    }
+
+    void appendNumber(float value, int decimals) noexcept
+    {
+        if (!std::isfinite(value)) {
+            append("--");
+            return;
+        }
+        appendFixed(quantize(value, decimals), decimals);
+    }
+
+    static int64_t quantize(float value, int decimals) noexcept
+    {
+        static constexpr double scales[MAX_DECIMALS + 1] = { 1.0, 10.0, 100.0, 1.0e3, 1.0e4, 1.0e5, 1.0e6 };
+        const int clamped = decimals < 0 ? 0 : (decimals > MAX_DECIMALS ? MAX_DECIMALS : decimals);
+        return std::llround(static_cast<double>(value) * scales[clamped]);
+    }
+
+    bool operator==(const DisplayText& other) const noexcept
+    {
+        return length == other.length && std::memcmp(text, other.text, static_cast<size_t>(length)) == 0;
+    }
+
+    bool operator!=(const DisplayText& other) const noexcept { return !(*this == other); }
+};
+
+//==============================================================================
+// A readout with fixed precision and suffix that remembers the last quantized
+// value: update() only reformats, and only reports a change, when the shown
+// digits would differ. Knob drags that stay within one step cost a compare.
+//==============================================================================
+class CachedDisplayValue {
+public:
+    void setFormat(int newDecimals, const char* newSuffix) noexcept
+    {
+        decimals = newDecimals < 0 ? 0 : (newDecimals > DisplayText::MAX_DECIMALS ? DisplayText::MAX_DECIMALS : newDecimals);
+        suffix.clear();
+        suffix.append(newSuffix);
+        valid = false;
+    }
+
+    // True if the text changed
+    bool update(float value) noexcept
+    {
+        const bool finite = std::isfinite(value);
+        const int64_t scaled = finite ? DisplayText::quantize(value, decimals) : 0;
+        if (valid && finite == lastFinite && scaled == lastScaled)
+            return false;
+
+        lastScaled = scaled;
+        lastFinite = finite;
+        valid = true;
+
+        text.clear();
+        if (finite)
+            text.appendFixed(scaled, decimals);
+        else
+            text.append("--");
+        text.append(suffix.c_str());
+        return true;
+    }
+
+    const DisplayText& getText() const noexcept { return text; }
+
+private:
+    int decimals = 2;
+    DisplayText suffix;
+    DisplayText text;
+    int64_t lastScaled = 0;
+    bool lastFinite = true;
+    bool valid = false;
+};
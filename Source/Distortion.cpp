@@ -0,0 +1,466 @@
+// Distortion.cpp - Antialiased Distortion Implementation
+#include "Distortion.h"
+#include <cmath>
+
+//==============================================================================
+Distortion::Distortion()
+{
+    sampleRate = 44100.0;
+
+    buildCurveTables();
+    buildOversamplers();
+    updateParameters();
+    reset();
+}
+
+//==============================================================================
+std::vector<EffectParameter> Distortion::getParameterDefinitions() const
+{
+    return {
+        EffectParameter("drive", "Drive", "DRIVE", "dB", 0.0f, 40.0f, 12.0f, 0.1f, false),
+        EffectParameter("shape", "Curve Shape", "SHAPE", "", 0.0f, 2.0f, 0.0f, 1.0f, false),
+        EffectParameter("adaa", "Antialiasing", "ADAA", "", 0.0f, 2.0f, 1.0f, 1.0f, false),
+        EffectParameter("oversample", "Oversampling", "OVRSMP", "", 0.0f, 2.0f, 0.0f, 1.0f, false),
+        EffectParameter("tone", "Tone", "TONE", "Hz", 1000.0f, 20000.0f, 8000.0f, 1.0f, true),
+        EffectParameter("level", "Output Level", "LEVEL", "dB", -24.0f, 6.0f, 0.0f, 0.1f, false),
+        EffectParameter("mix", "Dry/Wet Mix", "MIX", "%", 0.0f, 100.0f, 100.0f, 0.1f, false)
+    };
+}
+
+//==============================================================================
+std::vector<EffectPreset> Distortion::getFactoryPresets() const
+{
+    return {
+        EffectPreset("Warm Overdrive", "Soft tanh drive, ADAA 1st order", {0.3f, 0.0f, 0.5f, 0.0f, 0.6f, 0.8f, 1.0f}),
+        EffectPreset("Digital Clip", "Hard clip at full scale", {0.6f, 0.5f, 1.0f, 0.0f, 0.8f, 0.75f, 1.0f}),
+        EffectPreset("Tube Fuzz", "Asymmetric curve, even harmonics", {0.9f, 1.0f, 1.0f, 0.5f, 0.5f, 0.7f, 1.0f}),
+        EffectPreset("Extreme Drive", "Maximum drive, 4x oversampled", {1.0f, 0.5f, 1.0f, 1.0f, 0.5f, 0.65f, 1.0f}),
+        EffectPreset("Parallel Grit", "Blend of dry and driven", {0.5f, 0.0f, 0.5f, 0.0f, 0.7f, 0.8f, 0.4f})
+    };
+}
+
+void Distortion::loadPreset(const EffectPreset& preset)
+{
+    if (preset.parameterValues.size() >= 7) {
+        drive = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[0]);
+        shape = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[1]);
+        antialiasing = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[2]);
+        oversampling = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[3]);
+        tone = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[4]);
+        level = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[5]);
+        mix = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[6]);
+        updateParameters();
+    }
+}
+
+EffectPreset Distortion::getCurrentPreset() const
+{
+    return EffectPreset("Current Settings", "Current distortion parameters",
+        { drive, shape, antialiasing, oversampling, tone, level, mix });
+}
+
+void Distortion::prepare(double sr, int samplesPerBlock)
+{
+    sampleRate = sr;
+    blockSize = samplesPerBlock;
+    updateParameters();
+    reset();
+}
+
+void Distortion::reset()
+{
+    for (auto& ch : channels) {
+        clearChannel(ch);
+        ch.dryHistory.fill(0.0f);
+        ch.dryPos = 0;
+    }
+}
+
+void Distortion::releaseResources() {}
+
+int Distortion::getLatencySamples() const
+{
+    // ADAA1 delays by half a sample, ADAA2 by one (both at the shaper rate);
+    // the linear-phase interpolator and decimator add (N - 1) shaper samples
+    const int factor = oversamplers[static_cast<size_t>(oversampleIndex)].factor;
+    double shaperDelay = 0.5 * adaaOrder;
+    if (factor > 1)
+        shaperDelay += static_cast<double>(TAPS_PER_PHASE * factor - 1);
+    return static_cast<int>(shaperDelay / factor + 0.5);
+}
+
+void Distortion::setParameter(int parameterIndex, float value)
+{
+    value = dsp256::jlimit(0.0f, 1.0f, value);
+    if (getParameter(parameterIndex) == value)
+        return;
+
+    switch (parameterIndex) {
+    case 0: drive = value; break;
+    case 1: shape = value; break;
+    case 2: antialiasing = value; break;
+    case 3: oversampling = value; break;
+    case 4: tone = value; break;
+    case 5: level = value; break;
+    case 6: mix = value; break;
+    }
+    updateParameters();
+}
+
+float Distortion::getParameter(int parameterIndex) const
+{
+    switch (parameterIndex) {
+    case 0: return drive;
+    case 1: return shape;
+    case 2: return antialiasing;
+    case 3: return oversampling;
+    case 4: return tone;
+    case 5: return level;
+    case 6: return mix;
+    default: return 0.0f;
+    }
+}
+
+dsp256::String Distortion::getParameterDisplay(int parameterIndex) const
+{
+    switch (parameterIndex) {
+    case 0: return dsp256::String(drive * 40.0f, 1) + " dB";
+    case 1: {
+        static const char* const names[] = { "Soft", "Hard", "Asym" };
+        return names[stepIndex(shape, NUM_SHAPES)];
+    }
+    case 2: {
+        static const char* const names[] = { "Off", "1st", "2nd" };
+        return names[stepIndex(antialiasing, 3)];
+    }
+    case 3: return dsp256::String(oversamplers[static_cast<size_t>(stepIndex(oversampling, 3))].factor) + "x";
+    case 4: return dsp256::String(1000.0f * std::pow(20.0f, tone), 0) + " Hz";
+    case 5: return dsp256::String(-24.0f + level * 30.0f, 1) + " dB";
+    case 6: return dsp256::String(mix * 100.0f, 0) + "%";
+    default: return "";
+    }
+}
+
+int Distortion::stepIndex(float normalized, int numSteps)
+{
+    return dsp256::jlimit(0, numSteps - 1,
+        static_cast<int>(normalized * static_cast<float>(numSteps - 1) + 0.5f));
+}
+
+void Distortion::updateParameters()
+{
+    validateParameters();
+
+    driveGain = dsp256::Decibels::decibelsToGain(drive * 40.0f);
+    outputGain = dsp256::Decibels::decibelsToGain(-24.0f + level * 30.0f);
+    shapeIndex = stepIndex(shape, NUM_SHAPES);
+
+    const int newOrder = stepIndex(antialiasing, 3);
+    const int newOversample = stepIndex(oversampling, 3);
+
+    // Oversampling changes the shaper rate: histories no longer line up
+    if (newOversample != oversampleIndex) {
+        oversampleIndex = newOversample;
+        for (auto& ch : channels)
+            clearChannel(ch);
+    }
+
+    // Rebuild the cached divided difference so switching to ADAA2 doesn't click
+    if (newOrder != adaaOrder) {
+        adaaOrder = newOrder;
+        for (auto& ch : channels) {
+            const double dx = ch.x1 - ch.x2;
+            ch.d1Prev = std::abs(dx) > 1.0e-6 ? (evalF2(ch.x1) - evalF2(ch.x2)) / dx
+                                              : evalF1(0.5 * (ch.x1 + ch.x2));
+        }
+    }
+
+    dryDelay = getLatencySamples();
+
+    const float toneHz = dsp256::jmin(1000.0f * std::pow(20.0f, tone), 0.45f * static_cast<float>(sampleRate));
+    toneAlpha = 1.0f - std::exp(-dsp256::MathConstants<float>::twoPi * toneHz / static_cast<float>(sampleRate));
+}
+
+//==============================================================================
+void Distortion::buildCurveTables()
+{
+    const double h = 2.0 * TABLE_RANGE / CURVE_TABLE_SIZE;
+    const int mid = CURVE_TABLE_SIZE / 2;
+
+    for (int s = 0; s < NUM_SHAPES; ++s) {
+        auto& table = curves[static_cast<size_t>(s)];
+
+        for (int i = 0; i <= CURVE_TABLE_SIZE; ++i) {
+            const double x = -TABLE_RANGE + h * i;
+            double y = 0.0;
+            switch (s) {
+            case 0: y = std::tanh(x); break;
+            // Digital clip: a Q12 clamp to +/-Q12_ONE, expressed in float
+            case 1: y = dsp256::jlimit(-1.0, 1.0, x); break;
+            case 2: y = x >= 0.0 ? std::tanh(x) : 0.7 * std::tanh(x / 0.7); break;
+            }
+            table.f[static_cast<size_t>(i)] = static_cast<float>(y);
+        }
+
+        // Integrate the piecewise-linear curve exactly, outward from x = 0
+        table.F1[mid] = 0.0;
+        table.F2[mid] = 0.0;
+        for (int i = mid; i < CURVE_TABLE_SIZE; ++i) {
+            const double f0 = table.f[static_cast<size_t>(i)];
+            const double df = table.f[static_cast<size_t>(i + 1)] - f0;
+            table.F1[i + 1] = table.F1[i] + h * (f0 + 0.5 * df);
+            table.F2[i + 1] = table.F2[i] + h * table.F1[i] + h * h * (0.5 * f0 + df / 6.0);
+        }
+        for (int i = mid - 1; i >= 0; --i) {
+            const double f0 = table.f[static_cast<size_t>(i)];
+            const double df = table.f[static_cast<size_t>(i + 1)] - f0;
+            table.F1[i] = table.F1[i + 1] - h * (f0 + 0.5 * df);
+            table.F2[i] = table.F2[i + 1] - h * table.F1[i] - h * h * (0.5 * f0 + df / 6.0);
+        }
+    }
+}
+
+float Distortion::evalCurve(double x) const
+{
+    const auto& table = curves[static_cast<size_t>(shapeIndex)];
+    const double u = (x + TABLE_RANGE) * (CURVE_TABLE_SIZE / (2.0 * TABLE_RANGE));
+    if (u <= 0.0) return table.f.front();
+    if (u >= CURVE_TABLE_SIZE) return table.f.back();
+
+    const int i = static_cast<int>(u);
+    const float t = static_cast<float>(u - i);
+    return table.f[i] + (table.f[i + 1] - table.f[i]) * t;
+}
+
+double Distortion::evalF1(double x) const
+{
+    const auto& table = curves[static_cast<size_t>(shapeIndex)];
+    const double h = 2.0 * TABLE_RANGE / CURVE_TABLE_SIZE;
+    const double u = (x + TABLE_RANGE) / h;
+
+    // Beyond the table the curve is held flat, so F1 continues linearly
+    if (u <= 0.0) return table.F1.front() + table.f.front() * (x + TABLE_RANGE);
+    if (u >= CURVE_TABLE_SIZE) return table.F1.back() + table.f.back() * (x - TABLE_RANGE);
+
+    const int i = static_cast<int>(u);
+    const double t = u - i;
+    const double f0 = table.f[i];
+    const double df = table.f[i + 1] - f0;
+    return table.F1[i] + h * t * (f0 + 0.5 * df * t);
+}
+
+double Distortion::evalF2(double x) const
+{
+    const auto& table = curves[static_cast<size_t>(shapeIndex)];
+    const double h = 2.0 * TABLE_RANGE / CURVE_TABLE_SIZE;
+    const double u = (x + TABLE_RANGE) / h;
+
+    if (u <= 0.0) {
+        const double d = x + TABLE_RANGE;
+        return table.F2.front() + table.F1.front() * d + 0.5 * table.f.front() * d * d;
+    }
+    if (u >= CURVE_TABLE_SIZE) {
+        const double d = x - TABLE_RANGE;
+        return table.F2.back() + table.F1.back() * d + 0.5 * table.f.back() * d * d;
+    }
+
+    const int i = static_cast<int>(u);
+    const double t = u - i;
+    const double f0 = table.f[i];
+    const double df = table.f[i + 1] - f0;
+    return table.F2[i] + h * table.F1[i] * t + h * h * t * t * (0.5 * f0 + df * t / 6.0);
+}
+
+//==============================================================================
+float Distortion::adaa1(ChannelState& ch, double x)
+{
+    const double dx = x - ch.x1;
+    const float y = std::abs(dx) > 1.0e-5
+        ? static_cast<float>((evalF1(x) - evalF1(ch.x1)) / dx)
+        : evalCurve(0.5 * (x + ch.x1));
+
+    ch.x2 = ch.x1;
+    ch.x1 = x;
+    return y;
+}
+
+float Distortion::adaa2(ChannelState& ch, double x)
+{
+    constexpr double eps = 1.0e-5;
+
+    const double dx1 = x - ch.x1;
+    const double d1 = std::abs(dx1) > eps ? (evalF2(x) - evalF2(ch.x1)) / dx1
+                                          : evalF1(0.5 * (x + ch.x1));
+
+    double y;
+    const double dx2 = x - ch.x2;
+    if (std::abs(dx2) > eps) {
+        y = 2.0 * (d1 - ch.d1Prev) / dx2;
+    }
+    else {
+        // x[n] ~ x[n-2]: expand around their midpoint instead of dividing by ~0
+        const double xBar = 0.5 * (x + ch.x2);
+        const double delta = xBar - ch.x1;
+        y = std::abs(delta) > eps
+            ? 2.0 / delta * (evalF1(xBar) + (evalF2(ch.x1) - evalF2(xBar)) / delta)
+            : evalCurve(0.5 * (xBar + ch.x1));
+    }
+
+    ch.x2 = ch.x1;
+    ch.x1 = x;
+    ch.d1Prev = d1;
+    return static_cast<float>(y);
+}
+
+float Distortion::shapeSample(ChannelState& ch, float input)
+{
+    const double x = static_cast<double>(input) * driveGain;
+
+    switch (adaaOrder) {
+    case 1: return adaa1(ch, x);
+    case 2: return adaa2(ch, x);
+    default:
+        ch.x2 = ch.x1;
+        ch.x1 = x;
+        return evalCurve(x);
+    }
+}
+
+//==============================================================================
+void Distortion::buildOversamplers()
+{
+    static constexpr int factors[] = { 1, 2, 4 };
+
+    for (size_t o = 0; o < oversamplers.size(); ++o) {
+        auto& os = oversamplers[o];
+        os.factor = factors[o];
+        if (os.factor == 1)
+            continue;
+
+        // Blackman-windowed sinc at 90% of the base-rate Nyquist
+        const int numTaps = TAPS_PER_PHASE * os.factor;
+        const double cutoff = 0.45 / os.factor;
+        const double centre = 0.5 * (numTaps - 1);
+        double sum = 0.0;
+
+        for (int n = 0; n < numTaps; ++n) {
+            const double m = n - centre;
+            const double sinc = std::abs(m) < 1.0e-9 ? 2.0 * cutoff
+                : std::sin(dsp256::MathConstants<double>::twoPi * cutoff * m) / (dsp256::MathConstants<double>::pi * m);
+            const double phase = dsp256::MathConstants<double>::twoPi * n / (numTaps - 1);
+            const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+            os.prototype[static_cast<size_t>(n)] = static_cast<float>(sinc * window);
+            sum += sinc * window;
+        }
+
+        for (int n = 0; n < numTaps; ++n)
+            os.prototype[static_cast<size_t>(n)] /= static_cast<float>(sum);
+
+        // Interpolator phase k uses taps k, k + L, k + 2L, ... scaled by L
+        for (int k = 0; k < os.factor; ++k)
+            for (int j = 0; j < TAPS_PER_PHASE; ++j)
+                os.phases[static_cast<size_t>(k)][static_cast<size_t>(j)]
+                    = os.prototype[static_cast<size_t>(j * os.factor + k)] * static_cast<float>(os.factor);
+    }
+}
+
+void Distortion::clearChannel(ChannelState& ch)
+{
+    ch.x1 = 0.0;
+    ch.x2 = 0.0;
+    ch.d1Prev = evalF1(0.0);
+    ch.upHistory.fill(0.0f);
+    ch.downHistory.fill(0.0f);
+    ch.downPos = 0;
+    ch.toneState = 0.0f;
+    ch.dcInState = 0.0f;
+    ch.dcOutState = 0.0f;
+}
+
+float Distortion::processChannel(ChannelState& ch, float input)
+{
+    const auto& os = oversamplers[static_cast<size_t>(oversampleIndex)];
+    float shaped;
+
+    if (os.factor == 1) {
+        shaped = shapeSample(ch, input);
+    }
+    else {
+        const int numTaps = TAPS_PER_PHASE * os.factor;
+
+        for (int j = TAPS_PER_PHASE - 1; j > 0; --j)
+            ch.upHistory[static_cast<size_t>(j)] = ch.upHistory[static_cast<size_t>(j - 1)];
+        ch.upHistory[0] = input;
+
+        for (int k = 0; k < os.factor; ++k) {
+            const auto& phase = os.phases[static_cast<size_t>(k)];
+            float up = 0.0f;
+            for (int j = 0; j < TAPS_PER_PHASE; ++j)
+                up += phase[static_cast<size_t>(j)] * ch.upHistory[static_cast<size_t>(j)];
+
+            const float s = shapeSample(ch, up);
+            ch.downPos = (ch.downPos + numTaps - 1) % numTaps;
+            ch.downHistory[static_cast<size_t>(ch.downPos)] = s;
+            ch.downHistory[static_cast<size_t>(ch.downPos + numTaps)] = s;
+        }
+
+        // Decimate: only the retained output sample is ever computed
+        const float* history = ch.downHistory.data() + ch.downPos;
+        shaped = 0.0f;
+        for (int n = 0; n < numTaps; ++n)
+            shaped += os.prototype[static_cast<size_t>(n)] * history[n];
+    }
+
+    ch.toneState += toneAlpha * (shaped - ch.toneState);
+
+    // DC blocker for the asymmetric curve
+    const float dcCoeff = 1.0f - 62.83f / static_cast<float>(sampleRate);
+    const float blocked = ch.toneState - ch.dcInState + dcCoeff * ch.dcOutState;
+    ch.dcInState = ch.toneState;
+    ch.dcOutState = blocked;
+
+    return blocked * outputGain;
+}
+
+float Distortion::delayDry(ChannelState& ch, float input, int delay)
+{
+    ch.dryHistory[static_cast<size_t>(ch.dryPos)] = input;
+    const float delayed = ch.dryHistory[static_cast<size_t>((ch.dryPos - delay) & DRY_DELAY_MASK)];
+    ch.dryPos = (ch.dryPos + 1) & DRY_DELAY_MASK;
+    return delayed;
+}
+
+//==============================================================================
+void Distortion::process(FixedPointSample& left, FixedPointSample& right,
+    DelayMemoryPool& delayPool, FixedPointEngine& dspCore)
+{
+    dsp256::ignoreUnused(delayPool);
+
+    const float inL = dspCore.Q12ToFloat(left);
+    const float inR = dspCore.Q12ToFloat(right);
+
+    const float wetL = processChannel(channels[0], inL);
+    const float wetR = processChannel(channels[1], inR);
+
+    // The wet path lags by the reported latency; delay the dry to match
+    const float dryL = delayDry(channels[0], inL, dryDelay);
+    const float dryR = delayDry(channels[1], inR, dryDelay);
+
+    const float outL = dryL * (1.0f - mix) + wetL * mix;
+    const float outR = dryR * (1.0f - mix) + wetR * mix;
+
+    // floatToQ12 applies the HISC saturation, exactly as FixedPointSample does
+    left = dspCore.floatToQ12(outL);
+    right = dspCore.floatToQ12(outR);
+}
+
+void Distortion::validateParameters()
+{
+    drive = dsp256::jlimit(0.0f, 1.0f, drive);
+    shape = dsp256::jlimit(0.0f, 1.0f, shape);
+    antialiasing = dsp256::jlimit(0.0f, 1.0f, antialiasing);
+    oversampling = dsp256::jlimit(0.0f, 1.0f, oversampling);
+    tone = dsp256::jlimit(0.0f, 1.0f, tone);
+    level = dsp256::jlimit(0.0f, 1.0f, level);
+    mix = dsp256::jlimit(0.0f, 1.0f, mix);
+}
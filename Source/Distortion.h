@@ -0,0 +1,154 @@
+// Distortion.h - Antialiased Distortion Effect Module
+#pragma once
+
+#include "EffectModule.h"
+#include "FixedPointDSP.h"
+#include "DelayMemoryPool.h"
+#include <array>
+
+//==============================================================================
+// Distortion Effect Module
+// Table-driven waveshaper with first- or second-order antiderivative
+// antialiasing (ADAA). The curve is stored as a piecewise-linear std::array
+// lookup and its first/second antiderivatives are integrated exactly from
+// that table, so ADAA stays consistent with what the plain lookup produces.
+// A polyphase FIR oversampler (2x/4x) is available for extreme drive.
+//==============================================================================
+class Distortion : public EffectModule {
+public:
+    Distortion();
+    ~Distortion() override = default;
+
+    // Module identification
+    dsp256::String getModuleName() const override { return "Distortion"; }
+    dsp256::String getModuleDescription() const override {
+        return "Antialiased waveshaper with soft, hard and asymmetric curves. "
+            "ADAA at 1x with optional oversampling.";
+    }
+
+    // Parameter configuration
+    std::vector<EffectParameter> getParameterDefinitions() const override;
+    int getParameterCount() const override { return 7; }
+
+    // Preset management
+    std::vector<EffectPreset> getFactoryPresets() const override;
+    void loadPreset(const EffectPreset& preset) override;
+    EffectPreset getCurrentPreset() const override;
+
+    // DSP lifecycle
+    void prepare(double sampleRate, int samplesPerBlock) override;
+    void reset() override;
+    void releaseResources() override;
+    int getLatencySamples() const override;
+
+    // Parameter updates
+    void setParameter(int parameterIndex, float value) override;
+    float getParameter(int parameterIndex) const override;
+    dsp256::String getParameterDisplay(int parameterIndex) const override;
+
+    // Audio processing
+    void process(FixedPointSample& left, FixedPointSample& right,
+        DelayMemoryPool& delayPool, FixedPointEngine& dspCore) override;
+
+private:
+    // Parameters (0.0 to 1.0 normalized)
+    float drive = 0.3f;           // Input drive: 0-40 dB
+    float shape = 0.0f;           // Curve: soft / hard / asymmetric
+    float antialiasing = 1.0f;    // ADAA order: off / 1st / 2nd
+    float oversampling = 0.0f;    // Oversampling: 1x / 2x / 4x
+    float tone = 0.7f;            // Post low-pass: 1-20 kHz (logarithmic)
+    float level = 0.8f;           // Output level: -24 to +6 dB
+    float mix = 1.0f;             // Dry/Wet Mix: 0-100%
+
+    //==========================================================================
+    // Waveshaper curve tables over [-TABLE_RANGE, TABLE_RANGE]
+    static constexpr int NUM_SHAPES = 3;
+    static constexpr int CURVE_TABLE_SIZE = 4096;
+    static constexpr float TABLE_RANGE = 8.0f;
+
+    struct CurveTable {
+        std::array<float, CURVE_TABLE_SIZE + 1> f;      // Curve at each node
+        std::array<double, CURVE_TABLE_SIZE + 1> F1;    // First antiderivative at nodes
+        std::array<double, CURVE_TABLE_SIZE + 1> F2;    // Second antiderivative at nodes
+    };
+
+    std::array<CurveTable, NUM_SHAPES> curves;
+
+    //==========================================================================
+    // Polyphase oversampling (shared prototype low-pass, split into phases)
+    static constexpr int TAPS_PER_PHASE = 16;
+    static constexpr int MAX_FACTOR = 4;
+    static constexpr int MAX_TAPS = TAPS_PER_PHASE * MAX_FACTOR;
+
+    // Dry path delay, matched to getLatencySamples() (16 at most: ADAA2 at 4x)
+    static constexpr int DRY_DELAY_SIZE = 32;
+    static constexpr int DRY_DELAY_MASK = DRY_DELAY_SIZE - 1;
+
+    struct PolyphaseFilter {
+        int factor = 1;
+        std::array<float, MAX_TAPS> prototype{};                            // Decimator taps
+        std::array<std::array<float, TAPS_PER_PHASE>, MAX_FACTOR> phases{}; // Interpolator phases
+    };
+
+    std::array<PolyphaseFilter, 3> oversamplers;   // 1x, 2x, 4x
+
+    struct ChannelState {
+        // ADAA history (shaper input domain)
+        double x1 = 0.0;
+        double x2 = 0.0;
+        double d1Prev = 0.0;
+
+        // Interpolator input history (newest first)
+        std::array<float, TAPS_PER_PHASE> upHistory{};
+
+        // Decimator history, mirrored so reads are always contiguous
+        std::array<float, MAX_TAPS * 2> downHistory{};
+        int downPos = 0;
+
+        float toneState = 0.0f;
+        float dcInState = 0.0f;
+        float dcOutState = 0.0f;
+
+        // Dry input, kept across oversampling changes so the dry path never drops out
+        std::array<float, DRY_DELAY_SIZE> dryHistory{};
+        int dryPos = 0;
+    };
+
+    std::array<ChannelState, 2> channels;
+
+    // Derived coefficients
+    float driveGain = 1.0f;
+    float outputGain = 1.0f;
+    float toneAlpha = 1.0f;
+    int shapeIndex = 0;
+    int adaaOrder = 1;
+    int oversampleIndex = 0;
+    int dryDelay = 0;               // getLatencySamples(), cached for process()
+
+    // Sample rate and block size
+    double sampleRate = 44100.0;
+    int blockSize = 512;
+
+    // Helper methods
+    void updateParameters();
+    void buildCurveTables();
+    void buildOversamplers();
+    void clearChannel(ChannelState& ch);
+
+    float processChannel(ChannelState& ch, float input);
+    float shapeSample(ChannelState& ch, float input);
+    static float delayDry(ChannelState& ch, float input, int delay);
+
+    // Table evaluation (linear interpolation, exact antiderivatives outside range)
+    float evalCurve(double x) const;
+    double evalF1(double x) const;
+    double evalF2(double x) const;
+
+    float adaa1(ChannelState& ch, double x);
+    float adaa2(ChannelState& ch, double x);
+
+    static int stepIndex(float normalized, int numSteps);
+
+    // Parameter validation
+    void validateParameters();
+};
@@ -0,0 +1,232 @@
+// DspCore.h - The few JUCE facilities the DSP modules use, with or without JUCE
+#pragma once
+
+//==============================================================================
+// DSP code spells these dsp256::. In the plugin build they are JUCE's own
+// (so the processor and editor see the very same types). In the headless core
+// library (DSP256_HEADLESS=1, see CMakeLists.txt) they are the plain C++17
+// stand-ins below, numerically identical where it matters: jlimit/jmin/jmax,
+// Decibels and Random's LCG follow JUCE exactly, so a seeded module renders
+// the same samples in both builds.
+//==============================================================================
+#ifndef DSP256_HEADLESS
+ #define DSP256_HEADLESS 0
+#endif
+
+#if ! DSP256_HEADLESS
+
+#include <JuceHeader.h>
+
+namespace dsp256 {
+    using juce::jlimit;
+    using juce::jmin;
+    using juce::jmax;
+    using juce::ignoreUnused;
+    using juce::nextPowerOfTwo;
+    using juce::MathConstants;
+    using juce::Decibels;
+    using juce::Range;
+    using juce::Random;
+    using juce::String;
+    using juce::StringArray;
+}
+
+#else
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifndef jassert
+ #define jassert(expression) assert(expression)
+#endif
+
+namespace dsp256 {
+
+template <typename Type>
+constexpr Type jlimit(Type lowerLimit, Type upperLimit, Type value) noexcept
+{
+    return value < lowerLimit ? lowerLimit : (upperLimit < value ? upperLimit : value);
+}
+
+template <typename Type> constexpr Type jmin(Type a, Type b) noexcept { return b < a ? b : a; }
+template <typename Type> constexpr Type jmax(Type a, Type b) noexcept { return a < b ? b : a; }
+template <typename Type> constexpr Type jmin(Type a, Type b, Type c) noexcept { return jmin(jmin(a, b), c); }
+template <typename Type> constexpr Type jmax(Type a, Type b, Type c) noexcept { return jmax(jmax(a, b), c); }
+
+template <typename... Types> void ignoreUnused(Types&&...) noexcept {}
+
+inline int nextPowerOfTwo(int n) noexcept
+{
+    --n;
+    n |= (n >> 1);
+    n |= (n >> 2);
+    n |= (n >> 4);
+    n |= (n >> 8);
+    n |= (n >> 16);
+    return n + 1;
+}
+
+template <typename FloatType>
+struct MathConstants {
+    static constexpr FloatType pi = static_cast<FloatType>(3.141592653589793238L);
+    static constexpr FloatType twoPi = static_cast<FloatType>(2 * 3.141592653589793238L);
+    static constexpr FloatType halfPi = static_cast<FloatType>(3.141592653589793238L / 2);
+};
+
+struct Decibels {
+    template <typename Type>
+    static Type gainToDecibels(Type gain, Type minusInfinityDb = Type(-100))
+    {
+        return gain > Type() ? jmax(minusInfinityDb, static_cast<Type>(std::log10(gain)) * Type(20.0))
+                             : minusInfinityDb;
+    }
+
+    template <typename Type>
+    static Type decibelsToGain(Type decibels, Type minusInfinityDb = Type(-100))
+    {
+        return decibels > minusInfinityDb ? std::pow(Type(10.0), decibels * Type(0.05)) : Type();
+    }
+};
+
+template <typename ValueType>
+class Range {
+public:
+    constexpr Range(ValueType startValue, ValueType endValue) noexcept
+        : start(startValue), end(jmax(startValue, endValue)) {}
+
+    constexpr ValueType getStart() const noexcept { return start; }
+    constexpr ValueType getEnd() const noexcept { return end; }
+    constexpr ValueType getLength() const noexcept { return end - start; }
+
+private:
+    ValueType start;
+    ValueType end;
+};
+
+// JUCE's 48-bit LCG, so seeded sequences match the plugin build
+class Random {
+public:
+    explicit Random(int64_t seedValue) noexcept : seed(seedValue) {}
+
+    Random() : seed(1)
+    {
+        seed ^= static_cast<int64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+        nextInt();
+    }
+
+    void setSeed(int64_t newSeed) noexcept { seed = newSeed; }
+
+    int nextInt() noexcept
+    {
+        seed = static_cast<int64_t>(((static_cast<uint64_t>(seed) * 0x5deece66dULL) + 11) & 0xffffffffffffULL);
+        return static_cast<int>(seed >> 16);
+    }
+
+    int nextInt(int maxValue) noexcept
+    {
+        return static_cast<int>((static_cast<uint64_t>(static_cast<uint32_t>(nextInt()))
+            * static_cast<uint64_t>(maxValue)) >> 32);
+    }
+
+    int nextInt(Range<int> range) noexcept { return range.getStart() + nextInt(range.getLength()); }
+
+    float nextFloat() noexcept
+    {
+        const float result = static_cast<float>(static_cast<uint32_t>(nextInt()))
+            / (static_cast<float>(std::numeric_limits<uint32_t>::max()) + 1.0f);
+        return jmin(result, 1.0f - std::numeric_limits<float>::epsilon());
+    }
+
+    static Random& getSystemRandom() noexcept
+    {
+        static Random systemRandom;
+        return systemRandom;
+    }
+
+private:
+    int64_t seed;
+};
+
+// Just enough of juce::String for module names, presets and display text
+class String {
+public:
+    String() = default;
+    String(const char* text) : chars(text != nullptr ? text : "") {}
+    String(std::string text) : chars(std::move(text)) {}
+
+    template <typename IntType, typename std::enable_if<std::is_integral<IntType>::value, int>::type = 0>
+    explicit String(IntType number) : chars(std::to_string(number)) {}
+
+    String(float number, int numberOfDecimalPlaces) : String(static_cast<double>(number), numberOfDecimalPlaces) {}
+
+    String(double number, int numberOfDecimalPlaces)
+    {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%.*f", jmax(0, numberOfDecimalPlaces), number);
+        chars = buffer;
+    }
+
+    template <typename... Args>
+    static String formatted(const char* format, Args... args)
+    {
+        char buffer[256];
+        std::snprintf(buffer, sizeof(buffer), format, args...);
+        return String(buffer);
+    }
+
+    const char* toRawUTF8() const noexcept { return chars.c_str(); }
+    const std::string& toStdString() const noexcept { return chars; }
+    bool isEmpty() const noexcept { return chars.empty(); }
+    bool isNotEmpty() const noexcept { return !chars.empty(); }
+
+    String toUpperCase() const
+    {
+        std::string upper(chars);
+        for (auto& c : upper)
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        return String(std::move(upper));
+    }
+
+    String& operator+=(const String& other)
+    {
+        chars += other.chars;
+        return *this;
+    }
+
+    friend String operator+(String a, const String& b) { return a += b; }
+    friend String operator+(String a, const char* b) { return a += String(b); }
+    friend String operator+(const char* a, const String& b) { return String(a) += b; }
+
+    friend bool operator==(const String& a, const String& b) noexcept { return a.chars == b.chars; }
+    friend bool operator!=(const String& a, const String& b) noexcept { return a.chars != b.chars; }
+    friend bool operator<(const String& a, const String& b) noexcept { return a.chars < b.chars; }
+
+private:
+    std::string chars;
+};
+
+class StringArray {
+public:
+    void add(const String& text) { strings.push_back(text); }
+    int size() const noexcept { return static_cast<int>(strings.size()); }
+    const String& operator[](int index) const { return strings[static_cast<size_t>(index)]; }
+
+    std::vector<String>::const_iterator begin() const noexcept { return strings.begin(); }
+    std::vector<String>::const_iterator end() const noexcept { return strings.end(); }
+
+private:
+    std::vector<String> strings;
+};
+
+} // namespace dsp256
+
+#endif
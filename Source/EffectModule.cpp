@@ -0,0 +1,32 @@
+// EffectModule.cpp - Default block processing
+#include "EffectModule.h"
+#include "FixedPointDSP.h"
+#include "DelayMemoryPool.h"
+
+void EffectModule::processBlock(float* left, float* right, int numSamples,
+    DelayMemoryPool& delayPool, FixedPointEngine& dspCore)
+{
+    processBlockReference(left, right, numSamples, delayPool, dspCore);
+}
+
+void EffectModule::processBlockReference(float* left, float* right, int numSamples,
+    DelayMemoryPool& delayPool, FixedPointEngine& dspCore)
+{
+    for (int i = 0; i < numSamples; ++i) {
+        FixedPointSample l = dspCore.floatToQ12(left[i]);
+        FixedPointSample r = dspCore.floatToQ12(right[i]);
+
+        process(l, r, delayPool, dspCore);
+
+        left[i] = dspCore.Q12ToFloat(l);
+        right[i] = dspCore.Q12ToFloat(r);
+    }
+}
+
+void EffectModule::processBlockMultichannel(float* const* channels, int numChannels, int numSamples,
+    DelayMemoryPool& delayPool, FixedPointEngine& dspCore)
+{
+    jassert(numChannels >= 2);
+    dsp256::ignoreUnused(numChannels);
+    processBlock(channels[0], channels[1], numSamples, delayPool, dspCore);
+}
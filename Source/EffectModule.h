@@ -1,7 +1,13 @@
 // EffectModule.h - Base interface for all effect modules
 #pragma once
 
-#include <JuceHeader.h>
+#include "DspCore.h"
+#include "MeterRing.h"
+#include "DisplayText.h"
+#include "StageProfiler.h"
+#include <cmath>
+#include <functional>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -14,20 +20,20 @@ struct FixedPointSample;
 // Parameter Information Structure
 //==============================================================================
 struct EffectParameter {
-    juce::String id;
-    juce::String name;
-    juce::String label;      // Short label for small LCD (e.g., "DECAY")
-    juce::String unit;       // Unit string (e.g., "ms", "%", "dB")
+    dsp256::String id;
+    dsp256::String name;
+    dsp256::String label;      // Short label for small LCD (e.g., "DECAY")
+    dsp256::String unit;       // Unit string (e.g., "ms", "%", "dB")
     float minValue;
     float maxValue;
     float defaultValue;
     float stepSize;
     bool isLogarithmic;
 
-    EffectParameter(const juce::String& paramId,
-        const juce::String& paramName,
-        const juce::String& paramLabel,
-        const juce::String& paramUnit,
+    EffectParameter(const dsp256::String& paramId,
+        const dsp256::String& paramName,
+        const dsp256::String& paramLabel,
+        const dsp256::String& paramUnit,
         float min, float max, float defaultVal, float step = 0.01f,
         bool logarithmic = false)
         : id(paramId), name(paramName), label(paramLabel), unit(paramUnit),
@@ -35,24 +41,64 @@ struct EffectParameter {
         stepSize(step), isLogarithmic(logarithmic)
     {
     }
+
+    // Modules take values normalized to 0..1 (setParameter, getParameter,
+    // presets) and map them to units linearly, or as min * (max / min)^n
+    // when logarithmic. Hosts hold the value in units and convert with these.
+    float toNormalized(float value) const
+    {
+        float normalized = isLogarithmic
+            ? std::log(value / minValue) / std::log(maxValue / minValue)
+            : (value - minValue) / (maxValue - minValue);
+        return normalized > 0.0f ? (normalized < 1.0f ? normalized : 1.0f) : 0.0f;
+    }
+
+    float fromNormalized(float normalized) const
+    {
+        normalized = normalized > 0.0f ? (normalized < 1.0f ? normalized : 1.0f) : 0.0f;
+        return isLogarithmic
+            ? minValue * std::pow(maxValue / minValue, normalized)
+            : minValue + (maxValue - minValue) * normalized;
+    }
 };
 
 //==============================================================================
 // Preset Structure
 //==============================================================================
 struct EffectPreset {
-    juce::String name;
-    juce::String description;
+    dsp256::String name;
+    dsp256::String description;
     std::vector<float> parameterValues;
 
-    EffectPreset(const juce::String& presetName,
-        const juce::String& desc,
+    EffectPreset(const dsp256::String& presetName,
+        const dsp256::String& desc,
         const std::vector<float>& values)
         : name(presetName), description(desc), parameterValues(values)
     {
     }
 };
 
+//==============================================================================
+// Host Transport Snapshot (taken from the playhead once per host block)
+//==============================================================================
+struct TransportInfo {
+    double bpm = 120.0;
+    double ppqPosition = 0.0;
+    bool hasTempo = false;
+    bool isPlaying = false;
+};
+
+//==============================================================================
+// Main Output Layout (set from prepareToPlay when the host picks a bus layout)
+//==============================================================================
+struct OutputLayout {
+    static constexpr int MAX_CHANNELS = 8;
+
+    int numChannels = 2;
+    int lfeChannel = -1;      // Index of the LFE channel, or -1 if none
+    bool ambisonic = false;   // AmbiX first order: W, Y, Z, X (SN3D)
+};
+
 //==============================================================================
 // Base Effect Module Interface
 //==============================================================================
@@ -61,8 +107,8 @@ public:
     virtual ~EffectModule() = default;
 
     // Module identification
-    virtual juce::String getModuleName() const = 0;
-    virtual juce::String getModuleDescription() const = 0;
+    virtual dsp256::String getModuleName() const = 0;
+    virtual dsp256::String getModuleDescription() const = 0;
     virtual int getModuleVersion() const { return 1; }
 
     // Parameter configuration
@@ -74,26 +120,104 @@ public:
     virtual void loadPreset(const EffectPreset& preset) = 0;
     virtual EffectPreset getCurrentPreset() const = 0;
 
+    // A new, unprepared instance at the default values for offline rendering
+    // (impulse analysis, export); nullptr if not supported. Reads nothing from
+    // this instance, so any thread may call it
+    virtual std::unique_ptr<EffectModule> createInstance() const { return nullptr; }
+
+    // createInstance() with this instance's parameter values. Reads the live
+    // parameters: only call it from the thread that runs the module
+    std::unique_ptr<EffectModule> clone() const
+    {
+        auto copy = createInstance();
+        if (copy)
+            copy->loadPreset(getCurrentPreset());
+        return copy;
+    }
+
     // DSP lifecycle
     virtual void prepare(double sampleRate, int samplesPerBlock) = 0;
     virtual void reset() = 0;
     virtual void releaseResources() = 0;
 
+    // Processing latency to report to the host (e.g., oversampling filters)
+    virtual int getLatencySamples() const { return 0; }
+
     // Parameter updates
     virtual void setParameter(int parameterIndex, float value) = 0;
     virtual float getParameter(int parameterIndex) const = 0;
-    virtual juce::String getParameterDisplay(int parameterIndex) const = 0;
+    virtual dsp256::String getParameterDisplay(int parameterIndex) const = 0;
+
+    // Same text without allocating; the default goes through the String
+    virtual void formatParameterDisplay(int parameterIndex, DisplayText& text) const
+    {
+        text.clear();
+        text.append(getParameterDisplay(parameterIndex).toRawUTF8());
+    }
 
     // Audio processing
     virtual void process(FixedPointSample& left, FixedPointSample& right,
         DelayMemoryPool& delayPool, FixedPointEngine& dspCore) = 0;
 
+    // Block processing on float buffers (in place). The default converts each
+    // sample to Q12 and calls process(); modules with block-rate work override it.
+    virtual void processBlock(float* left, float* right, int numSamples,
+        DelayMemoryPool& delayPool, FixedPointEngine& dspCore);
+
+    // The reference kernel: the straightforward per-sample path the default
+    // processBlock() runs, whatever the module overrides. Hosts switch to it
+    // at run time (DSP256_KERNELS=reference) to rule the optimized block,
+    // SIMD and integer kernels in or out; dsp256_diff holds them to it.
+    // Stereo only: processBlockMultichannel() has no reference counterpart.
+    // Modules with block-rate control work (e.g., a ducking follower) wrap
+    // it around this loop so both kernels render the same effect.
+    virtual void processBlockReference(float* left, float* right, int numSamples,
+        DelayMemoryPool& delayPool, FixedPointEngine& dspCore);
+
+    // Multichannel output. Modules that render more than a stereo wet signal
+    // accept wider layouts; the default processes channels 0/1 as stereo and
+    // leaves the rest untouched.
+    virtual bool supportsOutputLayout(const OutputLayout& layout) const { return layout.numChannels == 2; }
+    virtual void setOutputLayout(const OutputLayout& layout) { dsp256::ignoreUnused(layout); }
+    virtual void processBlockMultichannel(float* const* channels, int numChannels, int numSamples,
+        DelayMemoryPool& delayPool, FixedPointEngine& dspCore);
+
+    // Optional key input for the next processBlock call (e.g., a sidechain
+    // bus), or nullptr to key from the dry input
+    virtual void setSidechainInput(const float* left, const float* right) { dsp256::ignoreUnused(left, right); }
+
+    // Optional wet-signal feed for the editor's analyzer; the module writes
+    // mono wet samples from processBlock and drops them when the ring is full
+    virtual void setAnalyzerTap(AnalyzerRing* ring) { dsp256::ignoreUnused(ring); }
+
+    // Host transport, called at the start of each host block when available
+    virtual void setTransportInfo(const TransportInfo& info) { dsp256::ignoreUnused(info); }
+
+    // Offline rendering (host bounce, command-line renders): blocks may take
+    // as long as they need, so work normally left to a background thread can
+    // be done in line and renders come out the same every time
+    virtual void setNonRealtime(bool isNonRealtime) { dsp256::ignoreUnused(isNonRealtime); }
+
     // Modulation updates (called at control rate, e.g., every 64 samples)
-    virtual void updateModulation(int blockCounter) { juce::ignoreUnused(blockCounter); }
+    virtual void updateModulation(int blockCounter) { dsp256::ignoreUnused(blockCounter); }
 
     // Real-time info for LCD display (optional)
     virtual bool hasRealtimeDisplay() const { return false; }
-    virtual juce::String getRealtimeDisplayInfo() const { return ""; }
+    virtual dsp256::String getRealtimeDisplayInfo() const { return ""; }
+
+    // Wet tail envelope (linear) for the meter ring; read on the audio thread
+    // right after processing, so it needs no synchronization
+    virtual float getTailLevel() const { return 0.0f; }
+
+    // Per-stage processBlock() cost (StageProfiler.h); modules that are not
+    // instrumented, and every module in builds without DSP256_STAGE_PROFILING,
+    // report nothing. Safe to call from any thread.
+    virtual int getStageTimings(StageTiming* timings, int maxTimings) const
+    {
+        dsp256::ignoreUnused(timings, maxTimings);
+        return 0;
+    }
+    virtual void resetStageTimings() {}
 
 protected:
     double sampleRate = 44100.0;
@@ -107,37 +231,34 @@ protected:
 using EffectModuleFactory = std::function<std::unique_ptr<EffectModule>()>;
 
 //==============================================================================
-// Effect Module Registry (for future multi-FX version)
-// Currently commented out but ready to use
+// Effect Module Registry: every built-in module by getModuleName(), for
+// offline tools and the future multi-FX version. The instance registers the
+// built-ins on first use (EffectModuleRegistry.cpp). Register custom modules
+// before any thread starts creating them; lookups are then read-only.
 //==============================================================================
-/*
 class EffectModuleRegistry {
 public:
-    static EffectModuleRegistry& getInstance() {
-        static EffectModuleRegistry instance;
-        return instance;
-    }
+    static EffectModuleRegistry& getInstance();
 
-    void registerModule(const juce::String& moduleName, EffectModuleFactory factory) {
+    void registerModule(const dsp256::String& moduleName, EffectModuleFactory factory) {
         modules[moduleName] = factory;
     }
 
-    std::unique_ptr<EffectModule> createModule(const juce::String& moduleName) {
+    std::unique_ptr<EffectModule> createModule(const dsp256::String& moduleName) const {
         auto it = modules.find(moduleName);
         if (it != modules.end())
             return it->second();
         return nullptr;
     }
 
-    juce::StringArray getAvailableModules() const {
-        juce::StringArray names;
+    dsp256::StringArray getAvailableModules() const {
+        dsp256::StringArray names;
         for (const auto& pair : modules)
             names.add(pair.first);
         return names;
     }
 
 private:
-    std::map<juce::String, EffectModuleFactory> modules;
-    EffectModuleRegistry() = default;
+    std::map<dsp256::String, EffectModuleFactory> modules;
+    EffectModuleRegistry();
 };
-*/
\ No newline at end of file
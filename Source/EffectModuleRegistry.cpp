@@ -0,0 +1,30 @@
+// EffectModuleRegistry.cpp - Registration of the built-in effect modules
+#include "EffectModule.h"
+#include "ReverbHall.h"
+#include "ReverbRoom.h"
+#include "ReverbGated.h"
+#include "ReverbReverse.h"
+#include "Distortion.h"
+#include "FilterModule.h"
+#include "RotarySpeaker.h"
+#include "Tremolo.h"
+
+EffectModuleRegistry& EffectModuleRegistry::getInstance()
+{
+    static EffectModuleRegistry instance;
+    return instance;
+}
+
+EffectModuleRegistry::EffectModuleRegistry()
+{
+    // Keyed by each module's own getModuleName()
+    registerModule("Reverb Hall", [] { return std::make_unique<ReverbHall>(); });
+    registerModule("Reverb Room", [] { return std::make_unique<ReverbRoom>(); });
+    registerModule("Reverb Gated", [] { return std::make_unique<ReverbGated>(); });
+    registerModule("Reverb Reverse", [] { return std::make_unique<ReverbReverse>(); });
+    registerModule("Distortion", [] { return std::make_unique<Distortion>(); });
+    registerModule("Low-Pass Filter", [] { return std::make_unique<FilterModule>(FilterModule::Mode::LowPass); });
+    registerModule("High-Pass Filter", [] { return std::make_unique<FilterModule>(FilterModule::Mode::HighPass); });
+    registerModule("Rotary Speaker", [] { return std::make_unique<RotarySpeaker>(); });
+    registerModule("Tremolo", [] { return std::make_unique<Tremolo>(); });
+}
@@ -0,0 +1,60 @@
+// EnvelopeFollower.h - Block-rate peak/RMS level detector
+#pragma once
+
+#include "SimdLanes.h"
+#include "DspCore.h"
+#include <cmath>
+
+//==============================================================================
+// Measures a stereo key signal once per block: peak and RMS are gathered in a
+// single Float4 pass, blended by 'detector' (0 = RMS, 1 = peak), then held by
+// an instant-attack, exponential-release envelope. One exp() per block; no
+// per-sample state, so any module can share it for ducking or gating.
+//==============================================================================
+struct EnvelopeFollower {
+    float envelope = 0.0f;
+    float detector = 0.0f;        // 0 = RMS, 1 = peak
+    float releaseSeconds = 0.25f;
+    double sampleRate = 44100.0;
+
+    void prepare(double sr) { sampleRate = sr; reset(); }
+    void reset() { envelope = 0.0f; }
+
+    // Returns the envelope (linear) after this block
+    float processBlock(const float* left, const float* right, int numSamples)
+    {
+        if (numSamples <= 0)
+            return envelope;
+
+        Float4 peak4 = Float4::broadcast(0.0f);
+        Float4 sum4 = Float4::broadcast(0.0f);
+        const Float4 zero = Float4::broadcast(0.0f);
+
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4) {
+            const Float4 l = Float4::load(left + i);
+            const Float4 r = Float4::load(right + i);
+            peak4 = Float4::max(peak4, Float4::max(Float4::max(l, zero - l), Float4::max(r, zero - r)));
+            sum4 = Float4::mulAdd(l, l, Float4::mulAdd(r, r, sum4));
+        }
+
+        float lanes[4];
+        peak4.store(lanes);
+        float peak = dsp256::jmax(lanes[0], lanes[1], dsp256::jmax(lanes[2], lanes[3]));
+        sum4.store(lanes);
+        float sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+        for (; i < numSamples; ++i) {
+            peak = dsp256::jmax(peak, std::abs(left[i]), std::abs(right[i]));
+            sum += left[i] * left[i] + right[i] * right[i];
+        }
+
+        const float rms = std::sqrt(sum / static_cast<float>(2 * numSamples));
+        const float level = rms + detector * (peak - rms);
+
+        const float release = std::exp(-static_cast<float>(numSamples)
+            / (releaseSeconds * static_cast<float>(sampleRate)));
+        envelope = dsp256::jmax(level, envelope * release);
+        return envelope;
+    }
+};
@@ -0,0 +1,213 @@
+// FilterModule.cpp - ZDF Filter Implementation
+#include "FilterModule.h"
+#include <cmath>
+
+//==============================================================================
+FilterModule::FilterModule(Mode filterMode)
+    : mode(filterMode)
+{
+    sampleRate = 44100.0;
+
+    // Start open: LPF near 5 kHz, HPF near 150 Hz
+    cutoff = (mode == Mode::LowPass) ? 0.77f : 0.29f;
+
+    tanTable.prepare(sampleRate);
+    updateParameters();
+    reset();
+}
+
+//==============================================================================
+std::vector<EffectParameter> FilterModule::getParameterDefinitions() const
+{
+    const float defaultCutoff = (mode == Mode::LowPass) ? 5000.0f : 150.0f;
+
+    return {
+        EffectParameter("cutoff", "Cutoff", "CUTOFF", "Hz", 20.0f, 20000.0f, defaultCutoff, 1.0f, true),
+        EffectParameter("resonance", "Resonance", "RESO", "%", 0.0f, 100.0f, 20.0f, 0.1f, false),
+        EffectParameter("lforate", "LFO Rate", "RATE", "Hz", 0.05f, 10.0f, 0.5f, 0.01f, true),
+        EffectParameter("lfodepth", "LFO Depth", "DEPTH", "oct", 0.0f, 4.0f, 0.0f, 0.01f, false),
+        EffectParameter("envamount", "Envelope Sweep", "ENV", "oct", -4.0f, 4.0f, 0.0f, 0.01f, false),
+        EffectParameter("stereo", "Stereo Phase", "PHASE", "deg", 0.0f, 180.0f, 0.0f, 1.0f, false),
+        EffectParameter("mix", "Dry/Wet Mix", "MIX", "%", 0.0f, 100.0f, 100.0f, 0.1f, false)
+    };
+}
+
+//==============================================================================
+std::vector<EffectPreset> FilterModule::getFactoryPresets() const
+{
+    if (mode == Mode::LowPass) {
+        return {
+            EffectPreset("Warm Roll-Off", "Gentle top-end taming", {0.70f, 0.1f, 0.4f, 0.0f, 0.5f, 0.0f, 1.0f}),
+            EffectPreset("Resonant Sweep", "Slow stereo LFO sweep", {0.45f, 0.7f, 0.3f, 0.5f, 0.5f, 0.5f, 1.0f}),
+            EffectPreset("Auto-Wah", "Envelope-driven wah", {0.35f, 0.75f, 0.4f, 0.0f, 0.9f, 0.0f, 1.0f}),
+            EffectPreset("Telephone", "Narrow and boxy", {0.58f, 0.5f, 0.4f, 0.0f, 0.5f, 0.0f, 1.0f})
+        };
+    }
+
+    return {
+        EffectPreset("Rumble Cut", "Clean low-end cleanup", {0.22f, 0.1f, 0.4f, 0.0f, 0.5f, 0.0f, 1.0f}),
+        EffectPreset("Thin Out", "Resonant bass removal", {0.45f, 0.5f, 0.4f, 0.0f, 0.5f, 0.0f, 1.0f}),
+        EffectPreset("Rising Sweep", "Stereo high-pass LFO", {0.35f, 0.6f, 0.25f, 0.45f, 0.5f, 1.0f, 1.0f})
+    };
+}
+
+void FilterModule::loadPreset(const EffectPreset& preset)
+{
+    if (preset.parameterValues.size() >= 7) {
+        cutoff = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[0]);
+        resonance = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[1]);
+        lfoRate = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[2]);
+        lfoDepth = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[3]);
+        envAmount = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[4]);
+        stereoPhase = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[5]);
+        mix = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[6]);
+        updateParameters();
+    }
+}
+
+EffectPreset FilterModule::getCurrentPreset() const
+{
+    return EffectPreset("Current Settings", "Current filter parameters",
+        { cutoff, resonance, lfoRate, lfoDepth, envAmount, stereoPhase, mix });
+}
+
+void FilterModule::prepare(double sr, int samplesPerBlock)
+{
+    sampleRate = sr;
+    blockSize = samplesPerBlock;
+    tanTable.prepare(sr);
+    updateParameters();
+    reset();
+}
+
+void FilterModule::reset()
+{
+    svf.reset();
+    lfoPhase = 0.0f;
+    envelope = 0.0f;
+    currentOctaves = targetOctaves;
+}
+
+void FilterModule::releaseResources() {}
+
+void FilterModule::setParameter(int parameterIndex, float value)
+{
+    value = dsp256::jlimit(0.0f, 1.0f, value);
+    switch (parameterIndex) {
+    case 0: cutoff = value; break;
+    case 1: resonance = value; break;
+    case 2: lfoRate = value; break;
+    case 3: lfoDepth = value; break;
+    case 4: envAmount = value; break;
+    case 5: stereoPhase = value; break;
+    case 6: mix = value; break;
+    }
+    updateParameters();
+}
+
+float FilterModule::getParameter(int parameterIndex) const
+{
+    switch (parameterIndex) {
+    case 0: return cutoff;
+    case 1: return resonance;
+    case 2: return lfoRate;
+    case 3: return lfoDepth;
+    case 4: return envAmount;
+    case 5: return stereoPhase;
+    case 6: return mix;
+    default: return 0.0f;
+    }
+}
+
+dsp256::String FilterModule::getParameterDisplay(int parameterIndex) const
+{
+    switch (parameterIndex) {
+    case 0: return dsp256::String(20.0f * std::pow(1000.0f, cutoff), 0) + " Hz";
+    case 1: return dsp256::String(resonance * 100.0f, 0) + "%";
+    case 2: return dsp256::String(0.05f * std::pow(200.0f, lfoRate), 2) + " Hz";
+    case 3: return dsp256::String(lfoDepth * 4.0f, 2) + " oct";
+    case 4: return dsp256::String(-4.0f + envAmount * 8.0f, 2) + " oct";
+    case 5: return dsp256::String(stereoPhase * 180.0f, 0) + " deg";
+    case 6: return dsp256::String(mix * 100.0f, 0) + "%";
+    default: return "";
+    }
+}
+
+void FilterModule::updateParameters()
+{
+    validateParameters();
+
+    const float fs = static_cast<float>(sampleRate);
+
+    // 20 Hz * 1000^x, expressed directly in table octaves
+    targetOctaves = ZdfTanTable::octavesForHz(20.0f) + cutoff * std::log2(1000.0f);
+
+    // k = 1/Q, from 2.0 (Q 0.5) down to 0.05 (Q 20)
+    dampingK = 2.0f - 1.95f * resonance;
+
+    lfoIncrement = 0.05f * std::pow(200.0f, lfoRate) / fs;
+    lfoOctaves = lfoDepth * 4.0f;
+    envOctaves = -4.0f + envAmount * 8.0f;
+
+    // ~10 ms glide on cutoff changes, ~150 ms envelope release
+    octaveSmoothing = 1.0f - std::exp(-1.0f / (0.01f * fs));
+    envelopeRelease = std::exp(-1.0f / (0.15f * fs));
+}
+
+float FilterModule::parabolicSine(float phase)
+{
+    // Two parabolic halves: sine-shaped enough for a sweep, no std::sin
+    if (phase < 0.5f)
+        return 16.0f * phase * (0.5f - phase);
+    return -16.0f * (phase - 0.5f) * (1.0f - phase);
+}
+
+//==============================================================================
+void FilterModule::process(FixedPointSample& left, FixedPointSample& right,
+    DelayMemoryPool& delayPool, FixedPointEngine& dspCore)
+{
+    dsp256::ignoreUnused(delayPool);
+
+    const float inL = dspCore.Q12ToFloat(left);
+    const float inR = dspCore.Q12ToFloat(right);
+
+    // Peak envelope, instant attack
+    const float peak = dsp256::jmax(std::abs(inL), std::abs(inR));
+    envelope = dsp256::jmax(peak, envelope * envelopeRelease);
+
+    currentOctaves += (targetOctaves - currentOctaves) * octaveSmoothing;
+
+    float phaseR = lfoPhase + stereoPhase * 0.5f;
+    if (phaseR >= 1.0f) phaseR -= 1.0f;
+
+    const float baseOctaves = currentOctaves + envOctaves * dsp256::jmin(envelope, 1.0f);
+    const float octL = baseOctaves + lfoOctaves * parabolicSine(lfoPhase);
+    const float octR = baseOctaves + lfoOctaves * parabolicSine(phaseR);
+
+    const Float4 g = Float4::set(tanTable.lookup(octL), tanTable.lookup(octR), 0.0f, 0.0f);
+    const Float4 x = Float4::set(inL, inR, 0.0f, 0.0f);
+    const auto outputs = svf.process(x, g, Float4::broadcast(dampingK));
+
+    float wet[4];
+    (mode == Mode::LowPass ? outputs.low : outputs.high).store(wet);
+
+    const float outL = inL * (1.0f - mix) + wet[0] * mix;
+    const float outR = inR * (1.0f - mix) + wet[1] * mix;
+
+    left = dspCore.floatToQ12(outL);
+    right = dspCore.floatToQ12(outR);
+
+    lfoPhase += lfoIncrement;
+    if (lfoPhase >= 1.0f) lfoPhase -= 1.0f;
+}
+
+void FilterModule::validateParameters()
+{
+    cutoff = dsp256::jlimit(0.0f, 1.0f, cutoff);
+    resonance = dsp256::jlimit(0.0f, 1.0f, resonance);
+    lfoRate = dsp256::jlimit(0.0f, 1.0f, lfoRate);
+    lfoDepth = dsp256::jlimit(0.0f, 1.0f, lfoDepth);
+    envAmount = dsp256::jlimit(0.0f, 1.0f, envAmount);
+    stereoPhase = dsp256::jlimit(0.0f, 1.0f, stereoPhase);
+    mix = dsp256::jlimit(0.0f, 1.0f, mix);
+}
@@ -0,0 +1,92 @@
+// FilterModule.h - ZDF Low-Pass / High-Pass Filter Effect Module
+#pragma once
+
+#include "EffectModule.h"
+#include "FixedPointDSP.h"
+#include "DelayMemoryPool.h"
+#include "ZdfFilter.h"
+
+//==============================================================================
+// Filter Effect Module (FILTER_LPF / FILTER_HPF)
+// Resonant TPT state-variable filter with per-sample cutoff modulation from
+// an LFO and an envelope follower. Cutoff is tracked in octaves and turned
+// into g through ZdfTanTable; left/right run as lanes of one ZdfSvf.
+//==============================================================================
+class FilterModule : public EffectModule {
+public:
+    enum class Mode { LowPass, HighPass };
+
+    explicit FilterModule(Mode filterMode = Mode::LowPass);
+    ~FilterModule() override = default;
+
+    // Module identification
+    dsp256::String getModuleName() const override {
+        return mode == Mode::LowPass ? "Low-Pass Filter" : "High-Pass Filter";
+    }
+    dsp256::String getModuleDescription() const override {
+        return "Resonant zero-delay-feedback filter with LFO and envelope sweep.";
+    }
+
+    // Parameter configuration
+    std::vector<EffectParameter> getParameterDefinitions() const override;
+    int getParameterCount() const override { return 7; }
+
+    // Preset management
+    std::vector<EffectPreset> getFactoryPresets() const override;
+    void loadPreset(const EffectPreset& preset) override;
+    EffectPreset getCurrentPreset() const override;
+
+    // DSP lifecycle
+    void prepare(double sampleRate, int samplesPerBlock) override;
+    void reset() override;
+    void releaseResources() override;
+
+    // Parameter updates
+    void setParameter(int parameterIndex, float value) override;
+    float getParameter(int parameterIndex) const override;
+    dsp256::String getParameterDisplay(int parameterIndex) const override;
+
+    // Audio processing
+    void process(FixedPointSample& left, FixedPointSample& right,
+        DelayMemoryPool& delayPool, FixedPointEngine& dspCore) override;
+
+private:
+    Mode mode;
+
+    // Parameters (0.0 to 1.0 normalized)
+    float cutoff = 0.5f;          // Cutoff: 20 Hz - 20 kHz (logarithmic)
+    float resonance = 0.2f;       // Resonance: 0-100% (Q 0.5 - 20)
+    float lfoRate = 0.4f;         // LFO rate: 0.05-10 Hz (logarithmic)
+    float lfoDepth = 0.0f;        // LFO depth: 0-4 octaves
+    float envAmount = 0.5f;       // Envelope sweep: -4 to +4 octaves
+    float stereoPhase = 0.0f;     // LFO phase offset L/R: 0-180 degrees
+    float mix = 1.0f;             // Dry/Wet Mix: 0-100%
+
+    ZdfTanTable tanTable;
+    ZdfSvf svf;
+
+    // Modulation state
+    float lfoPhase = 0.0f;
+    float lfoIncrement = 0.0f;
+    float envelope = 0.0f;
+    float envelopeRelease = 0.0f;
+
+    // Cutoff in octaves above ZdfTanTable::BASE_HZ, smoothed per sample
+    float targetOctaves = 0.0f;
+    float currentOctaves = 0.0f;
+    float octaveSmoothing = 0.0f;
+    float lfoOctaves = 0.0f;
+    float envOctaves = 0.0f;
+    float dampingK = 2.0f;
+
+    // Sample rate and block size
+    double sampleRate = 44100.0;
+    int blockSize = 512;
+
+    // Helper methods
+    void updateParameters();
+    static float parabolicSine(float phase);
+
+    // Parameter validation
+    void validateParameters();
+};
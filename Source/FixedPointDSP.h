@@ -1,7 +1,7 @@
 // FixedPointDSP.h - Corrected with Q12 method names
 #pragma once
 
-#include <JuceHeader.h>
+#include "DspCore.h"
 
 //==============================================================================
 // HISC-style Fixed-Point (20-bit with 12-bit fraction)
@@ -18,7 +18,7 @@ struct FixedPointSample {
     static constexpr int32_t Q12_ONE = 1 << 12;  // 4096
 
     inline void saturate() {
-        value = juce::jlimit<int32_t>(HISC_MIN, HISC_MAX, value);
+        value = dsp256::jlimit<int32_t>(HISC_MIN, HISC_MAX, value);
     }
 };
 
@@ -46,7 +46,7 @@ public:
             result < static_cast<int64_t>(FixedPointSample::HISC_MIN));
 
         FixedPointSample output;
-        output.value = static_cast<int32_t>(juce::jlimit<int64_t>(
+        output.value = static_cast<int32_t>(dsp256::jlimit<int64_t>(
             static_cast<int64_t>(FixedPointSample::HISC_MIN),
             static_cast<int64_t>(FixedPointSample::HISC_MAX),
             result));
@@ -62,7 +62,7 @@ public:
             product < static_cast<int64_t>(FixedPointSample::HISC_MIN));
 
         FixedPointSample result;
-        result.value = static_cast<int32_t>(juce::jlimit<int64_t>(
+        result.value = static_cast<int32_t>(dsp256::jlimit<int64_t>(
             static_cast<int64_t>(FixedPointSample::HISC_MIN),
             static_cast<int64_t>(FixedPointSample::HISC_MAX),
             product));
@@ -84,6 +84,22 @@ public:
         return static_cast<float>(q.value) / static_cast<float>(FixedPointSample::Q12_ONE);
     }
 
+    // Round-trip a float block through Q12 in place (same result as
+    // Q12ToFloat(floatToQ12(x)) per sample). Clamping before the cast keeps
+    // the loop branch-free so the compiler can vectorize it.
+    void quantizeBlock(float* samples, int numSamples) {
+        constexpr float scale = static_cast<float>(FixedPointSample::Q12_ONE);
+        constexpr float invScale = 1.0f / scale;
+        constexpr float hiscMax = static_cast<float>(FixedPointSample::HISC_MAX);
+        constexpr float hiscMin = static_cast<float>(FixedPointSample::HISC_MIN);
+
+        for (int i = 0; i < numSamples; ++i) {
+            float scaled = samples[i] * scale;
+            scaled = scaled < hiscMin ? hiscMin : (scaled > hiscMax ? hiscMax : scaled);
+            samples[i] = static_cast<float>(static_cast<int32_t>(scaled)) * invScale;
+        }
+    }
+
     // Apply DC offset filter (common in vintage DSP)
     FixedPointSample dcBlock(FixedPointSample input, float& state) {
         float inputFloat = Q12ToFloat(input);
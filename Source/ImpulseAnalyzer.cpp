@@ -0,0 +1,256 @@
+// ImpulseAnalyzer.cpp - Offline impulse response rendering and decay analysis
+#include "ImpulseAnalyzer.h"
+#include "FixedPointDSP.h"
+#include "DelayMemoryPool.h"
+#include "ZdfFilter.h"
+#include <cmath>
+
+//==============================================================================
+namespace
+{
+    constexpr float BAND_K = 0.70710678f;     // 1/Q for an octave-wide band-pass
+
+    // Backward-integrates 'energy' in place and converts it to dB re t = 0.
+    // The running sum is double; each stored value keeps its own precision.
+    void schroederIntegrate(std::vector<float>& energy)
+    {
+        double sum = 0.0;
+        for (size_t i = energy.size(); i-- > 0;) {
+            sum += energy[i];
+            energy[i] = static_cast<float>(sum);
+        }
+
+        for (auto& value : energy) {
+            value = sum > 0.0 && value > 0.0f
+                ? juce::jmax(DecayAnalysis::FLOOR_DB, static_cast<float>(10.0 * std::log10(value / sum)))
+                : DecayAnalysis::FLOOR_DB;
+        }
+    }
+
+    // Least-squares slope of the curve between 'startDb' and 'endDb',
+    // extrapolated to a 60 dB decay; 0 if the curve never gets there
+    float fitDecay(const std::vector<float>& curveDb, double sampleRate, float startDb, float endDb)
+    {
+        const size_t n = curveDb.size();
+        size_t first = 0;
+        while (first < n && curveDb[first] > startDb)
+            ++first;
+        size_t last = first;
+        while (last < n && curveDb[last] > endDb)
+            ++last;
+        if (last >= n || last < first + 2)
+            return 0.0f;
+
+        const double count = static_cast<double>(last - first + 1);
+        double sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+        for (size_t i = first; i <= last; ++i) {
+            const double x = static_cast<double>(i - first);
+            const double y = curveDb[i];
+            sumX += x;
+            sumY += y;
+            sumXX += x * x;
+            sumXY += x * y;
+        }
+
+        const double slope = (count * sumXY - sumX * sumY) / (count * sumXX - sumX * sumX);
+        return slope < 0.0 ? static_cast<float>(-60.0 / (slope * sampleRate)) : 0.0f;
+    }
+
+    float fitRT60(const std::vector<float>& curveDb, double sampleRate)
+    {
+        const float t30 = fitDecay(curveDb, sampleRate, -5.0f, -35.0f);
+        return t30 > 0.0f ? t30 : fitDecay(curveDb, sampleRate, -5.0f, -25.0f);
+    }
+
+    void decimate(const std::vector<float>& curveDb, double sampleRate, std::vector<float>& points)
+    {
+        const double step = juce::jmax(1.0, DecayAnalysis::CURVE_STEP_SECONDS * sampleRate);
+        points.clear();
+        for (double position = 0.0; position < static_cast<double>(curveDb.size()); position += step)
+            points.push_back(curveDb[static_cast<size_t>(position)]);
+    }
+}
+
+//==============================================================================
+DecayAnalysis DecayAnalysis::analyze(const float* left, const float* right, int numSamples, double sampleRate)
+{
+    DecayAnalysis result;
+    if (numSamples <= 0 || sampleRate <= 0.0)
+        return result;
+
+    std::vector<float> energy(static_cast<size_t>(numSamples));
+
+    // Broadband
+    for (int i = 0; i < numSamples; ++i)
+        energy[static_cast<size_t>(i)] = left[i] * left[i] + right[i] * right[i];
+    schroederIntegrate(energy);
+    result.rt60 = fitRT60(energy, sampleRate);
+    result.edt = fitDecay(energy, sampleRate, 0.0f, -10.0f);
+    decimate(energy, sampleRate, result.curve);
+
+    // Octave bands: L and R ride lanes 0/1 through two cascaded band-passes
+    const Float4 k = Float4::broadcast(BAND_K);
+    for (int band = 0; band < NUM_BANDS; ++band) {
+        const float hz = BAND_HZ[static_cast<size_t>(band)];
+        if (hz >= 0.45f * static_cast<float>(sampleRate))
+            continue;
+
+        const Float4 g = Float4::broadcast(static_cast<float>(std::tan(juce::MathConstants<double>::pi * hz / sampleRate)));
+        ZdfSvf firstStage;
+        ZdfSvf secondStage;
+        float lanes[4];
+
+        for (int i = 0; i < numSamples; ++i) {
+            const Float4 x = Float4::set(left[i], right[i], 0.0f, 0.0f);
+            const Float4 y = k * secondStage.process(k * firstStage.process(x, g, k).band, g, k).band;
+            y.store(lanes);
+            energy[static_cast<size_t>(i)] = lanes[0] * lanes[0] + lanes[1] * lanes[1];
+        }
+
+        schroederIntegrate(energy);
+        result.bandRT60[static_cast<size_t>(band)] = fitRT60(energy, sampleRate);
+        result.bandEDT[static_cast<size_t>(band)] = fitDecay(energy, sampleRate, 0.0f, -10.0f);
+        decimate(energy, sampleRate, result.bandCurves[static_cast<size_t>(band)]);
+    }
+
+    return result;
+}
+
+//==============================================================================
+ImpulseRenderer::ImpulseRenderer()
+    : juce::Thread("Impulse Renderer")
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+ImpulseRenderer::~ImpulseRenderer()
+{
+    stopThread(2000);
+}
+
+void ImpulseRenderer::requestRender(std::unique_ptr<EffectModule> module, double sampleRate)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        pendingModule = std::move(module);
+        pendingSampleRate = sampleRate;
+        requestTime = juce::Time::getMillisecondCounter();
+        generation.fetch_add(1);
+    }
+    notify();
+}
+
+bool ImpulseRenderer::fetchResult(DecayAnalysis& result)
+{
+    const juce::ScopedLock sl(lock);
+    if (!hasFinished)
+        return false;
+
+    result = std::move(finished);
+    hasFinished = false;
+    return true;
+}
+
+bool ImpulseRenderer::isStale(uint32_t renderGeneration) const
+{
+    return threadShouldExit() || generation.load() != renderGeneration;
+}
+
+//==============================================================================
+void ImpulseRenderer::run()
+{
+    while (!threadShouldExit()) {
+        std::unique_ptr<EffectModule> module;
+        double sampleRate = 0.0;
+        uint32_t renderGeneration = 0;
+        int waitMs = -1;
+
+        // Take the newest request once it has been quiet for DEBOUNCE_MS
+        {
+            const juce::ScopedLock sl(lock);
+            if (pendingModule != nullptr) {
+                const int age = static_cast<int>(juce::Time::getMillisecondCounter() - requestTime);
+                if (age >= DEBOUNCE_MS) {
+                    module = std::move(pendingModule);
+                    sampleRate = pendingSampleRate;
+                    renderGeneration = generation.load();
+                }
+                else {
+                    waitMs = DEBOUNCE_MS - age;
+                }
+            }
+        }
+
+        if (module == nullptr) {
+            wait(waitMs);
+            continue;
+        }
+
+        if (!renderImpulse(*module, sampleRate, renderGeneration))
+            continue;
+
+        DecayAnalysis analysis = DecayAnalysis::analyze(impulseL.data(), impulseR.data(),
+            static_cast<int>(impulseL.size()), sampleRate);
+        if (isStale(renderGeneration))
+            continue;
+
+        const juce::ScopedLock sl(lock);
+        finished = std::move(analysis);
+        hasFinished = true;
+    }
+}
+
+// Unit impulse through the block kernel at the processor's control rate,
+// until a window sits 80 dB under the loudest one (or MAX_SECONDS)
+bool ImpulseRenderer::renderImpulse(EffectModule& module, double sampleRate, uint32_t renderGeneration)
+{
+    constexpr int BLOCKS_PER_WINDOW = 64;
+    constexpr double STOP_RATIO = 1.0e-8;
+
+    FixedPointEngine dspCore;
+    dspCore.prepare(sampleRate);
+    DelayMemoryPool delayPool(1024);          // Modules render from their own buffers
+    delayPool.prepare(sampleRate);
+    module.prepare(sampleRate, RENDER_BLOCK);
+
+    const int maxSamples = static_cast<int>(MAX_SECONDS * sampleRate);
+    impulseL.clear();
+    impulseR.clear();
+    impulseL.reserve(static_cast<size_t>(maxSamples));
+    impulseR.reserve(static_cast<size_t>(maxSamples));
+
+    std::array<float, RENDER_BLOCK> left{};
+    std::array<float, RENDER_BLOCK> right{};
+    double windowEnergy = 0.0;
+    double loudestWindow = 0.0;
+
+    for (int block = 0; block * RENDER_BLOCK < maxSamples; ++block) {
+        if (isStale(renderGeneration))
+            return false;
+
+        left.fill(0.0f);
+        right.fill(0.0f);
+        if (block == 0) {
+            left[0] = 1.0f;
+            right[0] = 1.0f;
+        }
+
+        module.processBlock(left.data(), right.data(), RENDER_BLOCK, delayPool, dspCore);
+        module.updateModulation(RENDER_BLOCK);
+
+        impulseL.insert(impulseL.end(), left.begin(), left.end());
+        impulseR.insert(impulseR.end(), right.begin(), right.end());
+        for (int i = 0; i < RENDER_BLOCK; ++i)
+            windowEnergy += left[static_cast<size_t>(i)] * left[static_cast<size_t>(i)]
+                + right[static_cast<size_t>(i)] * right[static_cast<size_t>(i)];
+
+        if ((block + 1) % BLOCKS_PER_WINDOW == 0) {
+            loudestWindow = juce::jmax(loudestWindow, windowEnergy);
+            if (windowEnergy <= loudestWindow * STOP_RATIO)
+                break;
+            windowEnergy = 0.0;
+        }
+    }
+
+    return !isStale(renderGeneration);
+}
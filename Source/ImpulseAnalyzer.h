@@ -0,0 +1,82 @@
+// ImpulseAnalyzer.h - Offline impulse response rendering and decay analysis
+#pragma once
+
+#include <JuceHeader.h>
+#include "EffectModule.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+// Decay measurements from a rendered stereo impulse response. Each curve is
+// the Schroeder backward integral of L^2 + R^2 in dB (0 dB at t = 0). RT60
+// is fitted over -5..-35 dB (T30), or over -5..-25 dB (T20) when the curve
+// stops short. EDT is fitted over 0..-10 dB. Octave bands use two cascaded
+// TPT band-passes per band. A value of 0 means the curve never reached the
+// fit range.
+//==============================================================================
+struct DecayAnalysis {
+    static constexpr int NUM_BANDS = 8;
+    static constexpr std::array<float, NUM_BANDS> BAND_HZ{ 63.0f, 125.0f, 250.0f, 500.0f,
+                                                           1000.0f, 2000.0f, 4000.0f, 8000.0f };
+    static constexpr double CURVE_STEP_SECONDS = 0.01;    // Plot resolution
+    static constexpr float FLOOR_DB = -120.0f;
+
+    float rt60 = 0.0f;                                    // Broadband, seconds
+    float edt = 0.0f;
+    std::array<float, NUM_BANDS> bandRT60{};
+    std::array<float, NUM_BANDS> bandEDT{};
+
+    // Decimated decay curves in dB, one point per CURVE_STEP_SECONDS
+    std::vector<float> curve;
+    std::array<std::vector<float>, NUM_BANDS> bandCurves;
+
+    static DecayAnalysis analyze(const float* left, const float* right, int numSamples, double sampleRate);
+};
+
+//==============================================================================
+// Renders the current module's impulse response on a background thread and
+// analyses it. Requests are debounced: a render only starts once no new
+// request has arrived for DEBOUNCE_MS. A newer request abandons the render in
+// progress at its next block. The module passed in is a fresh instance loaded
+// with a snapshot of the parameters, so the audio thread is never touched.
+// Message thread API only.
+//==============================================================================
+class ImpulseRenderer : private juce::Thread
+{
+public:
+    static constexpr int DEBOUNCE_MS = 250;
+    static constexpr double MAX_SECONDS = 15.0;
+
+    ImpulseRenderer();
+    ~ImpulseRenderer() override;
+
+    // Replaces any pending request and restarts the debounce
+    void requestRender(std::unique_ptr<EffectModule> module, double sampleRate);
+
+    // True (filling 'result') once for each completed render
+    bool fetchResult(DecayAnalysis& result);
+
+private:
+    static constexpr int RENDER_BLOCK = 64;               // Matches the processor's control rate
+
+    void run() override;
+    bool renderImpulse(EffectModule& module, double sampleRate, uint32_t renderGeneration);
+    bool isStale(uint32_t renderGeneration) const;
+
+    // Request/result handoff (message thread <-> worker)
+    juce::CriticalSection lock;
+    std::unique_ptr<EffectModule> pendingModule;
+    double pendingSampleRate = 44100.0;
+    juce::uint32 requestTime = 0;
+    std::atomic<uint32_t> generation{ 0 };
+    DecayAnalysis finished;
+    bool hasFinished = false;
+
+    // Worker-only render buffers
+    std::vector<float> impulseL;
+    std::vector<float> impulseR;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ImpulseRenderer)
+};
@@ -0,0 +1,124 @@
+// MeterRing.h - Wait-free meter and analyzer feeds from the audio thread to the editor
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+//==============================================================================
+// Single-producer/single-consumer ring. push() and pop() are wait-free: one
+// relaxed load of the caller's own index, one acquire load of the other side
+// and one release store. A full ring drops the new item rather than block.
+//==============================================================================
+template <typename T, int Capacity>
+class SpscRing {
+public:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    // Producer side (audio thread)
+    bool push(const T& item) noexcept
+    {
+        const uint32_t write = writeIndex.load(std::memory_order_relaxed);
+        const uint32_t read = readIndex.load(std::memory_order_acquire);
+        if (write - read >= static_cast<uint32_t>(Capacity)) {
+            droppedItems.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        slots[write & MASK] = item;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side (message thread)
+    bool pop(T& item) noexcept
+    {
+        const uint32_t read = readIndex.load(std::memory_order_relaxed);
+        const uint32_t write = writeIndex.load(std::memory_order_acquire);
+        if (read == write)
+            return false;
+
+        item = slots[read & MASK];
+        readIndex.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    uint32_t getDroppedCount() const noexcept { return droppedItems.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t MASK = static_cast<uint32_t>(Capacity - 1);
+
+    std::array<T, Capacity> slots{};
+    alignas(64) std::atomic<uint32_t> writeIndex{ 0 };
+    alignas(64) std::atomic<uint32_t> readIndex{ 0 };
+    std::atomic<uint32_t> droppedItems{ 0 };
+};
+
+//==============================================================================
+// One frame per processed host block
+//==============================================================================
+struct MeterFrame {
+    float peak = 0.0f;            // Output peak, linear
+    float rms = 0.0f;             // Output RMS over all channels, linear
+    float tailLevel = 0.0f;       // Module's wet tail envelope, linear
+    uint32_t overflowCount = 0;   // Output samples at or beyond full scale
+};
+
+// ~1.3 s of 512-sample blocks at 48 kHz; the editor drains it at 30 Hz
+using MeterRing = SpscRing<MeterFrame, 128>;
+
+//==============================================================================
+// Bulk sample variant of SpscRing: the producer copies whole blocks in at
+// most two memcpy segments; whatever does not fit is dropped.
+//==============================================================================
+template <int Capacity>
+class SpscSampleRing {
+public:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    // Producer side (audio thread); returns the number of samples written
+    int write(const float* samples, int numSamples) noexcept
+    {
+        const uint32_t head = writeIndex.load(std::memory_order_relaxed);
+        const uint32_t tail = readIndex.load(std::memory_order_acquire);
+        const int count = std::min(numSamples, Capacity - static_cast<int>(head - tail));
+        if (count <= 0)
+            return 0;
+
+        const uint32_t position = head & MASK;
+        const int first = std::min(count, Capacity - static_cast<int>(position));
+        std::memcpy(buffer.data() + position, samples, sizeof(float) * static_cast<size_t>(first));
+        std::memcpy(buffer.data(), samples + first, sizeof(float) * static_cast<size_t>(count - first));
+        writeIndex.store(head + static_cast<uint32_t>(count), std::memory_order_release);
+        return count;
+    }
+
+    // Consumer side (message thread); returns the number of samples read
+    int read(float* destination, int maxSamples) noexcept
+    {
+        const uint32_t tail = readIndex.load(std::memory_order_relaxed);
+        const uint32_t head = writeIndex.load(std::memory_order_acquire);
+        const int count = std::min(maxSamples, static_cast<int>(head - tail));
+        if (count <= 0)
+            return 0;
+
+        const uint32_t position = tail & MASK;
+        const int first = std::min(count, Capacity - static_cast<int>(position));
+        std::memcpy(destination, buffer.data() + position, sizeof(float) * static_cast<size_t>(first));
+        std::memcpy(destination + first, buffer.data(), sizeof(float) * static_cast<size_t>(count - first));
+        readIndex.store(tail + static_cast<uint32_t>(count), std::memory_order_release);
+        return count;
+    }
+
+private:
+    static constexpr uint32_t MASK = static_cast<uint32_t>(Capacity - 1);
+
+    std::array<float, Capacity> buffer{};
+    alignas(64) std::atomic<uint32_t> writeIndex{ 0 };
+    alignas(64) std::atomic<uint32_t> readIndex{ 0 };
+};
+
+// Mono wet samples for the editor's spectrogram (~170 ms at 48 kHz)
+using AnalyzerRing = SpscSampleRing<8192>;
@@ -1,6 +1,60 @@
 // PluginEditor.cpp - Fixed with Resizable Support and Custom Styles
 #include "PluginEditor.h"
 
+// Build with DSP256_REPAINT_BENCHMARK=1 to log knob repaint cost on open
+#ifndef DSP256_REPAINT_BENCHMARK
+ #define DSP256_REPAINT_BENCHMARK 0
+#endif
+
+#if DSP256_REPAINT_BENCHMARK
+//==============================================================================
+// Average drawRotarySlider time into an offscreen ARGB image (software
+// renderer), sweeping the value so the indicator moves every call
+static double measureKnobRepaintMicros(HardwareKnobLookAndFeel& lookAndFeel,
+    int size, float scale, int iterations)
+{
+    juce::Slider slider;
+    juce::Image target(juce::Image::ARGB, juce::roundToInt(static_cast<float>(size) * scale),
+        juce::roundToInt(static_cast<float>(size) * scale), true);
+    juce::Graphics g(target);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
+    const float startAngle = juce::MathConstants<float>::pi * 1.25f;
+    const float endAngle = juce::MathConstants<float>::pi * 2.75f;
+
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    for (int i = 0; i < iterations; ++i)
+    {
+        lookAndFeel.drawRotarySlider(g, 0, 0, size, size,
+            static_cast<float>(i % 100) / 100.0f, startAngle, endAngle, slider);
+    }
+    const double seconds = juce::Time::highResolutionTicksToSeconds(
+        juce::Time::getHighResolutionTicks() - startTicks);
+
+    return 1.0e6 * seconds / static_cast<double>(iterations);
+}
+
+static void logKnobRepaintCost(int size)
+{
+    constexpr int iterations = 500;
+    HardwareKnobLookAndFeel lookAndFeel;
+
+    for (float scale : { 1.0f, 1.5f, 2.0f })
+    {
+        lookAndFeel.setBodyCaching(false);
+        const double uncached = measureKnobRepaintMicros(lookAndFeel, size, scale, iterations);
+
+        lookAndFeel.setBodyCaching(true);
+        measureKnobRepaintMicros(lookAndFeel, size, scale, 1);   // Fill the cache
+        const double cached = measureKnobRepaintMicros(lookAndFeel, size, scale, iterations);
+
+        juce::Logger::writeToLog("Knob repaint " + juce::String(size) + "px @" + juce::String(scale, 1)
+            + "x: uncached " + juce::String(uncached, 1) + " us, cached " + juce::String(cached, 1)
+            + " us (" + juce::String(uncached / juce::jmax(cached, 1.0e-3), 1) + "x)");
+    }
+}
+#endif
+
 //==============================================================================
 PluginEditor::PluginEditor(PluginProcessor& p)
     : AudioProcessorEditor(&p), audioProcessor(p)
@@ -12,8 +66,13 @@ PluginEditor::PluginEditor(PluginProcessor& p)
     setResizable(true, true);
     setResizeLimits(700, 450, 1200, 750);
 
+    // paint() covers every pixel, so nothing behind the editor is redrawn
+    setOpaque(true);
+
     // Main LCD first
     addAndMakeVisible(mainLcd);
+    addAndMakeVisible(spectrogram);
+    addAndMakeVisible(decayView);
 
     // Initialize all knobs
     for (size_t i = 0; i < parameterKnobs.size(); ++i)
@@ -38,6 +97,7 @@ PluginEditor::PluginEditor(PluginProcessor& p)
         mainLcd.setText(module->getModuleDescription(), 1);
 
         const auto paramDefs = module->getParameterDefinitions();
+        numParameterKnobs = juce::jmin(static_cast<int>(paramDefs.size()), static_cast<int>(parameterKnobs.size()));
 
         // Map parameters to knobs
         for (size_t i = 0; i < parameterKnobs.size(); ++i)
@@ -52,11 +112,23 @@ PluginEditor::PluginEditor(PluginProcessor& p)
             }
             else if (parameterKnobs[i])
             {
-                parameterKnobs[i]->setVisible(false);
                 knobLabels[i].setText("", juce::dontSendNotification);
             }
         }
 
+        // Page button: only when the parameters need more than one page
+        if (numParameterKnobs > KNOBS_PER_PAGE)
+        {
+            addAndMakeVisible(pageButton);
+            pageButton.setColour(juce::TextButton::buttonColourId, juce::Colour(60, 60, 65));
+            pageButton.setColour(juce::TextButton::textColourOffId, juce::Colours::silver);
+            pageButton.onClick = [this]
+                {
+                    const int pages = (numParameterKnobs + KNOBS_PER_PAGE - 1) / KNOBS_PER_PAGE;
+                    showKnobPage((knobPage + 1) % pages);
+                };
+        }
+
         // Preset selector
         addAndMakeVisible(presetLabel);
         presetLabel.setText("PRESET:", juce::dontSendNotification);
@@ -100,6 +172,8 @@ PluginEditor::PluginEditor(PluginProcessor& p)
         }
     }
 
+    showKnobPage(0);
+
     constexpr int timerFrequencyHz = 30;
     startTimerHz(timerFrequencyHz);
 
@@ -107,6 +181,10 @@ PluginEditor::PluginEditor(PluginProcessor& p)
     // This ensures knobs are visible immediately without needing to resize window
     resized();
 
+#if DSP256_REPAINT_BENCHMARK
+    logKnobRepaintCost(96);
+#endif
+
     DBG("PluginEditor constructed with " << parameterKnobs.size() << " knobs");
     DBG("=== PluginEditor Constructor END ===");
 }
@@ -118,6 +196,26 @@ PluginEditor::~PluginEditor()
 
 //==============================================================================
 void PluginEditor::paint(juce::Graphics& g)
+{
+    // The chassis never changes between resizes: render it once per size and
+    // pixel scale, then every repaint (LCDs, knobs, clipped) is one blit
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (!backgroundImage.isValid() || scale != backgroundScale)
+    {
+        backgroundImage = juce::Image(juce::Image::RGB,
+            juce::jmax(1, juce::roundToInt(static_cast<float>(getWidth()) * scale)),
+            juce::jmax(1, juce::roundToInt(static_cast<float>(getHeight()) * scale)), false);
+        backgroundScale = scale;
+
+        juce::Graphics imageGraphics(backgroundImage);
+        imageGraphics.addTransform(juce::AffineTransform::scale(scale));
+        paintChassis(imageGraphics);
+    }
+
+    g.drawImage(backgroundImage, getLocalBounds().toFloat());
+}
+
+void PluginEditor::paintChassis(juce::Graphics& g)
 {
     // Dark background first
     g.fillAll(juce::Colour(30, 30, 35));
@@ -148,7 +246,7 @@ void PluginEditor::paint(juce::Graphics& g)
 //==============================================================================
 void PluginEditor::resized()
 {
-    debugLayout();
+    backgroundImage = {};
 
     constexpr int margin = 20;
     constexpr int topSectionHeight = 60;
@@ -158,6 +256,7 @@ void PluginEditor::resized()
     constexpr int presetSectionHeight = 40;
     constexpr int presetLabelWidth = 80;
     constexpr int presetSelectorWidth = 200;
+    constexpr int pageButtonWidth = 100;
 
     // Knob section - position at bottom
     constexpr int knobSectionTop = 300;
@@ -174,23 +273,30 @@ void PluginEditor::resized()
     auto lcdArea = area.removeFromTop(lcdHeight);
     mainLcd.setBounds(lcdArea.reduced(lcdHorizontalPadding, lcdVerticalPadding));
 
-    // Preset selector
+    // Preset selector and knob page button
     auto presetArea = area.removeFromTop(presetSectionHeight);
-    presetArea = presetArea.withSizeKeepingCentre(300, presetSectionHeight);
+    presetArea = presetArea.withSizeKeepingCentre(presetLabelWidth + presetSelectorWidth + pageButtonWidth, presetSectionHeight);
     presetLabel.setBounds(presetArea.removeFromLeft(presetLabelWidth));
     presetSelector.setBounds(presetArea.removeFromLeft(presetSelectorWidth).reduced(5));
+    pageButton.setBounds(presetArea.reduced(5));
+
+    // Spectrogram and measured decay between the preset row and the knobs
+    auto analyzerArea = area.removeFromTop(juce::jmax(0, knobSectionTop - area.getY()))
+        .reduced(lcdHorizontalPadding, lcdVerticalPadding);
+    decayView.setBounds(analyzerArea.removeFromRight(analyzerArea.getWidth() / 3));
+    spectrogram.setBounds(analyzerArea.withTrimmedRight(knobSpacing));
 
-    // Calculate knob positions
+    // Calculate knob positions: every page uses the same KNOBS_PER_PAGE slots
     const int knobCount = static_cast<int>(parameterKnobs.size());
     const int totalWidth = getWidth() - 2 * margin;
-    const int availableWidthForKnobs = totalWidth - (knobCount - 1) * knobSpacing;
-    const int knobWidth = availableWidthForKnobs / knobCount;
+    const int availableWidthForKnobs = totalWidth - (KNOBS_PER_PAGE - 1) * knobSpacing;
+    const int knobWidth = availableWidthForKnobs / KNOBS_PER_PAGE;
 
     // Position knob labels
     for (int i = 0; i < knobCount; ++i)
     {
-        int labelX = margin + i * (knobWidth + knobSpacing);
-        knobLabels[i].setBounds(labelX, knobSectionTop, knobWidth, knobLabelHeight);
+        int labelX = margin + (i % KNOBS_PER_PAGE) * (knobWidth + knobSpacing);
+        knobLabels[static_cast<size_t>(i)].setBounds(labelX, knobSectionTop, knobWidth, knobLabelHeight);
     }
 
     // Position knobs
@@ -199,52 +305,152 @@ void PluginEditor::resized()
     {
         if (parameterKnobs[static_cast<size_t>(i)])
         {
-            int knobX = margin + i * (knobWidth + knobSpacing);
+            int knobX = margin + (i % KNOBS_PER_PAGE) * (knobWidth + knobSpacing);
             juce::Rectangle<int> knobBounds(knobX, knobY, knobWidth, knobHeight);
             parameterKnobs[static_cast<size_t>(i)]->setBounds(knobBounds);
-            parameterKnobs[static_cast<size_t>(i)]->setVisible(true);
-            parameterKnobs[static_cast<size_t>(i)]->repaint();
         }
     }
 }
 
+// Shows one page of knobs and labels and hides the rest
+void PluginEditor::showKnobPage(int page)
+{
+    knobPage = page;
+    for (int i = 0; i < static_cast<int>(parameterKnobs.size()); ++i)
+    {
+        const bool visible = i < numParameterKnobs && i / KNOBS_PER_PAGE == page;
+        if (parameterKnobs[static_cast<size_t>(i)])
+            parameterKnobs[static_cast<size_t>(i)]->setVisible(visible);
+        knobLabels[static_cast<size_t>(i)].setVisible(visible);
+    }
+
+    const int pages = (numParameterKnobs + KNOBS_PER_PAGE - 1) / KNOBS_PER_PAGE;
+    pageButton.setButtonText("PAGE " + juce::String(page + 1) + "/" + juce::String(juce::jmax(1, pages)));
+}
+
 //==============================================================================
 void PluginEditor::timerCallback()
 {
     updateMainLcd();
+#if DSP256_STAGE_PROFILING
+    updateStageTimings();
+#endif
+    spectrogram.update(audioProcessor.getAnalyzerRing(), audioProcessor.getSampleRate());
+    updateDecayAnalysis();
 }
 
-void PluginEditor::updateMainLcd()
+void PluginEditor::updateDecayAnalysis()
 {
+    DecayAnalysis analysis;
+    if (impulseRenderer.fetchResult(analysis))
+        decayView.setAnalysis(std::move(analysis));
+
     auto* module = audioProcessor.getEffectModule();
-    if (module == nullptr || !mainLcd.isLcdEnabled())
+    const double sampleRate = audioProcessor.getSampleRate();
+    if (module == nullptr || sampleRate <= 0.0)
         return;
 
-    if (module->hasRealtimeDisplay())
+    // Snapshot from the APVTS atomics, never the live module (the audio thread
+    // owns it). The copy renders fully wet so the dry spike doesn't skew the EDT,
+    // and unducked: the impulse would key the ducker, and the decay would follow
+    // the duck release instead of the reverb.
+    const auto& definitions = audioProcessor.getParameterDefinitions();
+    bool changed = sampleRate != renderedSampleRate;
+    const int count = juce::jmin(static_cast<int>(definitions.size()), static_cast<int>(renderedParameters.size()));
+    for (int i = 0; i < count; ++i)
     {
-        const juce::String info = module->getRealtimeDisplayInfo();
-        mainLcd.setText(info, 3);
+        const auto& id = definitions[static_cast<size_t>(i)].id;
+        const float value = id == "mix" ? 1.0f
+                          : id == "duckdepth" ? 0.0f
+                                              : audioProcessor.getNormalizedParameter(i);
+        if (value != renderedParameters[static_cast<size_t>(i)])
+        {
+            renderedParameters[static_cast<size_t>(i)] = value;
+            changed = true;
+        }
+    }
+
+    if (!changed)
+        return;
+
+    renderedSampleRate = sampleRate;
+    if (auto copy = module->createInstance())
+    {
+        copy->loadPreset(EffectPreset("Decay Analysis", "Fully wet, unducked snapshot",
+            std::vector<float>(renderedParameters.begin(), renderedParameters.begin() + count)));
+        impulseRenderer.requestRender(std::move(copy), sampleRate);
     }
 }
 
-//==============================================================================
-void PluginEditor::debugLayout()
+// Level below full scale in tenths of a dB; anything hotter shows as 0.0
+// (and is counted by the overflow total)
+static int toTenthsOfDb(float gain)
 {
-    DBG("=== PluginEditor Layout Debug ===");
-    DBG("Window size: " << getWidth() << "x" << getHeight());
-    DBG("Number of knobs: " << parameterKnobs.size());
+    return juce::jmax(0, juce::roundToInt(-10.0f * juce::Decibels::gainToDecibels(gain, -99.9f)));
+}
 
-    int visibleKnobs = 0;
-    for (size_t i = 0; i < parameterKnobs.size(); ++i)
+void PluginEditor::updateMainLcd()
+{
+    // Drain every frame published since the last tick: hold the loudest
+    // peak, keep the latest RMS and tail, accumulate overflows
+    MeterFrame frame;
+    MeterFrame merged;
+    bool received = false;
+    while (audioProcessor.getMeterRing().pop(frame))
     {
-        if (parameterKnobs[i] && parameterKnobs[i]->isVisible())
-        {
-            visibleKnobs++;
-            auto bounds = parameterKnobs[i]->getBounds();
-            DBG("Knob " << i << " bounds: "
-                << bounds.getX() << "," << bounds.getY() << " "
-                << bounds.getWidth() << "x" << bounds.getHeight());
-        }
+        merged.peak = juce::jmax(merged.peak, frame.peak);
+        merged.rms = frame.rms;
+        merged.tailLevel = frame.tailLevel;
+        overflowTotal += frame.overflowCount;
+        received = true;
     }
-    DBG("Visible knobs: " << visibleKnobs);
-}
\ No newline at end of file
+
+    if (!received || !mainLcd.isLcdEnabled())
+        return;
+
+    const int peakTenths = toTenthsOfDb(merged.peak);
+    const int rmsTenths = toTenthsOfDb(merged.rms);
+    const int tailTenths = toTenthsOfDb(merged.tailLevel);
+    if (meterShown && peakTenths == shownPeakTenths && rmsTenths == shownRmsTenths
+        && tailTenths == shownTailTenths && overflowTotal == shownOverflow)
+        return;
+
+    shownPeakTenths = peakTenths;
+    shownRmsTenths = rmsTenths;
+    shownTailTenths = tailTenths;
+    shownOverflow = overflowTotal;
+    meterShown = true;
+
+    mainLcd.setText(juce::String::formatted("PK -%d.%d  RMS -%d.%d  TAIL -%d.%d dB  OVR %u",
+        peakTenths / 10, peakTenths % 10, rmsTenths / 10, rmsTenths % 10,
+        tailTenths / 10, tailTenths % 10, static_cast<unsigned>(overflowTotal)), 3);
+}
+
+#if DSP256_STAGE_PROFILING
+// Average stage cost per processBlock() call in microseconds on line 1, the
+// whole call's average and worst case on line 2
+void PluginEditor::updateStageTimings()
+{
+    if (--stageTimingCountdown > 0)
+        return;
+    stageTimingCountdown = STAGE_TIMING_TICKS;
+
+    auto* module = audioProcessor.getEffectModule();
+    if (module == nullptr || !mainLcd.isLcdEnabled())
+        return;
+
+    std::array<StageTiming, 16> timings;
+    const int count = module->getStageTimings(timings.data(), static_cast<int>(timings.size()));
+    if (count < 1)
+        return;
+
+    juce::String stages;
+    for (int i = 0; i < count - 1; ++i)
+        stages << timings[static_cast<size_t>(i)].name << " " << juce::String(timings[static_cast<size_t>(i)].averageNs * 0.001, 1) << " ";
+
+    const auto& block = timings[static_cast<size_t>(count - 1)];
+    mainLcd.setText(stages + "us", 1);
+    mainLcd.setText(juce::String::formatted("BLOCK AVG %.1f us  MAX %.1f us",
+        block.averageNs * 0.001, block.maxNs * 0.001), 2);
+}
+#endif
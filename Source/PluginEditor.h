@@ -2,23 +2,46 @@
 #pragma once
 
 #include "PluginProcessor.h"
+#include "ImpulseAnalyzer.h"
 #include <array>
+#include <vector>
 
 //==============================================================================
-// Custom Hardware Knob Look and Feel
+// Pre-rendered knob bodies (shadow, body, cap, chrome ring) keyed by slider
+// size and physical pixel scale. One cache is shared by every knob of every
+// open editor via SharedResourcePointer; message thread only.
 //==============================================================================
-class HardwareKnobLookAndFeel : public juce::LookAndFeel_V4
+class KnobBodyCache
 {
 public:
-    void drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height,
-        float sliderPos, const float rotaryStartAngle, const float rotaryEndAngle,
-        juce::Slider& slider) override
+    const juce::Image& get(int width, int height, float scale)
     {
-        juce::ignoreUnused(slider); // Suppress unused parameter warning
+        for (const auto& entry : entries)
+        {
+            if (entry.width == width && entry.height == height && entry.scale == scale)
+                return entry.image;
+        }
+
+        if (entries.size() >= MAX_ENTRIES)
+            entries.erase(entries.begin());
 
-        auto bounds = juce::Rectangle<int>(x, y, width, height).toFloat().reduced(10);
+        juce::Image image(juce::Image::ARGB,
+            juce::jmax(1, juce::roundToInt(static_cast<float>(width) * scale)),
+            juce::jmax(1, juce::roundToInt(static_cast<float>(height) * scale)), true);
+        {
+            juce::Graphics g(image);
+            g.addTransform(juce::AffineTransform::scale(scale));
+            drawBody(g, juce::Rectangle<int>(0, 0, width, height).toFloat().reduced(10));
+        }
+
+        entries.push_back({ width, height, scale, image });
+        return entries.back().image;
+    }
+
+    // The static part of the knob; also the uncached drawing path
+    static void drawBody(juce::Graphics& g, juce::Rectangle<float> bounds)
+    {
         auto radius = juce::jmin(bounds.getWidth(), bounds.getHeight()) / 2.0f;
-        auto toAngle = rotaryStartAngle + sliderPos * (rotaryEndAngle - rotaryStartAngle);
 
         // 1. Draw Knob Shadow
         g.setColour(juce::Colours::black.withAlpha(0.5f));
@@ -37,18 +60,76 @@ public:
         g.setGradientFill(capGrad);
         g.fillEllipse(capBounds);
 
-        // 4. Draw Silver Indicator Line
-        juce::Path p;
-        auto pointerThickness = 3.5f;
-        p.addRectangle(-pointerThickness * 0.5f, -radius, pointerThickness, radius * 0.5f);
-
-        g.setColour(juce::Colours::silver);
-        g.fillPath(p, juce::AffineTransform::rotation(toAngle).translated(bounds.getCentreX(), bounds.getCentreY()));
-
-        // 5. Draw Outer Chrome/Silver Ring
+        // 4. Draw Outer Chrome/Silver Ring (under the indicator, which is
+        // silver too, so the order makes no visible difference)
         g.setColour(juce::Colours::silver.withAlpha(0.4f));
         g.drawEllipse(bounds, 1.5f);
     }
+
+private:
+    // All knobs share one size in practice; the rest covers resizes and
+    // monitors with different scale factors
+    static constexpr size_t MAX_ENTRIES = 8;
+
+    struct Entry {
+        int width;
+        int height;
+        float scale;
+        juce::Image image;
+    };
+
+    std::vector<Entry> entries;
+};
+
+//==============================================================================
+// Custom Hardware Knob Look and Feel
+//==============================================================================
+class HardwareKnobLookAndFeel : public juce::LookAndFeel_V4
+{
+public:
+    void drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height,
+        float sliderPos, const float rotaryStartAngle, const float rotaryEndAngle,
+        juce::Slider& slider) override
+    {
+        juce::ignoreUnused(slider); // Suppress unused parameter warning
+
+        auto area = juce::Rectangle<int>(x, y, width, height).toFloat();
+        auto bounds = area.reduced(10);
+        auto radius = juce::jmin(bounds.getWidth(), bounds.getHeight()) / 2.0f;
+        auto toAngle = rotaryStartAngle + sliderPos * (rotaryEndAngle - rotaryStartAngle);
+
+        // Static body: one image blit at the context's physical pixel scale
+        if (bodyCaching)
+        {
+            const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+            g.drawImage(bodyCache->get(width, height, scale), area);
+        }
+        else
+        {
+            KnobBodyCache::drawBody(g, bounds);
+        }
+
+        // Silver Indicator Line, the only per-value drawing
+        if (radius != indicatorRadius)
+        {
+            auto pointerThickness = 3.5f;
+            indicator.clear();
+            indicator.addRectangle(-pointerThickness * 0.5f, -radius, pointerThickness, radius * 0.5f);
+            indicatorRadius = radius;
+        }
+
+        g.setColour(juce::Colours::silver);
+        g.fillPath(indicator, juce::AffineTransform::rotation(toAngle).translated(bounds.getCentreX(), bounds.getCentreY()));
+    }
+
+    // For repaint-cost comparisons; caching is on by default
+    void setBodyCaching(bool shouldCache) { bodyCaching = shouldCache; }
+
+private:
+    juce::SharedResourcePointer<KnobBodyCache> bodyCache;
+    juce::Path indicator;
+    float indicatorRadius = -1.0f;
+    bool bodyCaching = true;
 };
 
 //==============================================================================
@@ -60,6 +141,7 @@ public:
     SmallLcdDisplay()
     {
         setSize(100, 40);
+        setOpaque(true);
     }
 
     void paint(juce::Graphics& g) override
@@ -80,28 +162,31 @@ public:
 
         g.setFont(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(),
             14.0f, juce::Font::plain));
-        g.drawText(valueText, 2, 20, getWidth() - 4, 16,
+        g.drawText(valueText.c_str(), 2, 20, getWidth() - 4, 16,
             juce::Justification::centred, false);
     }
 
     void setLabel(const juce::String& text)
     {
-        label = text;
-        repaint();
+        if (label != text)
+        {
+            label = text;
+            repaint(2, 2, getWidth() - 4, 16);
+        }
     }
 
-    void setValue(const juce::String& text)
+    void setValue(const DisplayText& text)
     {
         if (valueText != text)
         {
             valueText = text;
-            repaint();
+            repaint(2, 20, getWidth() - 4, 16);
         }
     }
 
 private:
     juce::String label;
-    juce::String valueText;
+    DisplayText valueText;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SmallLcdDisplay)
 };
@@ -115,6 +200,7 @@ public:
     MainLcdDisplay()
     {
         setSize(500, 80);
+        setOpaque(true);
 
         lcdOnButton.setButtonText("LCD");
         lcdOnButton.setToggleState(true, juce::dontSendNotification);
@@ -174,7 +260,7 @@ public:
         {
             lines[line] = text;
             if (lcdEnabled)
-                repaint();
+                repaint(5, 2 + line * 18, getWidth() - 60, 18);
         }
     }
 
@@ -188,6 +274,237 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainLcdDisplay)
 };
 
+//==============================================================================
+// Scrolling spectrogram of the wet signal (LCD style: darker = louder)
+//
+// update() runs on the editor timer: it drains the processor's analyzer ring
+// into a sliding history, runs one windowed FFT, scrolls the image left by a
+// column and writes the new column. All buffers are allocated up front or on
+// resize; a frame touches only the new column's pixels.
+//==============================================================================
+class SpectrogramView final : public juce::Component
+{
+public:
+    SpectrogramView()
+        : fft(FFT_ORDER),
+        window(static_cast<size_t>(FFT_SIZE), juce::dsp::WindowingFunction<float>::hann, false)
+    {
+        setOpaque(true);
+
+        for (size_t i = 0; i < palette.size(); ++i)
+            palette[i] = background.interpolatedWith(ink, static_cast<float>(i) / static_cast<float>(palette.size() - 1));
+    }
+
+    void update(AnalyzerRing& ring, double sampleRate)
+    {
+        int received = 0;
+        int count = 0;
+        while ((count = ring.read(readBuffer.data(), static_cast<int>(readBuffer.size()))) > 0)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                history[static_cast<size_t>(historyPos)] = readBuffer[static_cast<size_t>(i)];
+                historyPos = (historyPos + 1) & (FFT_SIZE - 1);
+            }
+            received += count;
+        }
+
+        // Hold the picture while the host is stopped
+        if (received == 0 || !image.isValid() || sampleRate <= 0.0)
+            return;
+
+        if (sampleRate != mappedSampleRate)
+            mapRows(sampleRate);
+
+        for (int i = 0; i < FFT_SIZE; ++i)
+            fftData[static_cast<size_t>(i)] = history[static_cast<size_t>((historyPos + i) & (FFT_SIZE - 1))];
+
+        window.multiplyWithWindowingTable(fftData.data(), static_cast<size_t>(FFT_SIZE));
+        fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+        const int width = image.getWidth();
+        const int height = image.getHeight();
+        if (width > 1)
+            image.moveImageSection(0, 0, 1, 0, width - 1, height);
+
+        juce::Image::BitmapData column(image, width - 1, 0, 1, height, juce::Image::BitmapData::writeOnly);
+        for (int y = 0; y < height; ++y)
+        {
+            float magnitude = 0.0f;
+            for (int bin = rowFirstBin[static_cast<size_t>(y)]; bin <= rowLastBin[static_cast<size_t>(y)]; ++bin)
+                magnitude = juce::jmax(magnitude, fftData[static_cast<size_t>(bin)]);
+
+            const float db = juce::Decibels::gainToDecibels(magnitude * MAGNITUDE_SCALE, FLOOR_DB);
+            const int index = juce::jlimit(0, static_cast<int>(palette.size()) - 1,
+                static_cast<int>((db - FLOOR_DB) * static_cast<float>(palette.size() - 1) / -FLOOR_DB));
+            column.setPixelColour(0, y, palette[static_cast<size_t>(index)]);
+        }
+
+        repaint();
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        g.drawImageAt(image, 0, 0);
+        g.setColour(juce::Colour(60, 70, 50));
+        g.drawRect(getLocalBounds(), 2);
+    }
+
+    void resized() override
+    {
+        image = juce::Image(juce::Image::RGB, juce::jmax(1, getWidth()), juce::jmax(1, getHeight()), false);
+        image.clear(image.getBounds(), background);
+
+        rowFirstBin.assign(static_cast<size_t>(image.getHeight()), 1);
+        rowLastBin.assign(static_cast<size_t>(image.getHeight()), 1);
+        mappedSampleRate = 0.0;
+    }
+
+private:
+    static constexpr int FFT_ORDER = 11;
+    static constexpr int FFT_SIZE = 1 << FFT_ORDER;
+    static constexpr float FLOOR_DB = -96.0f;
+    static constexpr float MIN_FREQUENCY = 30.0f;
+    static constexpr float MAGNITUDE_SCALE = 4.0f / static_cast<float>(FFT_SIZE);   // Hann, full-scale sine = 0 dB
+
+    juce::dsp::FFT fft;
+    juce::dsp::WindowingFunction<float> window;
+
+    std::array<float, 1024> readBuffer{};
+    std::array<float, FFT_SIZE> history{};
+    std::array<float, 2 * FFT_SIZE> fftData{};
+    int historyPos = 0;
+
+    // Log-frequency rows, top = highest; each row takes the loudest of its bins
+    std::vector<int> rowFirstBin;
+    std::vector<int> rowLastBin;
+    double mappedSampleRate = 0.0;
+
+    juce::Image image;
+    const juce::Colour background{ 120, 140, 100 };
+    const juce::Colour ink{ 20, 25, 15 };
+    std::array<juce::Colour, 256> palette;
+
+    void mapRows(double sampleRate)
+    {
+        const int height = image.getHeight();
+        const float nyquist = static_cast<float>(sampleRate) * 0.5f;
+        const float maxFrequency = juce::jmin(20000.0f, nyquist);
+        const float binsPerHz = static_cast<float>(FFT_SIZE) / static_cast<float>(sampleRate);
+
+        auto rowFrequency = [&](float row)
+            {
+                const float position = height > 1 ? 1.0f - row / static_cast<float>(height - 1) : 0.0f;
+                return MIN_FREQUENCY * std::pow(maxFrequency / MIN_FREQUENCY, position);
+            };
+
+        for (int y = 0; y < height; ++y)
+        {
+            const int last = juce::jlimit(1, FFT_SIZE / 2 - 1, juce::roundToInt(rowFrequency(static_cast<float>(y) - 0.5f) * binsPerHz));
+            const int first = juce::jlimit(1, last, juce::roundToInt(rowFrequency(static_cast<float>(y) + 0.5f) * binsPerHz));
+            rowFirstBin[static_cast<size_t>(y)] = first;
+            rowLastBin[static_cast<size_t>(y)] = last;
+        }
+
+        mappedSampleRate = sampleRate;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrogramView)
+};
+
+//==============================================================================
+// Measured decay of the current settings: broadband Schroeder curve (dark)
+// over the octave-band curves (light), 0 to -60 dB across the render length
+//==============================================================================
+class DecayView final : public juce::Component
+{
+public:
+    DecayView()
+    {
+        setOpaque(true);
+    }
+
+    void setAnalysis(DecayAnalysis newAnalysis)
+    {
+        analysis = std::move(newAnalysis);
+        summary = juce::String::formatted("RT60 %.2fs  EDT %.2fs", analysis.rt60, analysis.edt);
+        rebuildPaths();
+        repaint();
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        g.fillAll(background);
+
+        g.setColour(ink.withAlpha(0.3f));
+        for (const auto& path : bandPaths)
+            g.strokePath(path, juce::PathStrokeType(1.0f));
+
+        g.setColour(ink);
+        g.strokePath(curvePath, juce::PathStrokeType(1.5f));
+
+        g.setFont(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(), 12.0f, juce::Font::bold));
+        g.drawText(summary, 6, 4, getWidth() - 12, 14, juce::Justification::right, false);
+
+        g.setColour(juce::Colour(60, 70, 50));
+        g.drawRect(getLocalBounds(), 2);
+    }
+
+    void resized() override
+    {
+        rebuildPaths();
+    }
+
+private:
+    static constexpr float RANGE_DB = 60.0f;
+
+    DecayAnalysis analysis;
+    juce::String summary{ "RT60 --" };
+    juce::Path curvePath;
+    std::array<juce::Path, DecayAnalysis::NUM_BANDS> bandPaths;
+
+    const juce::Colour background{ 120, 140, 100 };
+    const juce::Colour ink{ 20, 25, 15 };
+
+    void rebuildPaths()
+    {
+        curvePath = makePath(analysis.curve);
+        for (size_t band = 0; band < bandPaths.size(); ++band)
+            bandPaths[band] = makePath(analysis.bandCurves[band]);
+    }
+
+    // All curves share the broadband curve's time axis; each path stops once
+    // it falls below the plot
+    juce::Path makePath(const std::vector<float>& curveDb) const
+    {
+        juce::Path path;
+        if (curveDb.size() < 2 || analysis.curve.size() < 2)
+            return path;
+
+        const auto area = getLocalBounds().toFloat().reduced(4.0f);
+        const float xStep = area.getWidth() / static_cast<float>(analysis.curve.size() - 1);
+
+        for (size_t i = 0; i < curveDb.size(); ++i)
+        {
+            const float depth = juce::jlimit(0.0f, 1.0f, -curveDb[i] / RANGE_DB);
+            const juce::Point<float> point(area.getX() + static_cast<float>(i) * xStep,
+                area.getY() + depth * area.getHeight());
+
+            if (i == 0)
+                path.startNewSubPath(point);
+            else
+                path.lineTo(point);
+
+            if (depth >= 1.0f)
+                break;
+        }
+
+        return path;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DecayView)
+};
+
 //==============================================================================
 // Parameter Knob with Small LCD - Hardware Style
 //==============================================================================
@@ -217,7 +534,8 @@ public:
         addAndMakeVisible(lcd);
 
         lcd.setLabel("PARAM");
-        lcd.setValue("0.50");
+        configureLcdFormat();
+        updateLcdValue();
 
         setVisible(true);
         knob.setVisible(true);
@@ -232,6 +550,7 @@ public:
     void setParameter(const EffectParameter& param)
     {
         parameterInfo = param;
+        configureLcdFormat();
         knob.setRange(param.minValue, param.maxValue, param.stepSize);
         knob.setValue(param.defaultValue, juce::dontSendNotification);
         lcd.setLabel(param.label);
@@ -259,9 +578,6 @@ public:
         knob.setBounds(knobArea.withSizeKeepingCentre(knobSize, knobSize));
 
         lcd.setBounds(area.withSizeKeepingCentre(90, 40));
-
-        knob.repaint();
-        lcd.repaint();
     }
 
     void updateDisplay()
@@ -274,32 +590,31 @@ private:
     SmallLcdDisplay lcd;
     HardwareKnobLookAndFeel hardwareLF;
     EffectParameter parameterInfo{ "", "", "", "", 0.0f, 1.0f, 0.5f };
+    CachedDisplayValue lcdValue;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> attachment;
 
+    // Formatting and repaint only happen when the shown digits change
     void updateLcdValue()
     {
-        const float value = static_cast<float>(knob.getValue());
-        juce::String display;
+        if (lcdValue.update(static_cast<float>(knob.getValue())))
+            lcd.setValue(lcdValue.getText());
+    }
 
-        if (parameterInfo.unit.isNotEmpty())
-        {
-            if (parameterInfo.unit == "ms")
-                display = juce::String(value, 0) + "ms";
-            else if (parameterInfo.unit == "%")
-                display = juce::String(value, 0) + "%";
-            else if (parameterInfo.unit == "s")
-                display = juce::String(value, 1) + "s";
-            else if (parameterInfo.unit == "x")
-                display = juce::String(value, 2) + "x";
-            else
-                display = juce::String(value, 1) + parameterInfo.unit;
-        }
+    // Same precision and suffix per unit as the LCDs always used
+    void configureLcdFormat()
+    {
+        const auto& unit = parameterInfo.unit;
+
+        if (unit.isEmpty())
+            lcdValue.setFormat(2, "");
+        else if (unit == "ms" || unit == "%")
+            lcdValue.setFormat(0, unit.toRawUTF8());
+        else if (unit == "s")
+            lcdValue.setFormat(1, "s");
+        else if (unit == "x")
+            lcdValue.setFormat(2, "x");
         else
-        {
-            display = juce::String(value, 2);
-        }
-
-        lcd.setValue(display);
+            lcdValue.setFormat(1, unit.toRawUTF8());
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterKnobWithLcd)
@@ -321,16 +636,55 @@ public:
 private:
     void timerCallback() override;
     void updateMainLcd();
-    void debugLayout();
+#if DSP256_STAGE_PROFILING
+    void updateStageTimings();
+#endif
+    void updateDecayAnalysis();
+    void paintChassis(juce::Graphics& g);
+    void showKnobPage(int page);
 
     PluginProcessor& audioProcessor;
     MainLcdDisplay mainLcd;
-
-    std::array<std::unique_ptr<ParameterKnobWithLcd>, 7> parameterKnobs;
-    std::array<juce::Label, 7> knobLabels;
+    SpectrogramView spectrogram;
+    DecayView decayView;
+
+    // Measured decay: re-rendered in the background whenever a parameter or
+    // the sample rate changes (the renderer debounces knob drags)
+    ImpulseRenderer impulseRenderer;
+    std::array<float, 32> renderedParameters{};
+    double renderedSampleRate = 0.0;
+
+    // One knob per parameter, KNOBS_PER_PAGE to a page (hall: main
+    // controls, then ducker and width)
+    static constexpr int KNOBS_PER_PAGE = 7;
+    std::array<std::unique_ptr<ParameterKnobWithLcd>, 21> parameterKnobs;
+    std::array<juce::Label, 21> knobLabels;
+    int numParameterKnobs = 0;
+    int knobPage = 0;
 
     juce::ComboBox presetSelector;
     juce::Label presetLabel;
+    juce::TextButton pageButton;
+
+    // Cached static chassis, cleared on resize
+    juce::Image backgroundImage;
+    float backgroundScale = 1.0f;
+
+    // Meter line state: values as last shown, in tenths of a dB, so the
+    // LCD text is only rebuilt when a displayed digit changes
+    int shownPeakTenths = -1;
+    int shownRmsTenths = -1;
+    int shownTailTenths = -1;
+    uint32_t shownOverflow = 0;
+    uint32_t overflowTotal = 0;
+    bool meterShown = false;
+
+#if DSP256_STAGE_PROFILING
+    // Stage timing lines replace the description and preset lines, every
+    // STAGE_TIMING_TICKS timer ticks
+    static constexpr int STAGE_TIMING_TICKS = 15;
+    int stageTimingCountdown = 0;
+#endif
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginEditor)
 };
\ No newline at end of file
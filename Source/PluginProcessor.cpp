@@ -7,20 +7,101 @@
 static std::unique_ptr<DelayMemoryPool> globalDelayPool = nullptr;
 static bool globalDelayPoolInitialized = false;
 
+//==============================================================================
+// Output layouts the processor can route: stereo, the surround beds and
+// first-order ambisonics (AmbiX)
+static bool isKnownOutputSet(const juce::AudioChannelSet& set)
+{
+    return set == juce::AudioChannelSet::stereo()
+        || set == juce::AudioChannelSet::quadraphonic()
+        || set == juce::AudioChannelSet::create5point1()
+        || set == juce::AudioChannelSet::create7point1()
+        || set == juce::AudioChannelSet::ambisonic(1);
+}
+
+static OutputLayout outputLayoutFor(const juce::AudioChannelSet& set)
+{
+    OutputLayout layout;
+    layout.numChannels = set.size();
+    layout.lfeChannel = set.getChannelIndexForType(juce::AudioChannelSet::LFE);
+    layout.ambisonic = set.getAmbisonicOrder() == 1;
+    return layout;
+}
+
+// Input straight through: extra outputs cleared, mono input on both sides
+static void passThroughDry(juce::AudioBuffer<float>& buffer, int mainInputChannels, int totalNumOutputChannels)
+{
+    const int numSamples = buffer.getNumSamples();
+    for (int i = mainInputChannels; i < totalNumOutputChannels; ++i) {
+        buffer.clear(i, 0, numSamples);
+    }
+    if (mainInputChannels < 2 && buffer.getNumChannels() > 1) {
+        buffer.copyFrom(1, 0, buffer, 0, 0, numSamples);
+    }
+}
+
+// Peak, RMS and full-scale overflow over every output channel of a block
+static MeterFrame measureOutput(float* const* channels, int numChannels, int numSamples)
+{
+    MeterFrame frame;
+    float sum = 0.0f;
+    for (int ch = 0; ch < numChannels; ++ch) {
+        const float* samples = channels[ch];
+        for (int i = 0; i < numSamples; ++i) {
+            const float magnitude = std::abs(samples[i]);
+            frame.peak = juce::jmax(frame.peak, magnitude);
+            sum += samples[i] * samples[i];
+            frame.overflowCount += magnitude >= 1.0f ? 1u : 0u;
+        }
+    }
+
+    if (numChannels > 0 && numSamples > 0)
+        frame.rms = std::sqrt(sum / static_cast<float>(numChannels * numSamples));
+    return frame;
+}
+
 //==============================================================================
 PluginProcessor::PluginProcessor()
     : AudioProcessor(BusesProperties()
         .withInput("Input", juce::AudioChannelSet::stereo(), true)
-        .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
-    parameters(*this, nullptr, juce::Identifier("DSP256"), createParameterLayout())
+        .withOutput("Output", juce::AudioChannelSet::stereo(), true)
+        .withInput("Sidechain", juce::AudioChannelSet::stereo(), false)),
+    parameters(*this, nullptr, juce::Identifier("DSP256"), createParameterLayout()),
+    tracer(Tracer::getInstance())
 {
     dspCore = std::make_unique<FixedPointEngine>();
     effectModule = std::make_unique<ReverbHall>();
+    effectModule->setAnalyzerTap(&analyzerRing);
+
+    parameterDefinitions = effectModule->getParameterDefinitions();
+    for (int i = 0; i < effectModule->getParameterCount(); ++i) {
+        rawParameters.push_back(parameters.getRawParameterValue("param" + juce::String(i)));
+        hostParameters.push_back(parameters.getParameter("param" + juce::String(i)));
+        appliedParameters.push_back(rawParameters.back()->load());
+    }
+    applyAllParameters();
     modulationCounter = 0;
+
+    // Room for the key before prepareToPlay() says how big blocks get
+    sidechainBuffer.setSize(2, SIDECHAIN_SPAN);
+
+    const auto traceDirectory = juce::SystemStats::getEnvironmentVariable("DSP256_TRACE", {});
+    if (traceDirectory.isNotEmpty()) {
+        tracer.start(traceDirectory.toStdString());
+    }
+    traceInstance = tracer.attach();
+    referenceKernels = juce::SystemStats::getEnvironmentVariable("DSP256_KERNELS", {}) == "reference";
+    traceModuleName = tracer.internName(effectModule->getModuleName().toStdString());
+
+    // setLatencySamples() notifies the host, so it stays off the audio thread
+    startTimerHz(10);
 }
 
 PluginProcessor::~PluginProcessor()
 {
+    stopTimer();
+    tracer.detach();
+
     if (effectModule) {
         effectModule->releaseResources();
     }
@@ -78,8 +159,19 @@ void PluginProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
     if (effectModule) {
         const juce::ScopedLock sl(processingLock);
         effectModule->prepare(sampleRate, samplesPerBlock);
+        effectModule->setOutputLayout(outputLayoutFor(getChannelLayoutOfBus(false, 0)));
+        if (referenceKernels && getTotalNumOutputChannels() > 2) {
+            juce::Logger::writeToLog("DSP256_KERNELS=reference covers stereo only; this "
+                + juce::String(getTotalNumOutputChannels()) + "-channel bus runs the optimized kernels");
+        }
+        moduleLatency.store(effectModule->getLatencySamples());
+        setLatencySamples(moduleLatency.load());
     }
 
+    // Sidechain key is copied out of the host buffer before outputs overwrite
+    // it; longer host blocks than this go through in spans of this length
+    sidechainBuffer.setSize(2, juce::jmax(samplesPerBlock, SIDECHAIN_SPAN));
+
     modulationCounter = 0;
 }
 
@@ -91,9 +183,36 @@ void PluginProcessor::releaseResources()
     }
 }
 
+void PluginProcessor::timerCallback()
+{
+    const int latency = moduleLatency.load(std::memory_order_relaxed);
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+}
+
 bool PluginProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
 {
-    return layouts.getMainOutputChannelSet() == juce::AudioChannelSet::stereo();
+    const auto& output = layouts.getMainOutputChannelSet();
+    const auto& input = layouts.getMainInputChannelSet();
+
+    if (!isKnownOutputSet(output))
+        return false;
+
+    // Mono/stereo sends, or an insert on a bed of the same layout. The FOA
+    // output encodes its own dry signal, so it takes mono/stereo only.
+    const bool monoOrStereoIn = input == juce::AudioChannelSet::mono() || input == juce::AudioChannelSet::stereo();
+    if (!monoOrStereoIn && (input != output || output.getAmbisonicOrder() == 1))
+        return false;
+
+    // Optional sidechain key: disabled, mono or stereo
+    if (layouts.inputBuses.size() > 1) {
+        const auto& sidechain = layouts.getChannelSet(true, 1);
+        if (!sidechain.isDisabled() && sidechain != juce::AudioChannelSet::mono()
+            && sidechain != juce::AudioChannelSet::stereo())
+            return false;
+    }
+
+    return effectModule == nullptr || effectModule->supportsOutputLayout(outputLayoutFor(output));
 }
 
 //==============================================================================
@@ -102,64 +221,173 @@ void PluginProcessor::processBlock(juce::AudioBuffer<float>& buffer,
 {
     juce::ignoreUnused(midiMessages);
     juce::ScopedNoDenormals noDenormals;
+    const Tracer::ScopedSpan callbackSpan(tracer, Tracer::Category::Callback, "processBlock", traceInstance, buffer.getNumSamples());
 
     if (!dspCore || !effectModule) {
         return;
     }
 
-    const int totalNumInputChannels = getTotalNumInputChannels();
+    const int mainInputChannels = getMainBusNumInputChannels();
     const int totalNumOutputChannels = getTotalNumOutputChannels();
     const int numSamples = buffer.getNumSamples();
 
-    for (int i = totalNumInputChannels; i < totalNumOutputChannels; ++i) {
-        buffer.clear(i, 0, numSamples);
+    // The sidechain shares buffer channels with the wider outputs, so each
+    // span of the key is copied out before that span of the outputs is written
+    const bool hasSidechain = getBusCount(true) > 1 && getBus(true, 1)->isEnabled()
+        && getBus(true, 1)->getNumberOfChannels() > 0;
+
+    // Preset and state changes hold the lock only while the module takes the
+    // new values. Rather than wait for them here, let this one block through dry.
+    const juce::ScopedTryLock sl(processingLock);
+    if (!sl.isLocked()) {
+        passThroughDry(buffer, mainInputChannels, totalNumOutputChannels);
+        return;
     }
 
-    const juce::ScopedLock sl(processingLock);
+    // Update effect parameters from APVTS, in units, normalized for the
+    // module. Each call recomputes the module's coefficients, so only values
+    // that changed are passed on. While loadPreset() is still moving the
+    // APVTS to a preset the module already holds, the old values would undo it.
+    if (!hostSyncPending.load(std::memory_order_acquire)) {
+        int changed = 0;
+        const auto parameterStart = tracer.isEnabled() ? Tracer::now() : 0;
+        for (int i = 0; i < static_cast<int>(rawParameters.size()); ++i) {
+            const float value = rawParameters[static_cast<size_t>(i)]->load();
+            if (value != appliedParameters[static_cast<size_t>(i)]) {
+                appliedParameters[static_cast<size_t>(i)] = value;
+                effectModule->setParameter(i, parameterDefinitions[static_cast<size_t>(i)].toNormalized(value));
+                ++changed;
+            }
+        }
+        if (parameterStart != 0) {
+            tracer.recordSpan(Tracer::Category::Parameter, "parameters", traceInstance, parameterStart, changed);
+        }
+    }
 
-    // Update effect parameters from APVTS
-    for (int i = 0; i < effectModule->getParameterCount(); ++i) {
-        float value = parameters.getRawParameterValue("param" + juce::String(i))->load();
-        effectModule->setParameter(i, value);
+    // Offline bounces: modules may do background work in line, so renders repeat
+    if (isNonRealtime() != moduleNonRealtime) {
+        moduleNonRealtime = isNonRealtime();
+        effectModule->setNonRealtime(moduleNonRealtime);
     }
 
+    // Some modules (e.g., oversampling) change latency with their parameters;
+    // timerCallback() passes it on to the host from the message thread
+    moduleLatency.store(effectModule->getLatencySamples(), std::memory_order_relaxed);
+
     if (globalDelayPool && !globalDelayPoolInitialized) {
         globalDelayPool->prepare(getSampleRate());
         globalDelayPoolInitialized = true;
     }
 
-    // Process audio samples
-    for (int sample = 0; sample < numSamples; ++sample) {
-        float leftFloat = buffer.getSample(0, sample);
-        float rightFloat = (totalNumInputChannels > 1) ?
-            buffer.getSample(1, sample) : leftFloat;
+    // Host transport for tempo-synced modules
+    if (auto* playHead = getPlayHead()) {
+        if (auto position = playHead->getPosition()) {
+            TransportInfo transport;
+            if (auto bpm = position->getBpm()) {
+                transport.bpm = *bpm;
+                transport.hasTempo = true;
+            }
+            if (auto ppq = position->getPpqPosition()) {
+                transport.ppqPosition = *ppq;
+            }
+            transport.isPlaying = position->getIsPlaying();
+            effectModule->setTransportInfo(transport);
+        }
+    }
 
-        FixedPointSample left = dspCore->floatToQ12(leftFloat);
-        FixedPointSample right = dspCore->floatToQ12(rightFloat);
+    jassert(buffer.getNumChannels() > 1);
+    if (buffer.getNumChannels() < 2) {
+        return;
+    }
 
-        if (globalDelayPool) {
-            effectModule->process(left, right, *globalDelayPool, *dspCore);
+    // The pool is allocated by prepareToPlay(); a block before that goes through dry
+    DelayMemoryPool* pool = globalDelayPool.get();
+    if (pool == nullptr) {
+        passThroughDry(buffer, mainInputChannels, totalNumOutputChannels);
+        return;
+    }
+
+    const int numChannels = juce::jmin(buffer.getNumChannels(), OutputLayout::MAX_CHANNELS);
+    float* channels[OutputLayout::MAX_CHANNELS] = {};
+    for (int ch = 0; ch < numChannels; ++ch) {
+        channels[ch] = buffer.getWritePointer(ch);
+    }
+
+    // Process in sub-blocks that end on the modulation update boundary, inside
+    // spans no longer than the preallocated key buffer
+    int sample = 0;
+    while (sample < numSamples) {
+        const int spanStart = sample;
+        const int spanEnd = hasSidechain ? sample + juce::jmin(numSamples - sample, sidechainBuffer.getNumSamples())
+                                         : numSamples;
+        const int spanLength = spanEnd - spanStart;
+
+        if (hasSidechain) {
+            auto sidechain = getBusBuffer(buffer, true, 1);
+            sidechainBuffer.copyFrom(0, 0, sidechain, 0, spanStart, spanLength);
+            sidechainBuffer.copyFrom(1, 0, sidechain, juce::jmin(1, sidechain.getNumChannels() - 1), spanStart, spanLength);
         }
-        else {
-            static DelayMemoryPool tempPool(1024);
-            static bool tempPoolPrepared = false;
-            if (!tempPoolPrepared) {
-                tempPool.prepare(getSampleRate());
-                tempPoolPrepared = true;
-            }
-            effectModule->process(left, right, tempPool, *dspCore);
+
+        for (int i = mainInputChannels; i < totalNumOutputChannels; ++i) {
+            buffer.clear(i, spanStart, spanLength);
         }
 
-        buffer.setSample(0, sample, dspCore->Q12ToFloat(left));
-        if (totalNumOutputChannels > 1) {
-            buffer.setSample(1, sample, dspCore->Q12ToFloat(right));
+        // Mono input feeds both sides of the output
+        if (mainInputChannels < 2) {
+            buffer.copyFrom(1, spanStart, buffer, 0, spanStart, spanLength);
         }
 
-        if (++modulationCounter >= MODULATION_UPDATE_RATE) {
-            effectModule->updateModulation(modulationCounter);
-            modulationCounter = 0;
+        while (sample < spanEnd) {
+            const int chunk = juce::jmin(spanEnd - sample, MODULATION_UPDATE_RATE - modulationCounter);
+
+            // Without a key bus the module keys from the dry input
+            if (hasSidechain) {
+                effectModule->setSidechainInput(sidechainBuffer.getReadPointer(0, sample - spanStart),
+                    sidechainBuffer.getReadPointer(1, sample - spanStart));
+            }
+            else {
+                effectModule->setSidechainInput(nullptr, nullptr);
+            }
+
+            const auto moduleStart = tracer.isEnabled() ? Tracer::now() : 0;
+            if (numChannels > 2) {
+                float* chunkChannels[OutputLayout::MAX_CHANNELS] = {};
+                for (int ch = 0; ch < numChannels; ++ch) {
+                    chunkChannels[ch] = channels[ch] + sample;
+                }
+                effectModule->processBlockMultichannel(chunkChannels, numChannels, chunk, *pool, *dspCore);
+            }
+            else if (referenceKernels) {
+                effectModule->processBlockReference(channels[0] + sample, channels[1] + sample, chunk, *pool, *dspCore);
+            }
+            else {
+                effectModule->processBlock(channels[0] + sample, channels[1] + sample, chunk, *pool, *dspCore);
+            }
+            if (moduleStart != 0) {
+                tracer.recordSpan(Tracer::Category::Module, traceModuleName, traceInstance, moduleStart, chunk);
+            }
+
+            sample += chunk;
+            modulationCounter += chunk;
+            if (modulationCounter >= MODULATION_UPDATE_RATE) {
+                effectModule->updateModulation(modulationCounter);
+                modulationCounter = 0;
+            }
         }
     }
+
+    // Publish meters; if the editor is closed the ring fills and frames drop
+    MeterFrame frame = measureOutput(channels, numChannels, numSamples);
+    frame.tailLevel = effectModule->getTailLevel();
+    meterRing.push(frame);
+
+    // A callback longer than its buffer period is what the host reports as
+    // an xrun: mark it and have the tracer write out the events around it
+    if (callbackSpan.getStartTime() != 0
+        && static_cast<double>(Tracer::now() - callbackSpan.getStartTime()) > numSamples * 1.0e9 / getSampleRate()) {
+        tracer.recordInstant(Tracer::Category::Callback, "overrun", traceInstance, numSamples);
+        tracer.requestDump();
+    }
 }
 
 //==============================================================================
@@ -169,32 +397,39 @@ void PluginProcessor::loadPreset(const EffectPreset& preset)
     if (!effectModule)
         return;
 
-    const juce::ScopedLock sl(processingLock);
-
-    // CRITICAL FIX: Use the effect module's own loadPreset method
-    effectModule->loadPreset(preset);
-
-    // Get parameter definitions to know the ranges
-    auto paramDefs = effectModule->getParameterDefinitions();
-
-    // Update APVTS parameters to match the preset (so GUI knobs move)
-    for (int i = 0; i < juce::jmin(effectModule->getParameterCount(),
+    const int count = juce::jmin(effectModule->getParameterCount(),
         (int)preset.parameterValues.size(),
-        (int)paramDefs.size()); ++i) {
+        (int)parameterDefinitions.size());
+    std::vector<float> hostValues(static_cast<size_t>(count));
 
-        // Get the actual value from the effect module (after preset was loaded)
-        float actualValue = effectModule->getParameter(i);
+    // The audio thread waits for nothing but this: the module takes the
+    // preset, and the cache is set to the values the APVTS is about to hold
+    {
+        const juce::ScopedLock sl(processingLock);
 
-        // Convert to APVTS normalized value
-        const auto& def = paramDefs[i];
-        float apvtsNormalized = (actualValue - def.minValue) / (def.maxValue - def.minValue);
+        // CRITICAL FIX: Use the effect module's own loadPreset method
+        effectModule->loadPreset(preset);
+
+        for (int i = 0; i < count; ++i) {
+            // The module's value (after the preset was loaded) is normalized;
+            // the APVTS parameter holds units on its own (possibly skewed) range
+            auto* param = hostParameters[static_cast<size_t>(i)];
+            const float actualValue = parameterDefinitions[static_cast<size_t>(i)].fromNormalized(effectModule->getParameter(i));
+            hostValues[static_cast<size_t>(i)] = param->convertTo0to1(actualValue);
 
-        // Update APVTS parameter
-        auto* param = parameters.getParameter("param" + juce::String(i));
-        if (param) {
-            param->setValueNotifyingHost(apvtsNormalized);
+            // The module already holds the preset's exact value; don't let the
+            // next block overwrite it with the round trip through the APVTS
+            appliedParameters[static_cast<size_t>(i)] = param->convertFrom0to1(hostValues[static_cast<size_t>(i)]);
         }
+        hostSyncPending.store(true, std::memory_order_release);
+    }
+
+    // Update APVTS parameters to match the preset (so GUI knobs move); hosts
+    // may do a lot of work in the notification, so it runs unlocked
+    for (int i = 0; i < count; ++i) {
+        hostParameters[static_cast<size_t>(i)]->setValueNotifyingHost(hostValues[static_cast<size_t>(i)]);
     }
+    hostSyncPending.store(false, std::memory_order_release);
 
     // Update GUI if it exists
     if (auto* editor = dynamic_cast<PluginEditor*>(getActiveEditor())) {
@@ -252,14 +487,22 @@ void PluginProcessor::setStateInformation(const void* data, int sizeInBytes)
 
         if (effectModule) {
             const juce::ScopedLock sl(processingLock);
-            for (int i = 0; i < effectModule->getParameterCount(); ++i) {
-                float value = parameters.getRawParameterValue("param" + juce::String(i))->load();
-                effectModule->setParameter(i, value);
-            }
+            applyAllParameters();
         }
     }
 }
 
+// processBlock() only passes on values that changed since the last block, so
+// construction and state restore push every value and resync the cache
+void PluginProcessor::applyAllParameters()
+{
+    for (int i = 0; i < static_cast<int>(rawParameters.size()); ++i) {
+        const float value = rawParameters[static_cast<size_t>(i)]->load();
+        appliedParameters[static_cast<size_t>(i)] = value;
+        effectModule->setParameter(i, parameterDefinitions[static_cast<size_t>(i)].toNormalized(value));
+    }
+}
+
 //==============================================================================
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 {
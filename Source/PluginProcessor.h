@@ -5,6 +5,8 @@
 #include "EffectModule.h"
 #include "FixedPointDSP.h"
 #include "DelayMemoryPool.h"
+#include "MeterRing.h"
+#include "Tracer.h"
 
 // For standalone build - include only the current effect
 #include "ReverbHall.h"
@@ -12,10 +14,18 @@
 // For multi-FX build (currently commented out):
 // #include "ReverbPlate.h"
 // #include "MonoDelay.h"
+// #include "RotarySpeaker.h"
+// #include "Distortion.h"
+// #include "FilterModule.h"
+// #include "Tremolo.h"
+// #include "ReverbGated.h"
+// #include "ReverbReverse.h"
+// #include "ReverbRoom.h"
 // ... etc
 
 //==============================================================================
-class PluginProcessor : public juce::AudioProcessor
+class PluginProcessor : public juce::AudioProcessor,
+                        private juce::Timer
 {
 public:
     PluginProcessor();
@@ -52,6 +62,18 @@ public:
     // Effect module access
     EffectModule* getEffectModule() const { return effectModule.get(); }
 
+    // The module's view of a parameter (normalized), from the APVTS atomics;
+    // safe on any thread, unlike reading the module itself
+    const std::vector<EffectParameter>& getParameterDefinitions() const { return parameterDefinitions; }
+    float getNormalizedParameter(int index) const
+    {
+        return parameterDefinitions[static_cast<size_t>(index)].toNormalized(rawParameters[static_cast<size_t>(index)]->load());
+    }
+
+    // Output meters, one frame per processed block (editor is the consumer)
+    MeterRing& getMeterRing() { return meterRing; }
+    AnalyzerRing& getAnalyzerRing() { return analyzerRing; }
+
     // Preset management
     void loadPreset(const EffectPreset& preset);
 
@@ -59,6 +81,20 @@ private:
     juce::AudioProcessorValueTreeState parameters;
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    // APVTS values in parameter order, looked up once (no String building
+    // on the audio thread)
+    std::vector<std::atomic<float>*> rawParameters;
+    std::vector<juce::RangedAudioParameter*> hostParameters;
+    std::vector<EffectParameter> parameterDefinitions;   // Units <-> the module's normalized values
+    std::vector<float> appliedParameters;     // Last values passed to the module
+    std::atomic<bool> hostSyncPending { false }; // loadPreset() is moving the APVTS to the module's values
+
+    // Tracing (Tracer.h, enabled by DSP256_TRACE); the module name is
+    // interned so events can outlive the module
+    Tracer& tracer;
+    uint32_t traceInstance = 0;
+    const char* traceModuleName = "";
+
     // DSP Core
     std::unique_ptr<DelayMemoryPool> delayPool;
     std::unique_ptr<FixedPointEngine> dspCore;
@@ -69,9 +105,18 @@ private:
     // Processing
     juce::CriticalSection processingLock;
     int modulationCounter = 0;
+    bool moduleNonRealtime = false;        // Last value passed to setNonRealtime()
+    bool referenceKernels = false;         // DSP256_KERNELS=reference: stereo only goes through processBlockReference()
+    juce::AudioBuffer<float> sidechainBuffer;
+    std::atomic<int> moduleLatency { 0 };  // Published by processBlock(), reported to the host by timerCallback()
+    MeterRing meterRing;
+    AnalyzerRing analyzerRing;
     static constexpr int MODULATION_UPDATE_RATE = 64; // Update every 64 samples
+    static constexpr int SIDECHAIN_SPAN = 4096;       // Minimum key buffer length
 
     void updateParametersFromModule();
+    void applyAllParameters();     // Caller holds processingLock (or owns the module)
+    void timerCallback() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginProcessor)
 };
\ No newline at end of file
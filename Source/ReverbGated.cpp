@@ -0,0 +1,205 @@
+// ReverbGated.cpp - Gated Reverb Implementation
+#include "ReverbGated.h"
+#include <cmath>
+
+//==============================================================================
+ReverbGated::ReverbGated()
+{
+    sampleRate = 44100.0;
+
+    // Dense, bright hall with no pre-delay; only decay/size/damping are exposed
+    hall.setParameter(0, 0.0f);    // Pre-delay
+    hall.setParameter(2, 0.9f);    // Diffusion
+    hall.setParameter(4, 0.9f);    // Early reflections
+    hall.setParameter(6, 1.0f);    // Fully wet
+
+    updateParameters();
+}
+
+//==============================================================================
+std::vector<EffectParameter> ReverbGated::getParameterDefinitions() const
+{
+    return {
+        EffectParameter("threshold", "Gate Threshold", "THRESH", "dB", -60.0f, 0.0f, -24.0f, 0.1f, false),
+        EffectParameter("hold", "Gate Hold", "HOLD", "ms", 10.0f, 1000.0f, 300.0f, 1.0f, true),
+        EffectParameter("release", "Gate Release", "REL", "ms", 5.0f, 500.0f, 20.0f, 0.1f, true),
+        EffectParameter("decay", "Decay Time", "DECAY", "s", 0.1f, 10.0f, 1.6f, 0.01f, true),
+        EffectParameter("size", "Room Size", "SIZE", "x", 0.5f, 2.0f, 1.4f, 0.01f, false),
+        EffectParameter("damping", "HF Damping", "DAMP", "%", 0.0f, 100.0f, 60.0f, 0.1f, false),
+        EffectParameter("mix", "Dry/Wet Mix", "MIX", "%", 0.0f, 100.0f, 50.0f, 0.1f, false)
+    };
+}
+
+//==============================================================================
+std::vector<EffectPreset> ReverbGated::getFactoryPresets() const
+{
+    return {
+        EffectPreset("Gated Room", "80s drum reverb", {0.6f, 0.5f, 0.3f, 0.6f, 0.6f, 0.6f, 0.5f}),
+        EffectPreset("Big Snare", "Long hold, hard cut", {0.55f, 0.7f, 0.1f, 0.8f, 0.9f, 0.5f, 0.55f}),
+        EffectPreset("Tight Kick", "Short hold, quick release", {0.65f, 0.3f, 0.2f, 0.4f, 0.4f, 0.7f, 0.35f}),
+        EffectPreset("Soft Gate", "Slow release, natural fade", {0.5f, 0.5f, 0.8f, 0.6f, 0.7f, 0.5f, 0.45f})
+    };
+}
+
+void ReverbGated::loadPreset(const EffectPreset& preset)
+{
+    if (preset.parameterValues.size() >= 7) {
+        threshold = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[0]);
+        hold = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[1]);
+        release = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[2]);
+        decayTime = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[3]);
+        size = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[4]);
+        damping = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[5]);
+        mix = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[6]);
+        updateParameters();
+    }
+}
+
+EffectPreset ReverbGated::getCurrentPreset() const
+{
+    return EffectPreset("Current Settings", "Current gated reverb parameters",
+        { threshold, hold, release, decayTime, size, damping, mix });
+}
+
+void ReverbGated::prepare(double sr, int samplesPerBlock)
+{
+    sampleRate = sr;
+    blockSize = samplesPerBlock;
+    updateParameters();
+    hall.prepare(sr, samplesPerBlock);
+    reset();
+}
+
+void ReverbGated::reset()
+{
+    hall.reset();
+    envelope = 0.0f;
+    gateGain = 0.0f;
+    holdCounter = 0;
+}
+
+void ReverbGated::releaseResources()
+{
+    hall.releaseResources();
+}
+
+void ReverbGated::setParameter(int parameterIndex, float value)
+{
+    value = dsp256::jlimit(0.0f, 1.0f, value);
+    if (getParameter(parameterIndex) == value)
+        return;
+
+    switch (parameterIndex) {
+    case 0: threshold = value; break;
+    case 1: hold = value; break;
+    case 2: release = value; break;
+    case 3: decayTime = value; break;
+    case 4: size = value; break;
+    case 5: damping = value; break;
+    case 6: mix = value; break;
+    }
+    updateParameters();
+}
+
+float ReverbGated::getParameter(int parameterIndex) const
+{
+    switch (parameterIndex) {
+    case 0: return threshold;
+    case 1: return hold;
+    case 2: return release;
+    case 3: return decayTime;
+    case 4: return size;
+    case 5: return damping;
+    case 6: return mix;
+    default: return 0.0f;
+    }
+}
+
+dsp256::String ReverbGated::getParameterDisplay(int parameterIndex) const
+{
+    switch (parameterIndex) {
+    case 0: return dsp256::String(-60.0f + threshold * 60.0f, 1) + " dB";
+    case 1: return dsp256::String(10.0f * std::pow(100.0f, hold), 0) + " ms";
+    case 2: return dsp256::String(5.0f * std::pow(100.0f, release), 0) + " ms";
+    case 3: return hall.getParameterDisplay(1);
+    case 4: return hall.getParameterDisplay(5);
+    case 5: return hall.getParameterDisplay(3);
+    case 6: return dsp256::String(mix * 100.0f, 0) + "%";
+    default: return "";
+    }
+}
+
+void ReverbGated::updateParameters()
+{
+    validateParameters();
+
+    hall.setParameter(1, decayTime);
+    hall.setParameter(3, damping);
+    hall.setParameter(5, size);
+
+    const float fs = static_cast<float>(sampleRate);
+
+    thresholdGain = dsp256::Decibels::decibelsToGain(-60.0f + threshold * 60.0f);
+    holdSamples = static_cast<int>(0.01f * std::pow(100.0f, hold) * fs);
+
+    // 1 ms linear attack; linear release gives the abrupt 80s cut-off
+    attackStep = 1.0f / (0.001f * fs);
+    releaseStep = 1.0f / (0.005f * std::pow(100.0f, release) * fs);
+
+    envelopeRelease = std::exp(-1.0f / (0.05f * fs));
+}
+
+//==============================================================================
+void ReverbGated::process(FixedPointSample& left, FixedPointSample& right,
+    DelayMemoryPool& delayPool, FixedPointEngine& dspCore)
+{
+    const float inL = dspCore.Q12ToFloat(left);
+    const float inR = dspCore.Q12ToFloat(right);
+
+    // Key the gate from the dry input
+    const float peak = dsp256::jmax(std::abs(inL), std::abs(inR));
+    envelope = dsp256::jmax(peak, envelope * envelopeRelease);
+
+    if (envelope >= thresholdGain)
+        holdCounter = holdSamples;
+
+    if (holdCounter > 0) {
+        --holdCounter;
+        gateGain = dsp256::jmin(1.0f, gateGain + attackStep);
+    }
+    else {
+        gateGain = dsp256::jmax(0.0f, gateGain - releaseStep);
+    }
+
+    FixedPointSample wetL = left;
+    FixedPointSample wetR = right;
+    hall.process(wetL, wetR, delayPool, dspCore);
+
+    const float outL = inL * (1.0f - mix) + dspCore.Q12ToFloat(wetL) * gateGain * mix;
+    const float outR = inR * (1.0f - mix) + dspCore.Q12ToFloat(wetR) * gateGain * mix;
+
+    left = dspCore.floatToQ12(outL);
+    right = dspCore.floatToQ12(outR);
+}
+
+void ReverbGated::updateModulation(int blockCounter)
+{
+    hall.updateModulation(blockCounter);
+}
+
+dsp256::String ReverbGated::getRealtimeDisplayInfo() const
+{
+    return dsp256::String::formatted("Gate: %s  %s", gateGain > 0.0f ? "OPEN" : "SHUT",
+        hall.getRealtimeDisplayInfo().toRawUTF8());
+}
+
+void ReverbGated::validateParameters()
+{
+    threshold = dsp256::jlimit(0.0f, 1.0f, threshold);
+    hold = dsp256::jlimit(0.0f, 1.0f, hold);
+    release = dsp256::jlimit(0.0f, 1.0f, release);
+    decayTime = dsp256::jlimit(0.0f, 1.0f, decayTime);
+    size = dsp256::jlimit(0.0f, 1.0f, size);
+    damping = dsp256::jlimit(0.0f, 1.0f, damping);
+    mix = dsp256::jlimit(0.0f, 1.0f, mix);
+}
@@ -0,0 +1,89 @@
+// ReverbGated.h - Gated Reverb Effect Module
+#pragma once
+
+#include "EffectModule.h"
+#include "FixedPointDSP.h"
+#include "DelayMemoryPool.h"
+#include "ReverbHall.h"
+
+//==============================================================================
+// Gated Reverb Effect Module
+// 80s-style gated reverb: the hall network runs fully wet and its tail is cut
+// by a gate keyed from the dry input envelope, with hold and linear release.
+//==============================================================================
+class ReverbGated : public EffectModule {
+public:
+    ReverbGated();
+    ~ReverbGated() override = default;
+
+    // Module identification
+    dsp256::String getModuleName() const override { return "Reverb Gated"; }
+    dsp256::String getModuleDescription() const override {
+        return "Dense reverb cut short by an input-keyed gate. "
+            "Classic 80s drum sound.";
+    }
+
+    // Parameter configuration
+    std::vector<EffectParameter> getParameterDefinitions() const override;
+    int getParameterCount() const override { return 7; }
+
+    // Preset management
+    std::vector<EffectPreset> getFactoryPresets() const override;
+    void loadPreset(const EffectPreset& preset) override;
+    EffectPreset getCurrentPreset() const override;
+
+    // DSP lifecycle
+    void prepare(double sampleRate, int samplesPerBlock) override;
+    void reset() override;
+    void releaseResources() override;
+
+    // Parameter updates
+    void setParameter(int parameterIndex, float value) override;
+    float getParameter(int parameterIndex) const override;
+    dsp256::String getParameterDisplay(int parameterIndex) const override;
+
+    // Audio processing
+    void process(FixedPointSample& left, FixedPointSample& right,
+        DelayMemoryPool& delayPool, FixedPointEngine& dspCore) override;
+
+    // Modulation updates (forwarded to the hall)
+    void updateModulation(int blockCounter) override;
+
+    // Real-time display
+    bool hasRealtimeDisplay() const override { return true; }
+    dsp256::String getRealtimeDisplayInfo() const override;
+    float getTailLevel() const override { return hall.getTailLevel(); }
+
+private:
+    // Parameters (0.0 to 1.0 normalized)
+    float threshold = 0.6f;       // Gate threshold: -60 to 0 dB
+    float hold = 0.25f;           // Hold: 10-1000 ms (logarithmic)
+    float release = 0.3f;         // Release: 5-500 ms (logarithmic)
+    float decayTime = 0.6f;       // Hall decay (forwarded)
+    float size = 0.6f;            // Hall size (forwarded)
+    float damping = 0.6f;         // Hall damping (forwarded)
+    float mix = 0.5f;             // Dry/Wet Mix: 0-100%
+
+    // Reverb network, run 100% wet
+    ReverbHall hall;
+
+    // Gate state
+    float envelope = 0.0f;
+    float envelopeRelease = 0.0f;
+    float thresholdGain = 0.0f;
+    float gateGain = 0.0f;
+    float attackStep = 1.0f;
+    float releaseStep = 1.0f;
+    int holdSamples = 0;
+    int holdCounter = 0;
+
+    // Sample rate and block size
+    double sampleRate = 44100.0;
+    int blockSize = 512;
+
+    // Helper methods
+    void updateParameters();
+
+    // Parameter validation
+    void validateParameters();
+};
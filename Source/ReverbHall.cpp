@@ -9,8 +9,6 @@ ReverbHall::ReverbHall()
     sampleRate = 44100.0;
     dcOffsetStateL = 0.0f;
     dcOffsetStateR = 0.0f;
-    lpfStateL = 0.0f;
-    lpfStateR = 0.0f;
     lfoPhase = 0.0f;
     modulationDepth = 0.0f;
 
@@ -24,6 +22,10 @@ ReverbHall::ReverbHall()
     mix = 0.5f;               // 50%
 
     // Initialize buffers with default sizes
+    dampingTable.prepare(sampleRate);
+    quadMatrix.prepare(sampleRate);
+    surroundMatrix.prepare(sampleRate);
+    configureSurroundMatrices();
     initializeBuffers();
 
     // Update internal parameters
@@ -40,7 +42,17 @@ std::vector<EffectParameter> ReverbHall::getParameterDefinitions() const
         EffectParameter("damping", "HF Damping", "DAMP", "%", 0.0f, 100.0f, 50.0f, 0.1f, false),
         EffectParameter("early", "Early Reflections", "EARLY", "%", 0.0f, 100.0f, 70.0f, 0.1f, false),
         EffectParameter("size", "Room Size", "SIZE", "x", 0.5f, 2.0f, 1.0f, 0.01f, false),
-        EffectParameter("mix", "Dry/Wet Mix", "MIX", "%", 0.0f, 100.0f, 50.0f, 0.1f, false)
+        EffectParameter("mix", "Dry/Wet Mix", "MIX", "%", 0.0f, 100.0f, 50.0f, 0.1f, false),
+        EffectParameter("duckdepth", "Duck Depth", "DUCK", "dB", 0.0f, 24.0f, 0.0f, 0.1f, false),
+        EffectParameter("duckthresh", "Duck Threshold", "DK THR", "dB", -60.0f, 0.0f, -30.0f, 0.1f, false),
+        EffectParameter("duckrelease", "Duck Release", "DK REL", "ms", 20.0f, 2000.0f, 200.0f, 1.0f, true),
+        EffectParameter("duckdetect", "Duck Detector", "DK DET", "%", 0.0f, 100.0f, 0.0f, 0.1f, false),
+        // Width (stereo, and the front pair of quad/5.1/7.1; no effect on FOA)
+        EffectParameter("width", "Stereo Width", "WIDTH", "%", 0.0f, 200.0f, 100.0f, 0.1f, false),
+        EffectParameter("bassfreq", "Bass Crossover", "BASS HZ", "Hz", 20.0f, 500.0f, 120.0f, 1.0f, true),
+        EffectParameter("basswidth", "Bass Width", "BASS W", "%", 0.0f, 200.0f, 100.0f, 0.1f, false),
+        // 0% with both widths at 100% is the original L = d, R = 0.9 d wet image
+        EffectParameter("sideinject", "Side Injection", "SIDE", "%", 0.0f, 100.0f, 0.0f, 0.1f, false)
     };
 }
 
@@ -55,20 +67,37 @@ std::vector<EffectPreset> ReverbHall::getFactoryPresets() const
         EffectPreset("Gated Room", "80s drum reverb", {0.0f, 0.2f, 0.7f, 0.8f, 0.9f, 0.6f, 0.3f}),
         EffectPreset("Ambient", "Ethereal, long decay", {0.3f, 0.9f, 0.7f, 0.2f, 0.4f, 1.5f, 0.7f}),
         EffectPreset("Vocal Chamber", "Optimized for vocals", {0.15f, 0.45f, 0.75f, 0.55f, 0.8f, 0.8f, 0.45f}),
-        EffectPreset("Reverse Tail", "Reverse reverb effect", {0.25f, 0.6f, 0.5f, 0.4f, 0.3f, 1.0f, 0.6f})
+        EffectPreset("Reverse Tail", "Reverse reverb effect", {0.25f, 0.6f, 0.5f, 0.4f, 0.3f, 1.0f, 0.6f}),
+        EffectPreset("Wide Hall", "Comb side signal, mono bass", {0.1f, 0.6f, 0.85f, 0.4f, 0.6f, 0.9f, 0.5f,
+            0.0f, 0.5f, 0.5f, 0.0f, 0.7f, 0.557f, 0.0f, 1.0f})
     };
 }
 
 void ReverbHall::loadPreset(const EffectPreset& preset)
 {
     if (preset.parameterValues.size() >= 7) {
-        preDelay = juce::jlimit(0.0f, 1.0f, preset.parameterValues[0]);
-        decayTime = juce::jlimit(0.0f, 1.0f, preset.parameterValues[1]);
-        diffusion = juce::jlimit(0.0f, 1.0f, preset.parameterValues[2]);
-        damping = juce::jlimit(0.0f, 1.0f, preset.parameterValues[3]);
-        earlyLevel = juce::jlimit(0.0f, 1.0f, preset.parameterValues[4]);
-        size = juce::jlimit(0.0f, 1.0f, preset.parameterValues[5]);
-        mix = juce::jlimit(0.0f, 1.0f, preset.parameterValues[6]);
+        preDelay = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[0]);
+        decayTime = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[1]);
+        diffusion = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[2]);
+        damping = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[3]);
+        earlyLevel = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[4]);
+        size = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[5]);
+        mix = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[6]);
+
+        // Older 7-value presets leave the ducker as it is
+        if (preset.parameterValues.size() >= 11) {
+            duckDepth = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[7]);
+            duckThreshold = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[8]);
+            duckRelease = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[9]);
+            duckDetector = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[10]);
+        }
+        if (preset.parameterValues.size() >= 14) {
+            width = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[11]);
+            bassCrossover = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[12]);
+            bassWidth = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[13]);
+        }
+        if (preset.parameterValues.size() >= 15)
+            sideInjection = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[14]);
         updateParameters();
     }
 }
@@ -76,13 +105,24 @@ void ReverbHall::loadPreset(const EffectPreset& preset)
 EffectPreset ReverbHall::getCurrentPreset() const
 {
     return EffectPreset("Current Settings", "Current reverb parameters",
-        { preDelay, decayTime, diffusion, damping, earlyLevel, size, mix });
+        { preDelay, decayTime, diffusion, damping, earlyLevel, size, mix,
+          duckDepth, duckThreshold, duckRelease, duckDetector,
+          width, bassCrossover, bassWidth, sideInjection });
+}
+
+std::unique_ptr<EffectModule> ReverbHall::createInstance() const
+{
+    return std::make_unique<ReverbHall>();
 }
 
 void ReverbHall::prepare(double sr, int samplesPerBlock)
 {
     sampleRate = sr;
     blockSize = samplesPerBlock;
+    dampingTable.prepare(sr);
+    duckFollower.prepare(sr);
+    quadMatrix.prepare(sr);
+    surroundMatrix.prepare(sr);
     initializeBuffers();
     updateParameters();
     reset();
@@ -107,19 +147,26 @@ void ReverbHall::reset()
 
     dampingStateL = 0;
     dampingStateR = 0;
-    lpfStateL = 0.0f;
-    lpfStateR = 0.0f;
+    dampingFilter.reset();
+    quadMatrix.reset();
+    surroundMatrix.reset();
     dcOffsetStateL = 0.0f;
     dcOffsetStateR = 0.0f;
     lfoPhase = 0.0f;
     currentTailLevel = 0.0f;
+
+    stereoWidth.reset();
+    duckFollower.reset();
+    duckGain = 1.0f;
+    duckStep = 0.0f;
+    duckTarget = 1.0f;
 }
 
 void ReverbHall::releaseResources() {}
 
 void ReverbHall::setParameter(int parameterIndex, float value)
 {
-    value = juce::jlimit(0.0f, 1.0f, value);
+    value = dsp256::jlimit(0.0f, 1.0f, value);
     switch (parameterIndex) {
     case 0: preDelay = value; break;
     case 1: decayTime = value; break;
@@ -128,6 +175,14 @@ void ReverbHall::setParameter(int parameterIndex, float value)
     case 4: earlyLevel = value; break;
     case 5: size = value; break;
     case 6: mix = value; break;
+    case 7: duckDepth = value; break;
+    case 8: duckThreshold = value; break;
+    case 9: duckRelease = value; break;
+    case 10: duckDetector = value; break;
+    case 11: width = value; break;
+    case 12: bassCrossover = value; break;
+    case 13: bassWidth = value; break;
+    case 14: sideInjection = value; break;
     }
     updateParameters();
 }
@@ -142,24 +197,45 @@ float ReverbHall::getParameter(int parameterIndex) const
     case 4: return earlyLevel;
     case 5: return size;
     case 6: return mix;
+    case 7: return duckDepth;
+    case 8: return duckThreshold;
+    case 9: return duckRelease;
+    case 10: return duckDetector;
+    case 11: return width;
+    case 12: return bassCrossover;
+    case 13: return bassWidth;
+    case 14: return sideInjection;
     default: return 0.0f;
     }
 }
 
-juce::String ReverbHall::getParameterDisplay(int parameterIndex) const
+dsp256::String ReverbHall::getParameterDisplay(int parameterIndex) const
+{
+    DisplayText text;
+    formatParameterDisplay(parameterIndex, text);
+    return dsp256::String(text.c_str());
+}
+
+void ReverbHall::formatParameterDisplay(int parameterIndex, DisplayText& text) const
 {
+    text.clear();
     switch (parameterIndex) {
-    case 0: return juce::String(preDelay * 100.0f, 0) + " ms";
-    case 1: {
-        float rt60 = 0.1f * std::pow(10.0f, decayTime * 2.0f);
-        return juce::String(rt60, 1) + " s";
-    }
-    case 2: return juce::String(diffusion * 100.0f, 0) + "%";
-    case 3: return juce::String(damping * 100.0f, 0) + "%";
-    case 4: return juce::String(earlyLevel * 100.0f, 0) + "%";
-    case 5: return juce::String(0.5f + size * 1.5f, 2);
-    case 6: return juce::String(mix * 100.0f, 0) + "%";
-    default: return "";
+    case 0: text.appendNumber(preDelay * 100.0f, 0); text.append(" ms"); break;
+    case 1: text.appendNumber(estimatedRT60, 1); text.append(" s"); break;
+    case 2: text.appendNumber(diffusion * 100.0f, 0); text.append("%"); break;
+    case 3: text.appendNumber(damping * 100.0f, 0); text.append("%"); break;
+    case 4: text.appendNumber(earlyLevel * 100.0f, 0); text.append("%"); break;
+    case 5: text.appendNumber(0.5f + size * 1.5f, 2); break;
+    case 6: text.appendNumber(mix * 100.0f, 0); text.append("%"); break;
+    case 7: text.appendNumber(duckDepth * 24.0f, 1); text.append(" dB"); break;
+    case 8: text.appendNumber(-60.0f + duckThreshold * 60.0f, 1); text.append(" dB"); break;
+    case 9: text.appendNumber(duckReleaseMs, 0); text.append(" ms"); break;
+    case 10: text.appendNumber(duckDetector * 100.0f, 0); text.append("% PK"); break;
+    case 11: text.appendNumber(width * 200.0f, 0); text.append("%"); break;
+    case 12: text.appendNumber(bassCrossoverHz, 0); text.append(" Hz"); break;
+    case 13: text.appendNumber(bassWidth * 200.0f, 0); text.append("%"); break;
+    case 14: text.appendNumber(sideInjection * 100.0f, 0); text.append("%"); break;
+    default: break;
     }
 }
 
@@ -176,7 +252,7 @@ void ReverbHall::updateParameters()
     if (avgDelay < 10.0f) avgDelay = 10.0f;
 
     float feedbackGain = std::pow(10.0f, -3.0f * rt60 / avgDelay);
-    feedbackGain = juce::jlimit(0.0f, 0.95f, feedbackGain);
+    feedbackGain = dsp256::jlimit(0.0f, 0.95f, feedbackGain);
     estimatedRT60 = rt60;
 
     for (auto& comb : combFilters) {
@@ -186,14 +262,38 @@ void ReverbHall::updateParameters()
     float alpha = 1.0f - damping * 0.99f;
     dampingAlpha = floatToFixed(alpha);
 
+    // Same pole as the old one-pole, run through the ZDF kernel at its cutoff
+    float quantizedAlpha = fixedToFloat(dampingAlpha);
+    if (quantizedAlpha >= 1.0f) {
+        dampingG = 0.0f;
+    }
+    else {
+        float cutoffHz = -std::log(quantizedAlpha) * static_cast<float>(sampleRate)
+            / dsp256::MathConstants<float>::twoPi;
+        float g = dampingTable.lookupHz(cutoffHz);
+        dampingG = g / (1.0f + g);
+    }
+
     for (int i = 0; i < 8; ++i) {
         float gain = earlyLevel * (0.9f - i * 0.1f);
-        gain = juce::jlimit(0.0f, 1.0f, gain);
+        gain = dsp256::jlimit(0.0f, 1.0f, gain);
         earlyReflections[i].gain = floatToFixed(gain);
     }
 
+    // Width: normalized 0.5 = 100%; the bass band is set absolutely
+    stereoWidth.highWidth = width * 2.0f;
+    stereoWidth.lowWidth = bassWidth * 2.0f;
+    bassCrossoverHz = 20.0f * std::pow(25.0f, bassCrossover);
+    stereoWidth.setCrossover(dampingTable.lookupHz(bassCrossoverHz));
+    if (stereoWidth.isNeutral())
+        stereoWidth.reset();     // Skipped while neutral; restart the crossover from silence
+
+    duckReleaseMs = 20.0f * std::pow(100.0f, duckRelease);
+    duckFollower.releaseSeconds = duckReleaseMs * 0.001f;
+    duckFollower.detector = duckDetector;
+
     float apCoeff = diffusion * 0.7f;
-    apCoeff = juce::jlimit(0.1f, 0.9f, apCoeff);
+    apCoeff = dsp256::jlimit(0.1f, 0.9f, apCoeff);
     for (auto& ap : allpassFilters) {
         ap.coeff = floatToFixed(apCoeff);
     }
@@ -203,12 +303,221 @@ void ReverbHall::updateParameters()
 void ReverbHall::process(FixedPointSample& left, FixedPointSample& right,
     DelayMemoryPool& delayPool, FixedPointEngine& dspCore)
 {
-    juce::ignoreUnused(delayPool);
+    dsp256::ignoreUnused(delayPool);
 
     // Convert to float using new Q12 naming
     float inL = dspCore.Q12ToFloat(left);
     float inR = dspCore.Q12ToFloat(right);
 
+    // Called on its own (not from processBlockReference()), each sample is
+    // a one-sample ducking block, keyed from the sidechain while one is set
+    const bool ownDuckingBlock = !duckingBlockActive;
+    const float* keyL = sidechainL;
+    const float* keyR = sidechainR;
+    if (ownDuckingBlock)
+        beginDuckingBlock(&inL, &inR, 1);
+
+    float wetL, wetR;
+    renderWet(inL, inR, dspCore, wetL, wetR);
+    if (!stereoWidth.isNeutral())
+        stereoWidth.processSample(wetL, wetR);
+
+    // Ducking acts on the wet path only, ahead of the mix
+    const float duck = duckGain;
+    duckGain += duckStep;
+
+    float outL = inL * (1.0f - mix) + wetL * duck * mix;
+    float outR = inR * (1.0f - mix) + wetR * duck * mix;
+
+    if (analyzerTap != nullptr) {
+        const float tap = (wetL + wetR) * duck * 0.5f;
+        analyzerTap->write(&tap, 1);
+    }
+
+    left = dspCore.floatToQ12(outL);
+    right = dspCore.floatToQ12(outR);
+
+    if (ownDuckingBlock) {
+        endDuckingBlock();
+        if (keyL != nullptr && keyR != nullptr) {
+            sidechainL = keyL + 1;
+            sidechainR = keyR + 1;
+        }
+    }
+}
+
+// Same signal path as process(), run stage by stage over whole chunks. The
+// network is feed-forward between stages, so each stage can take the whole
+// chunk before the next one starts without changing the output.
+void ReverbHall::processBlock(float* left, float* right, int numSamples,
+    DelayMemoryPool& delayPool, FixedPointEngine& dspCore)
+{
+    dsp256::ignoreUnused(delayPool);
+    DSP256_PROFILE_BEGIN_BLOCK(stageProfiler);
+    beginDuckingBlock(left, right, numSamples);
+
+    for (int start = 0; start < numSamples; start += WET_CHUNK) {
+        const int count = dsp256::jmin(WET_CHUNK, numSamples - start);
+        float* blockL = left + start;
+        float* blockR = right + start;
+
+        DSP256_PROFILE_BEGIN_STAGE(stageProfiler);
+        for (int i = 0; i < count; ++i) {
+            const float inL = dspCore.Q12ToFloat(dspCore.floatToQ12(blockL[i]));
+            const float inR = dspCore.Q12ToFloat(dspCore.floatToQ12(blockR[i]));
+            networkBlock[static_cast<size_t>(i)] = processInputStage(inL, inR, dspCore);
+        }
+        DSP256_PROFILE_END_STAGE(stageProfiler, STAGE_INPUT);
+
+        DSP256_PROFILE_BEGIN_STAGE(stageProfiler);
+        for (int i = 0; i < count; ++i)
+            networkBlock[static_cast<size_t>(i)] = processEarlyReflections(networkBlock[static_cast<size_t>(i)], dspCore);
+        DSP256_PROFILE_END_STAGE(stageProfiler, STAGE_EARLY);
+
+        DSP256_PROFILE_BEGIN_STAGE(stageProfiler);
+        for (int i = 0; i < count; ++i)
+            networkBlock[static_cast<size_t>(i)] = processCombBank(networkBlock[static_cast<size_t>(i)], dspCore, sideBlock[static_cast<size_t>(i)]);
+        DSP256_PROFILE_END_STAGE(stageProfiler, STAGE_COMBS);
+
+        DSP256_PROFILE_BEGIN_STAGE(stageProfiler);
+        for (int i = 0; i < count; ++i) {
+            const float apOut = processAllpassChain(networkBlock[static_cast<size_t>(i)], dspCore);
+            currentTailLevel = currentTailLevel * 0.999f + std::abs(apOut) * 0.001f;
+            networkBlock[static_cast<size_t>(i)] = apOut;
+        }
+        DSP256_PROFILE_END_STAGE(stageProfiler, STAGE_ALLPASS);
+
+        DSP256_PROFILE_BEGIN_STAGE(stageProfiler);
+        for (int i = 0; i < count; ++i)
+            processDamping(networkBlock[static_cast<size_t>(i)], sideBlock[static_cast<size_t>(i)],
+                wetBlockL[static_cast<size_t>(i)], wetBlockR[static_cast<size_t>(i)]);
+        DSP256_PROFILE_END_STAGE(stageProfiler, STAGE_DAMPING);
+
+        DSP256_PROFILE_BEGIN_STAGE(stageProfiler);
+        if (!stereoWidth.isNeutral())
+            stereoWidth.processBlock(wetBlockL.data(), wetBlockR.data(), count);
+
+        for (int i = 0; i < count; ++i) {
+            const float inL = dspCore.Q12ToFloat(dspCore.floatToQ12(blockL[i]));
+            const float inR = dspCore.Q12ToFloat(dspCore.floatToQ12(blockR[i]));
+
+            const float duck = duckGain;
+            duckGain += duckStep;
+
+            const float wetL = wetBlockL[static_cast<size_t>(i)] * duck;
+            const float wetR = wetBlockR[static_cast<size_t>(i)] * duck;
+            tapBlock[static_cast<size_t>(i)] = (wetL + wetR) * 0.5f;
+
+            const float outL = inL * (1.0f - mix) + wetL * mix;
+            const float outR = inR * (1.0f - mix) + wetR * mix;
+            blockL[i] = dspCore.Q12ToFloat(dspCore.floatToQ12(outL));
+            blockR[i] = dspCore.Q12ToFloat(dspCore.floatToQ12(outR));
+        }
+
+        if (analyzerTap != nullptr)
+            analyzerTap->write(tapBlock.data(), count);
+        DSP256_PROFILE_END_STAGE(stageProfiler, STAGE_OUTPUT);
+    }
+
+    endDuckingBlock();
+    DSP256_PROFILE_END_BLOCK(stageProfiler);
+}
+
+// process() per sample, with the block's ducking follower update around it
+void ReverbHall::processBlockReference(float* left, float* right, int numSamples,
+    DelayMemoryPool& delayPool, FixedPointEngine& dspCore)
+{
+    beginDuckingBlock(left, right, numSamples);
+    duckingBlockActive = true;
+    EffectModule::processBlockReference(left, right, numSamples, delayPool, dspCore);
+    duckingBlockActive = false;
+    endDuckingBlock();
+}
+
+#if DSP256_STAGE_PROFILING
+int ReverbHall::getStageTimings(StageTiming* timings, int maxTimings) const
+{
+    return stageProfiler.getTimings(timings, maxTimings);
+}
+
+void ReverbHall::resetStageTimings()
+{
+    stageProfiler.resetStatistics();
+}
+#endif
+
+// Damped stereo wet before width, ducking and mix. Both sides share the
+// network output; the comb-bank difference signal, scaled by the side
+// injection, supplies the side content.
+void ReverbHall::renderWet(float inL, float inR, FixedPointEngine& dspCore, float& wetL, float& wetR)
+{
+    float side = 0.0f;
+    float apOut = processNetwork(inL, inR, dspCore, side);
+    processDamping(apOut, side, wetL, wetR);
+}
+
+// Output low-pass on the wet signal and its side component
+void ReverbHall::processDamping(float apOut, float side, float& wetL, float& wetR)
+{
+    float damped[4];
+    dampingFilter.processLowPass(Float4::set(apOut, apOut, side, 0.0f), Float4::broadcast(dampingG)).store(damped);
+
+    const float injected = damped[2] * sideInjection;
+    wetL = damped[0] + injected;
+    wetR = damped[1] * 0.9f - injected;
+}
+
+void ReverbHall::setSidechainInput(const float* left, const float* right)
+{
+    sidechainL = left;
+    sidechainR = right;
+}
+
+// One follower update per block; the sample loops ramp duckGain to the target
+void ReverbHall::beginDuckingBlock(const float* dryL, const float* dryR, int numSamples)
+{
+    const bool external = sidechainL != nullptr && sidechainR != nullptr;
+    const float* keyL = external ? sidechainL : dryL;
+    const float* keyR = external ? sidechainR : dryR;
+
+    if (duckDepth <= 0.0f || numSamples <= 0) {
+        duckTarget = 1.0f;
+    }
+    else {
+        const float level = duckFollower.processBlock(keyL, keyR, numSamples);
+        const float overDb = dsp256::Decibels::gainToDecibels(level, -100.0f) - (-60.0f + duckThreshold * 60.0f);
+        const float amount = dsp256::jlimit(0.0f, 1.0f, overDb / DUCK_KNEE_DB);
+        duckTarget = dsp256::Decibels::decibelsToGain(-24.0f * duckDepth * amount);
+    }
+
+    duckStep = numSamples > 0 ? (duckTarget - duckGain) / static_cast<float>(numSamples) : 0.0f;
+}
+
+void ReverbHall::endDuckingBlock()
+{
+    duckGain = duckTarget;
+    duckStep = 0.0f;
+    sidechainL = nullptr;
+    sidechainR = nullptr;
+}
+
+// Mono network shared by every output layout: DC block, pre-delay, early
+// reflections, combs and allpasses. Returns the undamped wet signal; 'side'
+// receives the alternating-sign comb sum, decorrelated from it.
+float ReverbHall::processNetwork(float inL, float inR, FixedPointEngine& dspCore, float& side)
+{
+    const float delayedInput = processInputStage(inL, inR, dspCore);
+    const float earlyOut = processEarlyReflections(delayedInput, dspCore);
+    const float combOut = processCombBank(earlyOut, dspCore, side);
+    const float apOut = processAllpassChain(combOut, dspCore);
+
+    currentTailLevel = currentTailLevel * 0.999f + std::abs(apOut) * 0.001f;
+    return apOut;
+}
+
+// Mono sum, DC block and pre-delay
+float ReverbHall::processInputStage(float inL, float inR, FixedPointEngine& dspCore)
+{
     float monoIn = (inL + inR) * 0.5f;
 
     // DC Blocking with new Q12 naming
@@ -217,14 +526,18 @@ void ReverbHall::process(FixedPointSample& left, FixedPointSample& right,
     float monoFiltered = dspCore.Q12ToFloat(monoInputFP);
 
     float delayedInput = monoFiltered;
-    if (!preDelayBuffer.empty() && preDelayReadOffset < preDelayBuffer.size()) {
+    if (!preDelayBuffer.empty() && preDelayReadOffset < (int)preDelayBuffer.size()) {
         preDelayBuffer[preDelayWriteIndex] = monoFiltered;
         int readIdx = (preDelayWriteIndex - preDelayReadOffset + (int)preDelayBuffer.size()) % (int)preDelayBuffer.size();
         delayedInput = preDelayBuffer[readIdx];
         preDelayWriteIndex = (preDelayWriteIndex + 1) % (int)preDelayBuffer.size();
     }
 
-    // Early reflections
+    return delayedInput;
+}
+
+float ReverbHall::processEarlyReflections(float delayedInput, FixedPointEngine& dspCore)
+{
     float earlySum = 0.0f;
     int activeEarly = 0;
 
@@ -243,10 +556,14 @@ void ReverbHall::process(FixedPointSample& left, FixedPointSample& right,
         activeEarly++;
     }
 
-    float earlyOut = (activeEarly > 0) ? (earlySum / activeEarly) : delayedInput;
+    return (activeEarly > 0) ? (earlySum / activeEarly) : delayedInput;
+}
 
-    // Comb filters
+// Parallel combs; 'side' receives their alternating-sign sum
+float ReverbHall::processCombBank(float earlyOut, FixedPointEngine& dspCore, float& side)
+{
     float combSum = 0.0f;
+    float combDifference = 0.0f;
     int activeCombs = 0;
 
     for (int i = 0; i < 4; ++i) {
@@ -261,12 +578,16 @@ void ReverbHall::process(FixedPointSample& left, FixedPointSample& right,
         comb.writeIndex = (comb.writeIndex + 1) % (int)comb.buffer.size();
 
         combSum += output;
+        combDifference += (i & 1) ? -output : output;
         activeCombs++;
     }
 
-    float combOut = (activeCombs > 0) ? (combSum / activeCombs) : earlyOut;
+    side = (activeCombs > 0) ? (combDifference / activeCombs) : 0.0f;
+    return (activeCombs > 0) ? (combSum / activeCombs) : earlyOut;
+}
 
-    // Allpass filters
+float ReverbHall::processAllpassChain(float combOut, FixedPointEngine& dspCore)
+{
     float apOut = combOut;
     for (int i = 0; i < 2; ++i) {
         auto& ap = allpassFilters[i];
@@ -282,19 +603,140 @@ void ReverbHall::process(FixedPointSample& left, FixedPointSample& right,
         apOut = output;
     }
 
-    float alpha = dspCore.Q12ToFloat(FixedPointSample{ dampingAlpha });
-    lpfStateL = lpfStateL * alpha + apOut * (1.0f - alpha);
-    lpfStateR = lpfStateR * alpha + apOut * (1.0f - alpha);
+    return apOut;
+}
 
-    float wetL = lpfStateL;
-    float wetR = lpfStateR * 0.9f;
-    float outL = inL * (1.0f - mix) + wetL * mix;
-    float outR = inR * (1.0f - mix) + wetR * mix;
+//==============================================================================
+bool ReverbHall::supportsOutputLayout(const OutputLayout& layout) const
+{
+    if (layout.ambisonic)
+        return layout.numChannels == FoaEncoder::NUM_CHANNELS;
+    return layout.numChannels == 2 || layout.numChannels == 4
+        || layout.numChannels == 6 || layout.numChannels == 8;
+}
 
-    left = dspCore.floatToQ12(outL);
-    right = dspCore.floatToQ12(outR);
+void ReverbHall::setOutputLayout(const OutputLayout& layout)
+{
+    outputLayout = layout;
+    configureSurroundMatrices();
+}
 
-    currentTailLevel = currentTailLevel * 0.999f + std::abs(apOut) * 0.001f;
+void ReverbHall::configureSurroundMatrices()
+{
+    // FOA: four decorrelated tails, first-order channels at diffuse-field level
+    if (outputLayout.ambisonic) {
+        for (int c = 0; c < 4; ++c)
+            quadMatrix.setChannelGain(c, c == 0 ? 1.0f : FoaEncoder::DIFFUSE_GAIN);
+        return;
+    }
+
+    // Silence the LFE and any lanes the layout does not use
+    for (int c = 0; c < 8; ++c) {
+        const bool active = c < outputLayout.numChannels && c != outputLayout.lfeChannel;
+        if (c < 4)
+            quadMatrix.setChannelGain(c, active ? 1.0f : 0.0f);
+        surroundMatrix.setChannelGain(c, active ? 1.0f : 0.0f);
+    }
+}
+
+void ReverbHall::processBlockMultichannel(float* const* channels, int numChannels, int numSamples,
+    DelayMemoryPool& delayPool, FixedPointEngine& dspCore)
+{
+    if (numChannels <= 2) {
+        processBlock(channels[0], channels[1], numSamples, delayPool, dspCore);
+        return;
+    }
+
+    jassert(numChannels <= OutputLayout::MAX_CHANNELS);
+    numChannels = dsp256::jmin(numChannels, OutputLayout::MAX_CHANNELS);
+    beginDuckingBlock(channels[0], channels[1], numSamples);
+    const bool useQuad = numChannels <= 4;
+
+    // The LFE and any channels past the layout carry no reverb: they pass
+    // through untouched rather than being scaled by the dry mix
+    const int layoutChannels = dsp256::jmin(numChannels, outputLayout.numChannels);
+    auto isReverbChannel = [this, layoutChannels](int c) {
+        return c < layoutChannels && c != outputLayout.lfeChannel;
+    };
+
+    alignas(16) float wet[OutputLayout::MAX_CHANNELS];
+
+    // The analyzer gets the mean of the wet channels (W alone for FOA)
+    int tapChannels = 0;
+    for (int c = 0; c < numChannels; ++c)
+        tapChannels += isReverbChannel(c) && (!outputLayout.ambisonic || c == 0) ? 1 : 0;
+    const float tapScale = tapChannels > 0 ? 1.0f / static_cast<float>(tapChannels) : 0.0f;
+    int tapCount = 0;
+
+    for (int i = 0; i < numSamples; ++i) {
+        // Same Q12 input quantization as the stereo path, on every input
+        float in[OutputLayout::MAX_CHANNELS];
+        for (int c = 0; c < numChannels; ++c)
+            in[c] = c < 2 || isReverbChannel(c) ? dspCore.Q12ToFloat(dspCore.floatToQ12(channels[c][i])) : 0.0f;
+        const float inL = in[0];
+        const float inR = in[1];
+
+        // Surround inputs (centre, rears) are folded into both network inputs;
+        // ambisonic layouts only ever take a mono/stereo input
+        float extra = 0.0f;
+        if (!outputLayout.ambisonic) {
+            for (int c = 2; c < numChannels; ++c) {
+                if (isReverbChannel(c))
+                    extra += in[c];
+            }
+        }
+        const float feedL = inL + 0.5f * extra;
+        const float feedR = inR + 0.5f * extra;
+
+        float side = 0.0f;
+        const float apOut = processNetwork(feedL, feedR, dspCore, side);
+
+        if (useQuad)
+            quadMatrix.process(apOut, dampingG, wet);
+        else
+            surroundMatrix.process(apOut, dampingG, wet);
+
+        // Width and bass width act on the front pair; FOA has no L/R pair
+        if (!outputLayout.ambisonic && !stereoWidth.isNeutral())
+            stereoWidth.processSample(wet[0], wet[1]);
+
+        // Dry path: passed through, or encoded at +/-30 degrees for FOA
+        float dry[OutputLayout::MAX_CHANNELS];
+        if (outputLayout.ambisonic) {
+            dry[0] = inL + inR;
+            dry[1] = (inL - inR) * FoaEncoder::STEREO_SIN;
+            dry[2] = 0.0f;
+            dry[3] = (inL + inR) * FoaEncoder::STEREO_COS;
+        }
+        else {
+            dry[0] = inL;
+            dry[1] = inR;
+            for (int c = 2; c < numChannels; ++c)
+                dry[c] = in[c];
+        }
+
+        const float duck = duckGain;
+        duckGain += duckStep;
+
+        float tap = 0.0f;
+        for (int c = 0; c < numChannels; ++c) {
+            if (!isReverbChannel(c))
+                continue;
+            if (!outputLayout.ambisonic || c == 0)
+                tap += wet[c];
+            const float out = dry[c] * (1.0f - mix) + wet[c] * duck * mix;
+            channels[c][i] = dspCore.Q12ToFloat(dspCore.floatToQ12(out));
+        }
+
+        tapBlock[static_cast<size_t>(tapCount++)] = tap * duck * tapScale;
+        if (tapCount == WET_CHUNK || i == numSamples - 1) {
+            if (analyzerTap != nullptr)
+                analyzerTap->write(tapBlock.data(), tapCount);
+            tapCount = 0;
+        }
+    }
+
+    endDuckingBlock();
 }
 
 float ReverbHall::processCombFilter(CombFilter& comb, float input, FixedPointEngine& dsp)
@@ -322,15 +764,19 @@ float ReverbHall::processAllpassFilter(AllpassFilter& ap, float input, FixedPoin
 
 void ReverbHall::updateModulation(int blockCounter)
 {
-    juce::ignoreUnused(blockCounter);
+    dsp256::ignoreUnused(blockCounter);
     lfoPhase += 0.05f;
     if (lfoPhase > 6.28318530718f) lfoPhase -= 6.28318530718f;
 }
 
-juce::String ReverbHall::getRealtimeDisplayInfo() const
+dsp256::String ReverbHall::getRealtimeDisplayInfo() const
 {
-    float tailDB = juce::Decibels::gainToDecibels(currentTailLevel + 1e-6f);
-    return juce::String::formatted("RT60: %.1fs  Tail: %.1f dB", estimatedRT60, tailDB);
+    float tailDB = dsp256::Decibels::gainToDecibels(currentTailLevel + 1e-6f);
+    if (duckDepth > 0.0f) {
+        return dsp256::String::formatted("RT60: %.1fs  Tail: %.1f dB  Duck: %.1f dB", estimatedRT60, tailDB,
+            dsp256::Decibels::gainToDecibels(duckGain, -100.0f));
+    }
+    return dsp256::String::formatted("RT60: %.1fs  Tail: %.1f dB", estimatedRT60, tailDB);
 }
 
 void ReverbHall::initializeBuffers()
@@ -369,13 +815,21 @@ void ReverbHall::initializeBuffers()
 
 void ReverbHall::validateParameters()
 {
-    preDelay = juce::jlimit(0.0f, 1.0f, preDelay);
-    decayTime = juce::jlimit(0.0f, 1.0f, decayTime);
-    diffusion = juce::jlimit(0.0f, 1.0f, diffusion);
-    damping = juce::jlimit(0.0f, 1.0f, damping);
-    earlyLevel = juce::jlimit(0.0f, 1.0f, earlyLevel);
-    size = juce::jlimit(0.0f, 1.0f, size);
-    mix = juce::jlimit(0.0f, 1.0f, mix);
+    preDelay = dsp256::jlimit(0.0f, 1.0f, preDelay);
+    decayTime = dsp256::jlimit(0.0f, 1.0f, decayTime);
+    diffusion = dsp256::jlimit(0.0f, 1.0f, diffusion);
+    damping = dsp256::jlimit(0.0f, 1.0f, damping);
+    earlyLevel = dsp256::jlimit(0.0f, 1.0f, earlyLevel);
+    size = dsp256::jlimit(0.0f, 1.0f, size);
+    mix = dsp256::jlimit(0.0f, 1.0f, mix);
+    duckDepth = dsp256::jlimit(0.0f, 1.0f, duckDepth);
+    duckThreshold = dsp256::jlimit(0.0f, 1.0f, duckThreshold);
+    duckRelease = dsp256::jlimit(0.0f, 1.0f, duckRelease);
+    duckDetector = dsp256::jlimit(0.0f, 1.0f, duckDetector);
+    width = dsp256::jlimit(0.0f, 1.0f, width);
+    bassCrossover = dsp256::jlimit(0.0f, 1.0f, bassCrossover);
+    bassWidth = dsp256::jlimit(0.0f, 1.0f, bassWidth);
+    sideInjection = dsp256::jlimit(0.0f, 1.0f, sideInjection);
     if (size < 0.1f) size = 0.5f;
 }
 
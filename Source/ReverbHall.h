@@ -4,12 +4,19 @@
 #include "EffectModule.h"
 #include "FixedPointDSP.h"
 #include "DelayMemoryPool.h"
+#include "ZdfFilter.h"
+#include "SurroundMatrix.h"
+#include "Ambisonics.h"
+#include "EnvelopeFollower.h"
+#include "StereoWidth.h"
 #include <array>
 
 //==============================================================================
 // Reverb Hall Effect Module
 // Based on Schroeder-Moorer reverb architecture with parallel comb filters
-// and series allpass filters
+// and series allpass filters. A built-in ducker (parameters 7-10) lowers the
+// wet path under the dry input or an external sidechain key, and a mid/side
+// stage (parameters 11-13) sets wet width with a mono-compatible bass band.
 //==============================================================================
 class ReverbHall : public EffectModule {
 public:
@@ -17,20 +24,21 @@ public:
     ~ReverbHall() override = default;
 
     // Module identification
-    juce::String getModuleName() const override { return "Reverb Hall"; }
-    juce::String getModuleDescription() const override {
+    dsp256::String getModuleName() const override { return "Reverb Hall"; }
+    dsp256::String getModuleDescription() const override {
         return "Classic hall reverb with warm, spacious character. "
             "Based on Schroeder-Moorer architecture.";
     }
 
     // Parameter configuration
     std::vector<EffectParameter> getParameterDefinitions() const override;
-    int getParameterCount() const override { return 7; }
+    int getParameterCount() const override { return 15; }
 
     // Preset management
     std::vector<EffectPreset> getFactoryPresets() const override;
     void loadPreset(const EffectPreset& preset) override;
     EffectPreset getCurrentPreset() const override;
+    std::unique_ptr<EffectModule> createInstance() const override;
 
     // DSP lifecycle
     void prepare(double sampleRate, int samplesPerBlock) override;
@@ -40,18 +48,38 @@ public:
     // Parameter updates
     void setParameter(int parameterIndex, float value) override;
     float getParameter(int parameterIndex) const override;
-    juce::String getParameterDisplay(int parameterIndex) const override;
+    dsp256::String getParameterDisplay(int parameterIndex) const override;
+    void formatParameterDisplay(int parameterIndex, DisplayText& text) const override;
 
     // Audio processing
     void process(FixedPointSample& left, FixedPointSample& right,
         DelayMemoryPool& delayPool, FixedPointEngine& dspCore) override;
+    void processBlock(float* left, float* right, int numSamples,
+        DelayMemoryPool& delayPool, FixedPointEngine& dspCore) override;
+    void processBlockReference(float* left, float* right, int numSamples,
+        DelayMemoryPool& delayPool, FixedPointEngine& dspCore) override;
+    void setSidechainInput(const float* left, const float* right) override;
+    void setAnalyzerTap(AnalyzerRing* ring) override { analyzerTap = ring; }
+
+    // Surround output: quad, 5.1 and 7.1 via a decorrelated tap matrix, or
+    // first-order AmbiX with the tail diffuse-encoded
+    bool supportsOutputLayout(const OutputLayout& layout) const override;
+    void setOutputLayout(const OutputLayout& layout) override;
+    void processBlockMultichannel(float* const* channels, int numChannels, int numSamples,
+        DelayMemoryPool& delayPool, FixedPointEngine& dspCore) override;
 
     // Modulation updates (called at control rate)
     void updateModulation(int blockCounter) override;
 
     // Real-time display
     bool hasRealtimeDisplay() const override { return true; }
-    juce::String getRealtimeDisplayInfo() const override;
+    dsp256::String getRealtimeDisplayInfo() const override;
+    float getTailLevel() const override { return currentTailLevel; }
+
+#if DSP256_STAGE_PROFILING
+    int getStageTimings(StageTiming* timings, int maxTimings) const override;
+    void resetStageTimings() override;
+#endif
 
 private:
     // Parameters (0.0 to 1.0 normalized)
@@ -62,6 +90,14 @@ private:
     float earlyLevel = 0.7f;      // Early Reflections: 0-100%
     float size = 1.0f;            // Room Size: 0.5-2.0x scaling
     float mix = 0.5f;             // Dry/Wet Mix: 0-100%
+    float duckDepth = 0.0f;       // Ducking depth: 0-24 dB (0 = off)
+    float duckThreshold = 0.5f;   // Ducking threshold: -60 to 0 dB
+    float duckRelease = 0.5f;     // Ducking release: 20-2000 ms (logarithmic)
+    float duckDetector = 0.0f;    // Key detector: 0 = RMS, 1 = peak
+    float width = 0.5f;           // Wet width above the crossover: 0-200% (front pair on surround, none on FOA)
+    float bassCrossover = 0.557f; // Bass crossover: 20-500 Hz (logarithmic)
+    float bassWidth = 0.5f;       // Wet width below the crossover: 0-200%
+    float sideInjection = 0.0f;   // Comb side signal in the wet image: 0-100% (0 = original image)
 
     // DSP State Structures
     struct CombFilter {
@@ -100,9 +136,48 @@ private:
     int32_t dampingStateL = 0;         // Q12 fixed-point state
     int32_t dampingStateR = 0;         // Q12 fixed-point state
 
-    // Low-pass filter states for output (NOT static - per instance)
-    float lpfStateL = 0.0f;
-    float lpfStateR = 0.0f;
+    // Output damping low-pass (shared ZDF kernel, lanes: L, R)
+    ZdfTanTable dampingTable;
+    ZdfOnePole dampingFilter;
+    float dampingG = 0.0f;             // TPT coefficient g / (1 + g)
+
+    // Multichannel wet outputs (quad and FOA use 4 lanes; 5.1 and 7.1 use 8)
+    OutputLayout outputLayout;
+    SurroundMatrix<4> quadMatrix;
+    SurroundMatrix<8> surroundMatrix;
+
+    // Wet-bus mid/side width, applied per chunk in processBlock() and to the
+    // front pair in processBlockMultichannel()
+    static constexpr int WET_CHUNK = 256;
+    StereoWidth stereoWidth;
+    alignas(16) std::array<float, WET_CHUNK> wetBlockL{};
+    alignas(16) std::array<float, WET_CHUNK> wetBlockR{};
+
+    // Mono network signal and comb side signal between the processBlock() stages
+    alignas(16) std::array<float, WET_CHUNK> networkBlock{};
+    alignas(16) std::array<float, WET_CHUNK> sideBlock{};
+
+    // processBlock() stages, timed in DSP256_STAGE_PROFILING builds
+    enum Stage { STAGE_INPUT, STAGE_EARLY, STAGE_COMBS, STAGE_ALLPASS, STAGE_DAMPING, STAGE_OUTPUT, NUM_STAGES };
+#if DSP256_STAGE_PROFILING
+    StageProfiler<NUM_STAGES> stageProfiler{ { { "IN", "ER", "CB", "AP", "DM", "OUT" } } };
+#endif
+
+    // Mono wet bus (after width and ducking) for the editor's analyzer, fed
+    // by every render path
+    AnalyzerRing* analyzerTap = nullptr;
+    alignas(16) std::array<float, WET_CHUNK> tapBlock{};
+
+    // Wet-path ducking: gain is set once per block and ramped per sample
+    // (process() on its own: every sample)
+    static constexpr float DUCK_KNEE_DB = 12.0f;
+    EnvelopeFollower duckFollower;
+    float duckGain = 1.0f;
+    float duckStep = 0.0f;
+    float duckTarget = 1.0f;
+    bool duckingBlockActive = false;   // process() is inside processBlockReference()'s ducking block
+    const float* sidechainL = nullptr;
+    const float* sidechainR = nullptr;
 
     // DC offset filter states
     float dcOffsetStateL = 0.0f;
@@ -117,12 +192,29 @@ private:
     float currentTailLevel = 0.0f;
     float estimatedRT60 = 2.0f;
 
+    // Derived display values, computed once in updateParameters()
+    float duckReleaseMs = 200.0f;
+    float bassCrossoverHz = 120.0f;
+
     // Sample rate and block size
     double sampleRate = 44100.0;
     int blockSize = 512;
 
     // Helper methods
     void updateParameters();
+    float processNetwork(float inL, float inR, FixedPointEngine& dspCore, float& side);
+    void renderWet(float inL, float inR, FixedPointEngine& dspCore, float& wetL, float& wetR);
+
+    // Network stages, in signal order (Tools/Benchmark.cpp times them one by one)
+    float processInputStage(float inL, float inR, FixedPointEngine& dspCore);
+    float processEarlyReflections(float delayedInput, FixedPointEngine& dspCore);
+    float processCombBank(float earlyOut, FixedPointEngine& dspCore, float& side);
+    float processAllpassChain(float combOut, FixedPointEngine& dspCore);
+    void processDamping(float apOut, float side, float& wetL, float& wetR);
+    friend class ReverbHallBenchmark;
+    void configureSurroundMatrices();
+    void beginDuckingBlock(const float* dryL, const float* dryR, int numSamples);
+    void endDuckingBlock();
     float processCombFilter(CombFilter& comb, float input, FixedPointEngine& dsp);
     float processAllpassFilter(AllpassFilter& ap, float input, FixedPointEngine& dsp);
 
@@ -0,0 +1,285 @@
+// ReverbReverse.cpp - Reverse Reverb Implementation
+#include "ReverbReverse.h"
+#include <cmath>
+
+//==============================================================================
+ReverbReverse::ReverbReverse()
+{
+    sampleRate = 44100.0;
+
+    hall.setParameter(0, 0.0f);    // Pre-delay
+    hall.setParameter(2, 0.8f);    // Diffusion
+    hall.setParameter(4, 0.5f);    // Early reflections
+    hall.setParameter(6, 1.0f);    // Fully wet
+
+    allocateBuffers();
+    updateParameters();
+    reset();
+}
+
+//==============================================================================
+std::vector<EffectParameter> ReverbReverse::getParameterDefinitions() const
+{
+    return {
+        EffectParameter("length", "Segment Length", "LENGTH", "ms", 50.0f, 1000.0f, 400.0f, 1.0f, true),
+        EffectParameter("decay", "Decay Time", "DECAY", "s", 0.1f, 10.0f, 1.6f, 0.01f, true),
+        EffectParameter("size", "Room Size", "SIZE", "x", 0.5f, 2.0f, 1.5f, 0.01f, false),
+        EffectParameter("damping", "HF Damping", "DAMP", "%", 0.0f, 100.0f, 40.0f, 0.1f, false),
+        EffectParameter("swell", "Swell Curve", "SWELL", "%", 0.0f, 100.0f, 50.0f, 0.1f, false),
+        EffectParameter("fade", "Edge Fade", "FADE", "ms", 1.0f, 50.0f, 10.0f, 0.1f, false),
+        EffectParameter("mix", "Dry/Wet Mix", "MIX", "%", 0.0f, 100.0f, 60.0f, 0.1f, false)
+    };
+}
+
+//==============================================================================
+std::vector<EffectPreset> ReverbReverse::getFactoryPresets() const
+{
+    return {
+        EffectPreset("Reverse Tail", "Reverse reverb effect", {0.45f, 0.6f, 0.7f, 0.4f, 0.5f, 0.2f, 0.6f}),
+        EffectPreset("Swell Pad", "Long segments, steep swell", {0.9f, 0.8f, 0.9f, 0.3f, 0.9f, 0.4f, 0.7f}),
+        EffectPreset("Short Reverse", "Quick, rhythmic reverse", {0.15f, 0.4f, 0.5f, 0.5f, 0.3f, 0.1f, 0.5f}),
+        EffectPreset("Ghost Vocal", "Dark reverse behind the vocal", {0.6f, 0.7f, 0.8f, 0.7f, 0.7f, 0.3f, 0.4f})
+    };
+}
+
+void ReverbReverse::loadPreset(const EffectPreset& preset)
+{
+    if (preset.parameterValues.size() >= 7) {
+        segmentLength = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[0]);
+        decayTime = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[1]);
+        size = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[2]);
+        damping = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[3]);
+        swell = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[4]);
+        fade = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[5]);
+        mix = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[6]);
+        updateParameters();
+    }
+}
+
+EffectPreset ReverbReverse::getCurrentPreset() const
+{
+    return EffectPreset("Current Settings", "Current reverse reverb parameters",
+        { segmentLength, decayTime, size, damping, swell, fade, mix });
+}
+
+void ReverbReverse::prepare(double sr, int samplesPerBlock)
+{
+    sampleRate = sr;
+    blockSize = samplesPerBlock;
+    allocateBuffers();
+    updateParameters();
+    hall.prepare(sr, samplesPerBlock);
+    reset();
+}
+
+void ReverbReverse::allocateBuffers()
+{
+    // The only allocation: room for the longest segment at this sample rate
+    latencySamples = dsp256::jmax(1, static_cast<int>(std::ceil(MAX_SEGMENT_SECONDS * sampleRate)));
+    const size_t historySize = static_cast<size_t>(latencySamples) * 2;
+    historyL.assign(historySize, 0.0f);
+    historyR.assign(historySize, 0.0f);
+    dryDelayL.assign(static_cast<size_t>(latencySamples) + 1, 0.0f);
+    dryDelayR.assign(static_cast<size_t>(latencySamples) + 1, 0.0f);
+}
+
+void ReverbReverse::reset()
+{
+    hall.reset();
+
+    std::fill(historyL.begin(), historyL.end(), 0.0f);
+    std::fill(historyR.begin(), historyR.end(), 0.0f);
+    std::fill(dryDelayL.begin(), dryDelayL.end(), 0.0f);
+    std::fill(dryDelayR.begin(), dryDelayR.end(), 0.0f);
+
+    historyWriteIndex = 0;
+    position = 0;
+    recordLength = pendingLength;
+    queueRead = 0;
+    queueCount = 0;
+    playStartDelay = latencySamples;
+    playPosition = 0;
+    playLength = 0;
+    dryWriteIndex = 0;
+}
+
+void ReverbReverse::releaseResources()
+{
+    hall.releaseResources();
+}
+
+void ReverbReverse::setParameter(int parameterIndex, float value)
+{
+    value = dsp256::jlimit(0.0f, 1.0f, value);
+    if (getParameter(parameterIndex) == value)
+        return;
+
+    switch (parameterIndex) {
+    case 0: segmentLength = value; break;
+    case 1: decayTime = value; break;
+    case 2: size = value; break;
+    case 3: damping = value; break;
+    case 4: swell = value; break;
+    case 5: fade = value; break;
+    case 6: mix = value; break;
+    }
+    updateParameters();
+}
+
+float ReverbReverse::getParameter(int parameterIndex) const
+{
+    switch (parameterIndex) {
+    case 0: return segmentLength;
+    case 1: return decayTime;
+    case 2: return size;
+    case 3: return damping;
+    case 4: return swell;
+    case 5: return fade;
+    case 6: return mix;
+    default: return 0.0f;
+    }
+}
+
+dsp256::String ReverbReverse::getParameterDisplay(int parameterIndex) const
+{
+    switch (parameterIndex) {
+    case 0: return dsp256::String(50.0f * std::pow(20.0f, segmentLength), 0) + " ms";
+    case 1: return hall.getParameterDisplay(1);
+    case 2: return hall.getParameterDisplay(5);
+    case 3: return hall.getParameterDisplay(3);
+    case 4: return dsp256::String(swell * 100.0f, 0) + "%";
+    case 5: return dsp256::String(1.0f + fade * 49.0f, 1) + " ms";
+    case 6: return dsp256::String(mix * 100.0f, 0) + "%";
+    default: return "";
+    }
+}
+
+void ReverbReverse::updateParameters()
+{
+    validateParameters();
+
+    hall.setParameter(1, decayTime);
+    hall.setParameter(3, damping);
+    hall.setParameter(5, size);
+
+    // New length takes effect at the next segment boundary
+    const float seconds = 0.05f * std::pow(20.0f, segmentLength);
+    pendingLength = dsp256::jlimit(1, latencySamples,
+        static_cast<int>(seconds * static_cast<float>(sampleRate)));
+
+    fadeSamples = dsp256::jmax(1.0f, (1.0f + fade * 49.0f) * 0.001f * static_cast<float>(sampleRate));
+
+    buildSwellTable();
+}
+
+void ReverbReverse::buildSwellTable()
+{
+    // Rising curve x^(3 * swell): flat at 0, steep late bloom at 1
+    const float exponent = swell * 3.0f;
+    for (int i = 0; i <= SWELL_TABLE_SIZE; ++i) {
+        const float x = static_cast<float>(i) / static_cast<float>(SWELL_TABLE_SIZE);
+        swellTable[static_cast<size_t>(i)] = std::pow(x, exponent);
+    }
+}
+
+//==============================================================================
+void ReverbReverse::process(FixedPointSample& left, FixedPointSample& right,
+    DelayMemoryPool& delayPool, FixedPointEngine& dspCore)
+{
+    const float inL = dspCore.Q12ToFloat(left);
+    const float inR = dspCore.Q12ToFloat(right);
+
+    FixedPointSample wetL = left;
+    FixedPointSample wetR = right;
+    hall.process(wetL, wetR, delayPool, dspCore);
+
+    // Record continuously; each segment start is queued for the playback timeline
+    const int historySize = static_cast<int>(historyL.size());
+    historyL[static_cast<size_t>(historyWriteIndex)] = dspCore.Q12ToFloat(wetL);
+    historyR[static_cast<size_t>(historyWriteIndex)] = dspCore.Q12ToFloat(wetR);
+
+    if (position == 0 && queueCount < MAX_QUEUED_SEGMENTS) {
+        queuedLengths[static_cast<size_t>((queueRead + queueCount) % MAX_QUEUED_SEGMENTS)] = recordLength;
+        ++queueCount;
+    }
+
+    // Play each segment backwards one latency after it started recording. A
+    // segment that started at s with length n plays from s + latency on, reading
+    // s + n - 1 down to s, so it has always finished recording by then.
+    float reversedL = 0.0f;
+    float reversedR = 0.0f;
+    if (playStartDelay > 0) {
+        --playStartDelay;
+    } else if (playPosition > 0 || queueCount > 0) {
+        if (playPosition == 0) {
+            playLength = queuedLengths[static_cast<size_t>(queueRead)];
+            queueRead = (queueRead + 1) % MAX_QUEUED_SEGMENTS;
+            --queueCount;
+        }
+
+        int readPos = historyWriteIndex - latencySamples + playLength - 1 - 2 * playPosition;
+        if (readPos < 0)
+            readPos += historySize;
+
+        const float tablePos = static_cast<float>(playPosition) / static_cast<float>(playLength)
+            * static_cast<float>(SWELL_TABLE_SIZE);
+        const int tableIndex = static_cast<int>(tablePos);
+        const float frac = tablePos - static_cast<float>(tableIndex);
+        const float swellGain = swellTable[static_cast<size_t>(tableIndex)]
+            + (swellTable[static_cast<size_t>(tableIndex) + 1] - swellTable[static_cast<size_t>(tableIndex)]) * frac;
+
+        const float edgeGain = dsp256::jmin(1.0f,
+            static_cast<float>(playPosition + 1) / fadeSamples,
+            static_cast<float>(playLength - playPosition) / fadeSamples);
+
+        reversedL = historyL[static_cast<size_t>(readPos)] * swellGain * edgeGain;
+        reversedR = historyR[static_cast<size_t>(readPos)] * swellGain * edgeGain;
+
+        if (++playPosition >= playLength)
+            playPosition = 0;
+    }
+    historyWriteIndex = (historyWriteIndex + 1) % historySize;
+
+    // Dry path delayed by the fixed latency
+    const int drySize = static_cast<int>(dryDelayL.size());
+    dryDelayL[static_cast<size_t>(dryWriteIndex)] = inL;
+    dryDelayR[static_cast<size_t>(dryWriteIndex)] = inR;
+    const size_t dryRead = static_cast<size_t>((dryWriteIndex - latencySamples + drySize) % drySize);
+    const float dryL = dryDelayL[dryRead];
+    const float dryR = dryDelayR[dryRead];
+    dryWriteIndex = (dryWriteIndex + 1) % drySize;
+
+    const float outL = dryL * (1.0f - mix) + reversedL * mix;
+    const float outR = dryR * (1.0f - mix) + reversedR * mix;
+
+    left = dspCore.floatToQ12(outL);
+    right = dspCore.floatToQ12(outR);
+
+    // Segment boundary: pick up any pending length change
+    if (++position >= recordLength) {
+        position = 0;
+        recordLength = pendingLength;
+    }
+}
+
+void ReverbReverse::updateModulation(int blockCounter)
+{
+    hall.updateModulation(blockCounter);
+}
+
+dsp256::String ReverbReverse::getRealtimeDisplayInfo() const
+{
+    return dsp256::String::formatted("Segment: %.0f ms  Latency: %d smp",
+        1000.0 * recordLength / sampleRate, latencySamples);
+}
+
+void ReverbReverse::validateParameters()
+{
+    segmentLength = dsp256::jlimit(0.0f, 1.0f, segmentLength);
+    decayTime = dsp256::jlimit(0.0f, 1.0f, decayTime);
+    size = dsp256::jlimit(0.0f, 1.0f, size);
+    damping = dsp256::jlimit(0.0f, 1.0f, damping);
+    swell = dsp256::jlimit(0.0f, 1.0f, swell);
+    fade = dsp256::jlimit(0.0f, 1.0f, fade);
+    mix = dsp256::jlimit(0.0f, 1.0f, mix);
+}
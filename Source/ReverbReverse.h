@@ -0,0 +1,121 @@
+// ReverbReverse.h - Reverse Reverb Effect Module
+#pragma once
+
+#include "EffectModule.h"
+#include "FixedPointDSP.h"
+#include "DelayMemoryPool.h"
+#include "ReverbHall.h"
+#include <array>
+#include <vector>
+
+//==============================================================================
+// Reverse Reverb Effect Module
+// The hall network's wet output is recorded continuously and cut into
+// segments; each segment plays backwards through a swell envelope exactly one
+// maximum segment (1 s) after it started recording. Shorter segments are
+// thereby padded out, so the reported latency and the dry alignment never move
+// when the length changes. Buffers are sized for the longest segment in
+// prepare(), so changing the length never allocates.
+//==============================================================================
+class ReverbReverse : public EffectModule {
+public:
+    ReverbReverse();
+    ~ReverbReverse() override = default;
+
+    // Module identification
+    dsp256::String getModuleName() const override { return "Reverb Reverse"; }
+    dsp256::String getModuleDescription() const override {
+        return "Reversed hall tail that swells into each note.";
+    }
+
+    // Parameter configuration
+    std::vector<EffectParameter> getParameterDefinitions() const override;
+    int getParameterCount() const override { return 7; }
+
+    // Preset management
+    std::vector<EffectPreset> getFactoryPresets() const override;
+    void loadPreset(const EffectPreset& preset) override;
+    EffectPreset getCurrentPreset() const override;
+
+    // DSP lifecycle
+    void prepare(double sampleRate, int samplesPerBlock) override;
+    void reset() override;
+    void releaseResources() override;
+    int getLatencySamples() const override { return latencySamples; }
+
+    // Parameter updates
+    void setParameter(int parameterIndex, float value) override;
+    float getParameter(int parameterIndex) const override;
+    dsp256::String getParameterDisplay(int parameterIndex) const override;
+
+    // Audio processing
+    void process(FixedPointSample& left, FixedPointSample& right,
+        DelayMemoryPool& delayPool, FixedPointEngine& dspCore) override;
+
+    // Modulation updates (forwarded to the hall)
+    void updateModulation(int blockCounter) override;
+
+    // Real-time display
+    bool hasRealtimeDisplay() const override { return true; }
+    dsp256::String getRealtimeDisplayInfo() const override;
+    float getTailLevel() const override { return hall.getTailLevel(); }
+
+private:
+    // Parameters (0.0 to 1.0 normalized)
+    float segmentLength = 0.45f;  // Segment: 50-1000 ms
+    float decayTime = 0.6f;       // Hall decay (forwarded)
+    float size = 0.7f;            // Hall size (forwarded)
+    float damping = 0.4f;         // Hall damping (forwarded)
+    float swell = 0.5f;           // Swell curve: 0 = flat, 1 = steep
+    float fade = 0.2f;            // Segment edge fade: 1-50 ms
+    float mix = 0.6f;             // Dry/Wet Mix: 0-100%
+
+    static constexpr float MAX_SEGMENT_SECONDS = 1.0f;
+    static constexpr int SWELL_TABLE_SIZE = 256;
+
+    // Reverb network, run 100% wet
+    ReverbHall hall;
+
+    // Most segments that can start within one latency (50 ms minimum vs 1 s)
+    static constexpr int MAX_QUEUED_SEGMENTS = 32;
+
+    // Wet history (stereo), two latencies long; sized once in prepare()
+    std::vector<float> historyL;
+    std::vector<float> historyR;
+    int historyWriteIndex = 0;
+    int latencySamples = 1;       // One maximum segment, fixed per sample rate
+
+    // Recording timeline
+    int position = 0;             // Position within the segment being recorded
+    int recordLength = 1;         // Length of the segment being recorded
+    int pendingLength = 1;        // Requested length, applied at the next boundary
+
+    // Playback timeline: the recording one, latencySamples later
+    std::array<int, MAX_QUEUED_SEGMENTS> queuedLengths{};
+    int queueRead = 0;
+    int queueCount = 0;
+    int playStartDelay = 0;       // Silence before the first segment comes round
+    int playPosition = 0;
+    int playLength = 0;
+
+    // Dry path delayed by the reported latency
+    std::vector<float> dryDelayL;
+    std::vector<float> dryDelayR;
+    int dryWriteIndex = 0;
+
+    // Swell envelope over a segment (0..1 position)
+    std::array<float, SWELL_TABLE_SIZE + 1> swellTable{};
+    float fadeSamples = 1.0f;
+
+    // Sample rate and block size
+    double sampleRate = 44100.0;
+    int blockSize = 512;
+
+    // Helper methods
+    void updateParameters();
+    void allocateBuffers();
+    void buildSwellTable();
+
+    // Parameter validation
+    void validateParameters();
+};
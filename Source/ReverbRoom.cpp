@@ -0,0 +1,645 @@
+// ReverbRoom.cpp - Room Reverb Implementation
+#include "ReverbRoom.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+constexpr float SPEED_OF_SOUND = 343.0f;
+
+struct Vec3 {
+    float x, y, z;
+};
+
+// Image of a source at s in [0, L] after n reflections along one axis
+float imageCoordinate(int n, float roomSize, float s)
+{
+    return (n % 2 == 0) ? static_cast<float>(n) * roomSize + s
+                        : static_cast<float>(n + 1) * roomSize - s;
+}
+
+float distanceBetween(const Vec3& a, const Vec3& b)
+{
+    const float dx = a.x - b.x;
+    const float dy = a.y - b.y;
+    const float dz = a.z - b.z;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+} // namespace
+
+//==============================================================================
+// One thread builds tap tables for every ReverbRoom. It polls each registered
+// instance's requested key, builds through one cache (tables are in seconds,
+// so every sample rate shares them) and publishes into that instance's triple
+// buffer. Instances register on construction; the thread starts with the
+// first prepare() (the audio thread can't start it) and stops when the last
+// instance goes away, so probes that are never prepared cost no thread.
+//==============================================================================
+class ReverbRoom::TapWorker {
+public:
+    static TapWorker& getInstance()
+    {
+        static TapWorker instance;
+        return instance;
+    }
+
+    ~TapWorker() { stop(); }
+
+    void add(ReverbRoom& room)
+    {
+        const std::lock_guard<std::mutex> sl(roomsLock);
+        rooms.push_back(&room);
+    }
+
+    // Once this returns the worker no longer touches 'room'
+    void remove(ReverbRoom& room)
+    {
+        const std::lock_guard<std::mutex> lifecycle(lifecycleLock);
+        bool empty = false;
+        {
+            const std::lock_guard<std::mutex> sl(roomsLock);
+            rooms.erase(std::remove(rooms.begin(), rooms.end(), &room), rooms.end());
+            empty = rooms.empty();
+        }
+        if (empty)
+            stopThread();
+    }
+
+    void start()
+    {
+        const std::lock_guard<std::mutex> lifecycle(lifecycleLock);
+        if (thread.joinable())
+            return;
+        running.store(true, std::memory_order_release);
+        thread = std::thread([this] { run(); });
+    }
+
+private:
+    static constexpr int POLL_MS = 5;
+
+    TapWorker() = default;
+
+    void stop()
+    {
+        const std::lock_guard<std::mutex> lifecycle(lifecycleLock);
+        stopThread();
+    }
+
+    void stopThread()
+    {
+        running.store(false, std::memory_order_release);
+        if (thread.joinable())
+            thread.join();
+    }
+
+    void run()
+    {
+        while (running.load(std::memory_order_acquire)) {
+            bool published = false;
+            {
+                const std::lock_guard<std::mutex> sl(roomsLock);
+                for (auto* room : rooms)
+                    published = serve(*room) || published;
+            }
+            if (!published)
+                std::this_thread::sleep_for(std::chrono::milliseconds(POLL_MS));
+        }
+    }
+
+    bool serve(ReverbRoom& room)
+    {
+        const uint64_t key = room.requestedKey.load(std::memory_order_acquire);
+        if (key == room.builtKey)
+            return false;
+
+        auto cached = cache.find(key);
+        if (cached == cache.end()) {
+            if (cache.size() >= MAX_CACHED_TABLES)
+                cache.clear();
+            TapTable table;
+            buildTapTable(key, table);
+            cached = cache.emplace(key, table).first;
+        }
+
+        // Publish: fill the back slot, then swap it into the middle
+        room.slots[static_cast<size_t>(room.backSlot)] = cached->second;
+        room.backSlot = room.sharedSlot.exchange(room.backSlot | FRESH_FLAG, std::memory_order_acq_rel) & ~FRESH_FLAG;
+        room.builtKey = key;
+        return true;
+    }
+
+    std::mutex lifecycleLock;         // start()/remove(): message thread
+    std::mutex roomsLock;             // Held by the worker while it serves
+    std::vector<ReverbRoom*> rooms;
+    std::thread thread;
+    std::atomic<bool> running{ false };
+    std::unordered_map<uint64_t, TapTable> cache;
+};
+
+//==============================================================================
+ReverbRoom::ReverbRoom()
+{
+    sampleRate = 44100.0;
+
+    // Late tail only: the image-source model supplies the early reflections
+    hall.setParameter(0, 0.0f);    // Pre-delay
+    hall.setParameter(2, 0.8f);    // Diffusion
+    hall.setParameter(4, 0.0f);    // Early reflections
+    hall.setParameter(6, 1.0f);    // Fully wet
+
+    // The hall only renders FOA for this module; its stereo path is unaffected
+    OutputLayout foaLayout;
+    foaLayout.numChannels = FoaEncoder::NUM_CHANNELS;
+    foaLayout.ambisonic = true;
+    hall.setOutputLayout(foaLayout);
+
+    allocateBuffer();
+    updateParameters();
+
+    // First table is built synchronously so audio never starts without taps
+    builtKey = requestedKey.load();
+    buildTapTable(builtKey, currentTaps);
+    convertToSamples(currentTaps);
+    previousTaps = currentTaps;
+    offlineKey = builtKey;
+
+    reset();
+
+    TapWorker::getInstance().add(*this);
+}
+
+ReverbRoom::~ReverbRoom()
+{
+    TapWorker::getInstance().remove(*this);
+}
+
+//==============================================================================
+std::vector<EffectParameter> ReverbRoom::getParameterDefinitions() const
+{
+    return {
+        EffectParameter("length", "Room Length", "LENGTH", "m", 2.0f, 30.0f, 7.7f, 0.1f, true),
+        EffectParameter("width", "Room Width", "WIDTH", "m", 2.0f, 30.0f, 5.9f, 0.1f, true),
+        EffectParameter("height", "Room Height", "HEIGHT", "m", 2.0f, 10.0f, 3.2f, 0.1f, true),
+        EffectParameter("source", "Source Position", "SOURCE", "%", 0.0f, 100.0f, 40.0f, 0.1f, false),
+        EffectParameter("distance", "Source Distance", "DIST", "%", 0.0f, 100.0f, 40.0f, 0.1f, false),
+        EffectParameter("absorption", "Wall Absorption", "ABSORB", "%", 2.0f, 90.0f, 28.4f, 0.1f, false),
+        EffectParameter("mix", "Dry/Wet Mix", "MIX", "%", 0.0f, 100.0f, 40.0f, 0.1f, false)
+    };
+}
+
+//==============================================================================
+std::vector<EffectPreset> ReverbRoom::getFactoryPresets() const
+{
+    return {
+        EffectPreset("Studio Room", "Medium live room", {0.5f, 0.4f, 0.3f, 0.4f, 0.4f, 0.3f, 0.4f}),
+        EffectPreset("Vocal Booth", "Small, dead booth", {0.1f, 0.1f, 0.1f, 0.5f, 0.2f, 0.8f, 0.3f}),
+        EffectPreset("Tiled Bathroom", "Small, hard walls", {0.15f, 0.12f, 0.15f, 0.3f, 0.5f, 0.05f, 0.45f}),
+        EffectPreset("Drum Room", "Large room, kit off-centre", {0.7f, 0.6f, 0.5f, 0.3f, 0.6f, 0.25f, 0.5f}),
+        EffectPreset("Empty Warehouse", "Huge, reflective", {0.95f, 0.85f, 0.8f, 0.6f, 0.7f, 0.1f, 0.55f})
+    };
+}
+
+void ReverbRoom::loadPreset(const EffectPreset& preset)
+{
+    if (preset.parameterValues.size() >= 7) {
+        roomLength = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[0]);
+        roomWidth = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[1]);
+        roomHeight = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[2]);
+        sourceX = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[3]);
+        distance = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[4]);
+        absorption = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[5]);
+        mix = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[6]);
+        updateParameters();
+    }
+}
+
+EffectPreset ReverbRoom::getCurrentPreset() const
+{
+    return EffectPreset("Current Settings", "Current room reverb parameters",
+        { roomLength, roomWidth, roomHeight, sourceX, distance, absorption, mix });
+}
+
+void ReverbRoom::prepare(double sr, int samplesPerBlock)
+{
+    sampleRate = sr;
+    blockSize = samplesPerBlock;
+    allocateBuffer();
+    convertToSamples(currentTaps);
+    convertToSamples(previousTaps);
+    updateParameters();
+    hall.prepare(sr, samplesPerBlock);
+    reset();
+
+    TapWorker::getInstance().start();
+}
+
+void ReverbRoom::allocateBuffer()
+{
+    // The only allocation: room for the longest tap at this sample rate
+    const int maxSamples = static_cast<int>(std::ceil(MAX_TAP_SECONDS * sampleRate)) + 1;
+    const int size = dsp256::nextPowerOfTwo(maxSamples);
+    erBuffer.assign(static_cast<size_t>(size), 0.0f);
+    erMask = size - 1;
+}
+
+void ReverbRoom::reset()
+{
+    hall.reset();
+    std::fill(erBuffer.begin(), erBuffer.end(), 0.0f);
+    erWriteIndex = 0;
+    dcOffsetState = 0.0f;
+
+    // Drop any crossfade in flight
+    previousTaps = currentTaps;
+    crossfadePosition = CROSSFADE_SAMPLES;
+}
+
+void ReverbRoom::releaseResources()
+{
+    hall.releaseResources();
+}
+
+void ReverbRoom::setParameter(int parameterIndex, float value)
+{
+    value = dsp256::jlimit(0.0f, 1.0f, value);
+    if (getParameter(parameterIndex) == value)
+        return;
+
+    switch (parameterIndex) {
+    case 0: roomLength = value; break;
+    case 1: roomWidth = value; break;
+    case 2: roomHeight = value; break;
+    case 3: sourceX = value; break;
+    case 4: distance = value; break;
+    case 5: absorption = value; break;
+    case 6: mix = value; break;
+    }
+    updateParameters();
+}
+
+float ReverbRoom::getParameter(int parameterIndex) const
+{
+    switch (parameterIndex) {
+    case 0: return roomLength;
+    case 1: return roomWidth;
+    case 2: return roomHeight;
+    case 3: return sourceX;
+    case 4: return distance;
+    case 5: return absorption;
+    case 6: return mix;
+    default: return 0.0f;
+    }
+}
+
+dsp256::String ReverbRoom::getParameterDisplay(int parameterIndex) const
+{
+    switch (parameterIndex) {
+    case 0: return dsp256::String(2.0f * std::pow(15.0f, roomLength), 1) + " m";
+    case 1: return dsp256::String(2.0f * std::pow(15.0f, roomWidth), 1) + " m";
+    case 2: return dsp256::String(2.0f * std::pow(5.0f, roomHeight), 1) + " m";
+    case 3: return dsp256::String(sourceX * 100.0f, 0) + "%";
+    case 4: return dsp256::String(distance * 100.0f, 0) + "%";
+    case 5: return dsp256::String(2.0f + absorption * 88.0f, 0) + "%";
+    case 6: return dsp256::String(mix * 100.0f, 0) + "%";
+    default: return "";
+    }
+}
+
+std::array<float, 6> ReverbRoom::geometryParameters() const
+{
+    return { roomLength, roomWidth, roomHeight, sourceX, distance, absorption };
+}
+
+void ReverbRoom::updateParameters()
+{
+    validateParameters();
+
+    // Hand the geometry to the worker; the audio thread never waits for it
+    const uint64_t geometryKey = packGeometry(geometryParameters());
+    requestedKey.store(geometryKey, std::memory_order_release);
+    if (nonRealtime)
+        buildOfflineTapTable(geometryKey);
+
+    // Sabine RT60 drives the late tail
+    const float length = 2.0f * std::pow(15.0f, roomLength);
+    const float width = 2.0f * std::pow(15.0f, roomWidth);
+    const float height = 2.0f * std::pow(5.0f, roomHeight);
+    const float alpha = 0.02f + absorption * 0.88f;
+
+    const float volume = length * width * height;
+    const float surface = 2.0f * (length * width + length * height + width * height);
+    sabineRT60 = dsp256::jlimit(0.1f, 10.0f, 0.161f * volume / (surface * alpha));
+
+    hall.setParameter(1, std::log10(sabineRT60 / 0.1f) * 0.5f);
+    hall.setParameter(3, 0.2f + absorption * 0.6f);
+    hall.setParameter(5, dsp256::jlimit(0.0f, 1.0f, (std::cbrt(volume) - 2.0f) / 18.0f));
+}
+
+//==============================================================================
+// Geometry key: six parameters quantized to GEOMETRY_BITS each. The key is
+// both the cache hash and the message from the audio thread to the worker.
+uint64_t ReverbRoom::packGeometry(const std::array<float, 6>& normalized)
+{
+    constexpr uint64_t steps = (uint64_t(1) << GEOMETRY_BITS) - 1;
+    uint64_t key = 0;
+    for (size_t i = 0; i < normalized.size(); ++i) {
+        const uint64_t q = static_cast<uint64_t>(std::lround(normalized[i] * static_cast<float>(steps)));
+        key |= (q & steps) << (i * GEOMETRY_BITS);
+    }
+    return key;
+}
+
+void ReverbRoom::buildTapTable(uint64_t geometryKey, TapTable& table)
+{
+    constexpr uint64_t steps = (uint64_t(1) << GEOMETRY_BITS) - 1;
+    auto field = [geometryKey](int i) {
+        return static_cast<float>((geometryKey >> (i * GEOMETRY_BITS)) & steps) / static_cast<float>(steps);
+    };
+
+    // Shoebox: x across the width, y along the length, z up
+    const float length = 2.0f * std::pow(15.0f, field(0));
+    const float width = 2.0f * std::pow(15.0f, field(1));
+    const float height = 2.0f * std::pow(5.0f, field(2));
+    const float alpha = 0.02f + field(5) * 0.88f;
+    const float reflection = std::sqrt(1.0f - alpha);
+
+    // Listener centred, a quarter of the way in; source between listener and far wall
+    const Vec3 listener { 0.5f * width, 0.25f * length, dsp256::jmin(1.2f, 0.5f * height) };
+    const float nearY = listener.y + 0.5f;
+    const float farY = 0.95f * length;
+    const Vec3 source { width * (0.05f + 0.9f * field(3)),
+                        nearY + field(4) * (farY - nearY),
+                        dsp256::jmin(1.5f, 0.6f * height) };
+
+    const float directDistance = dsp256::jmax(0.1f, distanceBetween(source, listener));
+
+    int count = 0;
+    for (int nx = -MAX_ORDER; nx <= MAX_ORDER; ++nx) {
+        for (int ny = -MAX_ORDER; ny <= MAX_ORDER; ++ny) {
+            for (int nz = -MAX_ORDER; nz <= MAX_ORDER; ++nz) {
+                const int order = std::abs(nx) + std::abs(ny) + std::abs(nz);
+                if (order == 0 || order > MAX_ORDER || count >= MAX_TAPS)
+                    continue;
+
+                const Vec3 image { imageCoordinate(nx, width, source.x),
+                                   imageCoordinate(ny, length, source.y),
+                                   imageCoordinate(nz, height, source.z) };
+                const float d = distanceBetween(image, listener);
+
+                // Delay relative to the direct path, which is the dry signal
+                Tap& tap = table.taps[static_cast<size_t>(count++)];
+                tap.delaySeconds = dsp256::jmin(MAX_TAP_SECONDS, (d - directDistance) / SPEED_OF_SOUND);
+                tap.delaySamples = 0;
+
+                const float gain = std::pow(reflection, static_cast<float>(order)) * directDistance / d;
+
+                // Constant-power pan from the horizontal arrival angle
+                const float dx = image.x - listener.x;
+                const float dy = image.y - listener.y;
+                const float dz = image.z - listener.z;
+                const float pan = dx / dsp256::jmax(1.0e-3f, std::sqrt(dx * dx + dy * dy));
+                const float angle = (pan + 1.0f) * dsp256::MathConstants<float>::pi * 0.25f;
+                tap.gainL = gain * std::cos(angle);
+                tap.gainR = gain * std::sin(angle);
+
+                // FOA: the listener faces +y, so left is -x and up is +z
+                const auto direction = FoaEncoder::fromVector(dy, -dx, dz);
+                for (size_t c = 0; c < tap.foa.size(); ++c)
+                    tap.foa[c] = gain * direction[c];
+            }
+        }
+    }
+    table.numTaps = count;
+
+    // Ascending delay keeps the multi-tap reads walking one way through memory
+    std::sort(table.taps.begin(), table.taps.begin() + count,
+        [](const Tap& a, const Tap& b) { return a.delaySeconds < b.delaySeconds; });
+}
+
+void ReverbRoom::convertToSamples(TapTable& table) const
+{
+    const float fs = static_cast<float>(sampleRate);
+    for (int i = 0; i < table.numTaps; ++i) {
+        Tap& tap = table.taps[static_cast<size_t>(i)];
+        tap.delaySamples = dsp256::jlimit(1, erMask, static_cast<int>(tap.delaySeconds * fs + 0.5f));
+    }
+}
+
+//==============================================================================
+void ReverbRoom::pickUpTapTable()
+{
+    // Let a running crossfade finish; the newest table waits in the middle slot
+    if (crossfadePosition < CROSSFADE_SAMPLES)
+        return;
+
+    if (nonRealtime) {
+        if (!offlineTapsFresh)
+            return;
+        previousTaps = currentTaps;
+        currentTaps = offlineTaps;
+        offlineTapsFresh = false;
+    }
+    else {
+        if ((sharedSlot.load(std::memory_order_acquire) & FRESH_FLAG) == 0)
+            return;
+
+        frontSlot = sharedSlot.exchange(frontSlot, std::memory_order_acq_rel) & ~FRESH_FLAG;
+
+        previousTaps = currentTaps;
+        currentTaps = slots[static_cast<size_t>(frontSlot)];
+    }
+
+    convertToSamples(currentTaps);
+    crossfadePosition = 0;
+}
+
+void ReverbRoom::setNonRealtime(bool isNonRealtime)
+{
+    nonRealtime = isNonRealtime;
+
+    // Whatever the worker had not delivered yet is built now instead
+    if (nonRealtime)
+        buildOfflineTapTable(requestedKey.load(std::memory_order_acquire));
+}
+
+// Same table the worker would build (without its cache), on the calling thread
+void ReverbRoom::buildOfflineTapTable(uint64_t geometryKey)
+{
+    if (geometryKey == offlineKey)
+        return;
+
+    buildTapTable(geometryKey, offlineTaps);
+    offlineKey = geometryKey;
+    offlineTapsFresh = true;
+}
+
+void ReverbRoom::accumulateTaps(const TapTable& table, float gain, float& outL, float& outR) const
+{
+    const float* buffer = erBuffer.data();
+    float sumL = 0.0f;
+    float sumR = 0.0f;
+    for (int i = 0; i < table.numTaps; ++i) {
+        const Tap& tap = table.taps[static_cast<size_t>(i)];
+        const float x = buffer[(erWriteIndex - tap.delaySamples) & erMask];
+        sumL += x * tap.gainL;
+        sumR += x * tap.gainR;
+    }
+    outL += sumL * gain;
+    outR += sumR * gain;
+}
+
+Float4 ReverbRoom::accumulateTapsFoa(const TapTable& table, Float4 acc) const
+{
+    const float* buffer = erBuffer.data();
+    for (int i = 0; i < table.numTaps; ++i) {
+        const Tap& tap = table.taps[static_cast<size_t>(i)];
+        const Float4 x = Float4::broadcast(buffer[(erWriteIndex - tap.delaySamples) & erMask]);
+        acc = Float4::mulAdd(Float4::load(tap.foa.data()), x, acc);
+    }
+    return acc;
+}
+
+//==============================================================================
+void ReverbRoom::process(FixedPointSample& left, FixedPointSample& right,
+    DelayMemoryPool& delayPool, FixedPointEngine& dspCore)
+{
+    const float inL = dspCore.Q12ToFloat(left);
+    const float inR = dspCore.Q12ToFloat(right);
+
+    FixedPointSample monoFP = dspCore.floatToQ12((inL + inR) * 0.5f);
+    monoFP = dspCore.dcBlock(monoFP, dcOffsetState);
+
+    erBuffer[static_cast<size_t>(erWriteIndex)] = dspCore.Q12ToFloat(monoFP);
+
+    // Early reflections, crossfading from the previous table after a swap
+    float erL = 0.0f;
+    float erR = 0.0f;
+    if (crossfadePosition < CROSSFADE_SAMPLES) {
+        const float fade = static_cast<float>(crossfadePosition) / static_cast<float>(CROSSFADE_SAMPLES);
+        accumulateTaps(currentTaps, fade, erL, erR);
+        accumulateTaps(previousTaps, 1.0f - fade, erL, erR);
+        ++crossfadePosition;
+    }
+    else {
+        accumulateTaps(currentTaps, 1.0f, erL, erR);
+    }
+
+    erWriteIndex = (erWriteIndex + 1) & erMask;
+
+    // Late tail grows out of the reflections
+    FixedPointSample lateL = dspCore.floatToQ12(erL);
+    FixedPointSample lateR = dspCore.floatToQ12(erR);
+    hall.process(lateL, lateR, delayPool, dspCore);
+
+    const float wetL = erL + dspCore.Q12ToFloat(lateL);
+    const float wetR = erR + dspCore.Q12ToFloat(lateR);
+
+    const float outL = inL * (1.0f - mix) + wetL * mix;
+    const float outR = inR * (1.0f - mix) + wetR * mix;
+
+    left = dspCore.floatToQ12(outL);
+    right = dspCore.floatToQ12(outR);
+}
+
+//==============================================================================
+bool ReverbRoom::supportsOutputLayout(const OutputLayout& layout) const
+{
+    return layout.numChannels == 2
+        || (layout.ambisonic && layout.numChannels == FoaEncoder::NUM_CHANNELS);
+}
+
+void ReverbRoom::setOutputLayout(const OutputLayout& layout)
+{
+    outputLayout = layout;
+}
+
+void ReverbRoom::processBlockMultichannel(float* const* channels, int numChannels, int numSamples,
+    DelayMemoryPool& delayPool, FixedPointEngine& dspCore)
+{
+    if (!outputLayout.ambisonic || numChannels != FoaEncoder::NUM_CHANNELS) {
+        processBlock(channels[0], channels[1], numSamples, delayPool, dspCore);
+        return;
+    }
+
+    for (int start = 0; start < numSamples; start += FOA_CHUNK) {
+        const int count = dsp256::jmin(FOA_CHUNK, numSamples - start);
+
+        // Early reflections, direction-encoded per tap
+        for (int i = 0; i < count; ++i) {
+            const float inL = dspCore.Q12ToFloat(dspCore.floatToQ12(channels[0][start + i]));
+            const float inR = dspCore.Q12ToFloat(dspCore.floatToQ12(channels[1][start + i]));
+
+            FixedPointSample monoFP = dspCore.floatToQ12((inL + inR) * 0.5f);
+            monoFP = dspCore.dcBlock(monoFP, dcOffsetState);
+            erBuffer[static_cast<size_t>(erWriteIndex)] = dspCore.Q12ToFloat(monoFP);
+
+            Float4 early = accumulateTapsFoa(currentTaps, Float4::broadcast(0.0f));
+            if (crossfadePosition < CROSSFADE_SAMPLES) {
+                const float fade = static_cast<float>(crossfadePosition) / static_cast<float>(CROSSFADE_SAMPLES);
+                const Float4 previous = accumulateTapsFoa(previousTaps, Float4::broadcast(0.0f));
+                early = early * Float4::broadcast(fade) + previous * Float4::broadcast(1.0f - fade);
+                ++crossfadePosition;
+            }
+
+            erWriteIndex = (erWriteIndex + 1) & erMask;
+
+            float lanes[4];
+            early.store(lanes);
+            for (size_t c = 0; c < 4; ++c)
+                foaEarly[c][static_cast<size_t>(i)] = lanes[c];
+
+            // The hall hears the omni (W) reflections
+            foaLate[0][static_cast<size_t>(i)] = lanes[0];
+            foaLate[1][static_cast<size_t>(i)] = lanes[0];
+            foaLate[2][static_cast<size_t>(i)] = 0.0f;
+            foaLate[3][static_cast<size_t>(i)] = 0.0f;
+        }
+
+        // Late tail, diffuse-encoded by the hall
+        float* late[4] = { foaLate[0].data(), foaLate[1].data(), foaLate[2].data(), foaLate[3].data() };
+        hall.processBlockMultichannel(late, FoaEncoder::NUM_CHANNELS, count, delayPool, dspCore);
+
+        // Dry encoded at +/-30 degrees, then mixed with early + late
+        for (int i = 0; i < count; ++i) {
+            const size_t n = static_cast<size_t>(i);
+            const float inL = dspCore.Q12ToFloat(dspCore.floatToQ12(channels[0][start + i]));
+            const float inR = dspCore.Q12ToFloat(dspCore.floatToQ12(channels[1][start + i]));
+            const float dry[4] = { inL + inR, (inL - inR) * FoaEncoder::STEREO_SIN,
+                                   0.0f, (inL + inR) * FoaEncoder::STEREO_COS };
+
+            for (size_t c = 0; c < 4; ++c) {
+                const float out = dry[c] * (1.0f - mix) + (foaEarly[c][n] + foaLate[c][n]) * mix;
+                channels[c][start + i] = dspCore.Q12ToFloat(dspCore.floatToQ12(out));
+            }
+        }
+    }
+}
+
+void ReverbRoom::updateModulation(int blockCounter)
+{
+    pickUpTapTable();
+    hall.updateModulation(blockCounter);
+}
+
+dsp256::String ReverbRoom::getRealtimeDisplayInfo() const
+{
+    const float firstMs = currentTaps.numTaps > 0 ? currentTaps.taps[0].delaySeconds * 1000.0f : 0.0f;
+    return dsp256::String::formatted("ER: %.1f ms  Taps: %d  RT60: %.1fs",
+        firstMs, currentTaps.numTaps, sabineRT60);
+}
+
+void ReverbRoom::validateParameters()
+{
+    roomLength = dsp256::jlimit(0.0f, 1.0f, roomLength);
+    roomWidth = dsp256::jlimit(0.0f, 1.0f, roomWidth);
+    roomHeight = dsp256::jlimit(0.0f, 1.0f, roomHeight);
+    sourceX = dsp256::jlimit(0.0f, 1.0f, sourceX);
+    distance = dsp256::jlimit(0.0f, 1.0f, distance);
+    absorption = dsp256::jlimit(0.0f, 1.0f, absorption);
+    mix = dsp256::jlimit(0.0f, 1.0f, mix);
+}
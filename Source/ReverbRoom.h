@@ -0,0 +1,178 @@
+// ReverbRoom.h - Room Reverb Effect Module
+#pragma once
+
+#include "EffectModule.h"
+#include "FixedPointDSP.h"
+#include "DelayMemoryPool.h"
+#include "ReverbHall.h"
+#include "Ambisonics.h"
+#include "SimdLanes.h"
+#include <array>
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+// Room Reverb Effect Module
+// Early reflections come from a shoebox image-source model (room size,
+// source and listener position, wall absorption) and feed the hall network
+// for the late tail, with RT60 from Sabine's formula.
+//
+// Tap tables are built on one worker thread shared by every instance and
+// cached by a packed geometry key. The audio thread only publishes that key
+// and picks finished tables up through a lock-free triple buffer, crossfading
+// old and new taps, so moving the source or resizing the room never blocks
+// processing.
+//
+// In first-order AmbiX each tap also carries W/Y/Z/X gains for its arrival
+// direction, so encoding is one Float4 multiply-add per tap; the hall tail is
+// diffuse-encoded.
+//==============================================================================
+class ReverbRoom : public EffectModule {
+public:
+    ReverbRoom();
+    ~ReverbRoom() override;
+
+    // Module identification
+    dsp256::String getModuleName() const override { return "Reverb Room"; }
+    dsp256::String getModuleDescription() const override {
+        return "Physical shoebox room with image-source early reflections.";
+    }
+
+    // Parameter configuration
+    std::vector<EffectParameter> getParameterDefinitions() const override;
+    int getParameterCount() const override { return 7; }
+
+    // Preset management
+    std::vector<EffectPreset> getFactoryPresets() const override;
+    void loadPreset(const EffectPreset& preset) override;
+    EffectPreset getCurrentPreset() const override;
+
+    // DSP lifecycle
+    void prepare(double sampleRate, int samplesPerBlock) override;
+    void reset() override;
+    void releaseResources() override;
+
+    // Parameter updates
+    void setParameter(int parameterIndex, float value) override;
+    float getParameter(int parameterIndex) const override;
+    dsp256::String getParameterDisplay(int parameterIndex) const override;
+
+    // Audio processing
+    void process(FixedPointSample& left, FixedPointSample& right,
+        DelayMemoryPool& delayPool, FixedPointEngine& dspCore) override;
+
+    // First-order ambisonic output (AmbiX) alongside stereo
+    bool supportsOutputLayout(const OutputLayout& layout) const override;
+    void setOutputLayout(const OutputLayout& layout) override;
+    void processBlockMultichannel(float* const* channels, int numChannels, int numSamples,
+        DelayMemoryPool& delayPool, FixedPointEngine& dspCore) override;
+
+    // Control rate: pick up new tap tables, forward hall modulation
+    void updateModulation(int blockCounter) override;
+
+    // Offline: tap tables are built in line instead of on the worker
+    void setNonRealtime(bool isNonRealtime) override;
+
+    // Real-time display
+    bool hasRealtimeDisplay() const override { return true; }
+    dsp256::String getRealtimeDisplayInfo() const override;
+    float getTailLevel() const override { return hall.getTailLevel(); }
+
+private:
+    // Parameters (0.0 to 1.0 normalized)
+    float roomLength = 0.5f;      // Length: 2-30 m (logarithmic)
+    float roomWidth = 0.4f;       // Width: 2-30 m (logarithmic)
+    float roomHeight = 0.3f;      // Height: 2-10 m (logarithmic)
+    float sourceX = 0.4f;         // Source position across the width: 0-100%
+    float distance = 0.4f;        // Source distance towards the far wall: 0-100%
+    float absorption = 0.3f;      // Wall absorption: 2-90%
+    float mix = 0.4f;             // Dry/Wet Mix: 0-100%
+
+    //==========================================================================
+    // Image-source tap tables
+    static constexpr int MAX_ORDER = 4;
+    static constexpr int MAX_TAPS = 128;           // Images with order 1..4
+    static constexpr int CROSSFADE_SAMPLES = 1024;
+    static constexpr int GEOMETRY_BITS = 10;       // Per parameter in the key
+    static constexpr size_t MAX_CACHED_TABLES = 256;
+    static constexpr float MAX_TAP_SECONDS = 0.5f;
+
+    struct Tap {
+        float delaySeconds = 0.0f;
+        float gainL = 0.0f;
+        float gainR = 0.0f;
+        std::array<float, 4> foa{};   // Distance/absorption gain x (W, Y, Z, X)
+        int delaySamples = 0;
+    };
+
+    struct TapTable {
+        std::array<Tap, MAX_TAPS> taps;
+        int numTaps = 0;
+    };
+
+    static uint64_t packGeometry(const std::array<float, 6>& normalized);
+    static void buildTapTable(uint64_t geometryKey, TapTable& table);
+    void convertToSamples(TapTable& table) const;
+    void accumulateTaps(const TapTable& table, float gain, float& outL, float& outR) const;
+    Float4 accumulateTapsFoa(const TapTable& table, Float4 acc) const;
+
+    // Shared worker (ReverbRoom.cpp): polls every registered instance's
+    // requested key and owns the table cache; never touched by the audio thread
+    class TapWorker;
+    uint64_t builtKey = 0;        // Worker thread, once registered
+
+    // Audio -> worker: latest requested geometry
+    std::atomic<uint64_t> requestedKey{ 0 };
+
+    // Worker -> audio: triple buffer. 'sharedSlot' holds the middle index,
+    // with FRESH_FLAG set when the worker has published a new table.
+    static constexpr int FRESH_FLAG = 4;
+    std::array<TapTable, 3> slots;
+    std::atomic<int> sharedSlot{ 1 };
+    int frontSlot = 0;            // Audio thread
+    int backSlot = 2;             // Worker thread
+
+    // Non-realtime mode: tables built on the audio thread when the geometry
+    // changes, picked up like the worker's but independent of its timing
+    bool nonRealtime = false;
+    uint64_t offlineKey = 0;
+    TapTable offlineTaps;
+    bool offlineTapsFresh = false;
+    void buildOfflineTapTable(uint64_t geometryKey);
+
+    // Audio-owned copies used by the multi-tap delay
+    TapTable currentTaps;
+    TapTable previousTaps;
+    int crossfadePosition = CROSSFADE_SAMPLES;
+
+    // Early reflection delay line (mono input, power-of-two size)
+    std::vector<float> erBuffer;
+    int erMask = 0;
+    int erWriteIndex = 0;
+
+    // FOA block scratch: early reflections and hall tail (W, Y, Z, X)
+    static constexpr int FOA_CHUNK = 256;
+    OutputLayout outputLayout;
+    std::array<std::array<float, FOA_CHUNK>, 4> foaEarly{};
+    std::array<std::array<float, FOA_CHUNK>, 4> foaLate{};
+
+    // Late tail
+    ReverbHall hall;
+    float sabineRT60 = 1.0f;
+
+    // DC offset filter state
+    float dcOffsetState = 0.0f;
+
+    // Sample rate and block size
+    double sampleRate = 44100.0;
+    int blockSize = 512;
+
+    // Helper methods
+    void updateParameters();
+    void allocateBuffer();
+    void pickUpTapTable();
+    std::array<float, 6> geometryParameters() const;
+
+    // Parameter validation
+    void validateParameters();
+};
@@ -0,0 +1,345 @@
+// RotarySpeaker.cpp - Rotary Speaker Implementation
+#include "RotarySpeaker.h"
+#include <cmath>
+
+//==============================================================================
+RotarySpeaker::RotarySpeaker()
+{
+    sampleRate = 44100.0;
+
+    // Stock motor figures (Leslie 122-style): horn ~0.8/6.7 Hz, drum ~0.7/5.7 Hz
+    horn.slowHz = 0.8f;
+    horn.fastHz = 6.7f;
+    horn.spinUpSeconds = 0.35f;
+    horn.brakeSeconds = 0.45f;
+
+    drum.slowHz = 0.67f;
+    drum.fastHz = 5.7f;
+    drum.spinUpSeconds = 1.8f;
+    drum.brakeSeconds = 2.2f;
+
+    buildRotorTables();
+    updateParameters();
+    reset();
+}
+
+//==============================================================================
+std::vector<EffectParameter> RotarySpeaker::getParameterDefinitions() const
+{
+    return {
+        EffectParameter("speed", "Rotor Speed", "SPEED", "Hz", 0.8f, 6.7f, 0.8f, 0.01f, false),
+        EffectParameter("accel", "Acceleration", "ACCEL", "x", 0.25f, 4.0f, 1.0f, 0.01f, true),
+        EffectParameter("xover", "Crossover", "XOVER", "Hz", 400.0f, 1600.0f, 800.0f, 1.0f, true),
+        EffectParameter("balance", "Horn/Drum Balance", "BAL", "%", 0.0f, 100.0f, 50.0f, 0.1f, false),
+        EffectParameter("doppler", "Doppler Depth", "DOPPLR", "%", 0.0f, 100.0f, 70.0f, 0.1f, false),
+        EffectParameter("spread", "Mic Spread", "SPREAD", "deg", 0.0f, 180.0f, 108.0f, 1.0f, false),
+        EffectParameter("mix", "Dry/Wet Mix", "MIX", "%", 0.0f, 100.0f, 100.0f, 0.1f, false)
+    };
+}
+
+//==============================================================================
+std::vector<EffectPreset> RotarySpeaker::getFactoryPresets() const
+{
+    return {
+        EffectPreset("Chorale", "Slow rotors, classic organ swirl", {0.0f, 0.5f, 0.5f, 0.5f, 0.7f, 0.6f, 1.0f}),
+        EffectPreset("Tremolo", "Fast rotors, full Doppler", {1.0f, 0.5f, 0.5f, 0.5f, 0.8f, 0.6f, 1.0f}),
+        EffectPreset("Lazy Motor", "Slow spin-up and long brake", {1.0f, 0.9f, 0.5f, 0.5f, 0.7f, 0.6f, 1.0f}),
+        EffectPreset("Horn Only", "Bright, fast horn sweep", {1.0f, 0.4f, 0.4f, 0.9f, 0.9f, 0.7f, 1.0f}),
+        EffectPreset("Wide Mics", "Mics at opposite sides", {0.0f, 0.5f, 0.5f, 0.5f, 0.6f, 1.0f, 1.0f}),
+        EffectPreset("Guitar Cab", "Subtle rotor blended with dry", {0.3f, 0.6f, 0.6f, 0.6f, 0.5f, 0.5f, 0.5f})
+    };
+}
+
+void RotarySpeaker::loadPreset(const EffectPreset& preset)
+{
+    if (preset.parameterValues.size() >= 7) {
+        speed = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[0]);
+        acceleration = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[1]);
+        crossover = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[2]);
+        balance = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[3]);
+        doppler = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[4]);
+        spread = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[5]);
+        mix = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[6]);
+        updateParameters();
+    }
+}
+
+EffectPreset RotarySpeaker::getCurrentPreset() const
+{
+    return EffectPreset("Current Settings", "Current rotary parameters",
+        { speed, acceleration, crossover, balance, doppler, spread, mix });
+}
+
+void RotarySpeaker::prepare(double sr, int samplesPerBlock)
+{
+    sampleRate = sr;
+    blockSize = samplesPerBlock;
+    hornDelay.prepare(sr);
+    drumDelay.prepare(sr);
+    updateParameters();
+    reset();
+}
+
+void RotarySpeaker::reset()
+{
+    for (auto& bq : lowPass) { bq.z1 = 0.0f; bq.z2 = 0.0f; }
+    for (auto& bq : highPass) { bq.z1 = 0.0f; bq.z2 = 0.0f; }
+
+    hornDelay.clear();
+    drumDelay.clear();
+
+    // Start settled at the selected speed rather than spinning up from rest
+    horn.phase = 0.0f;
+    drum.phase = 0.37f;
+    horn.rateHz = horn.targetHz;
+    drum.rateHz = drum.targetHz;
+
+    toneState = Float4::broadcast(0.0f);
+    dcOffsetState = 0.0f;
+}
+
+void RotarySpeaker::releaseResources() {}
+
+void RotarySpeaker::setParameter(int parameterIndex, float value)
+{
+    value = dsp256::jlimit(0.0f, 1.0f, value);
+    if (getParameter(parameterIndex) == value)
+        return;
+
+    switch (parameterIndex) {
+    case 0: speed = value; break;
+    case 1: acceleration = value; break;
+    case 2: crossover = value; break;
+    case 3: balance = value; break;
+    case 4: doppler = value; break;
+    case 5: spread = value; break;
+    case 6: mix = value; break;
+    }
+    updateParameters();
+}
+
+float RotarySpeaker::getParameter(int parameterIndex) const
+{
+    switch (parameterIndex) {
+    case 0: return speed;
+    case 1: return acceleration;
+    case 2: return crossover;
+    case 3: return balance;
+    case 4: return doppler;
+    case 5: return spread;
+    case 6: return mix;
+    default: return 0.0f;
+    }
+}
+
+dsp256::String RotarySpeaker::getParameterDisplay(int parameterIndex) const
+{
+    switch (parameterIndex) {
+    case 0: return dsp256::String(horn.targetHz, 2) + " Hz";
+    case 1: return dsp256::String(0.25f * std::pow(16.0f, acceleration), 2) + "x";
+    case 2: return dsp256::String(400.0f * std::pow(4.0f, crossover), 0) + " Hz";
+    case 3: return dsp256::String(balance * 100.0f, 0) + "%";
+    case 4: return dsp256::String(doppler * 100.0f, 0) + "%";
+    case 5: return dsp256::String(spread * 180.0f, 0) + " deg";
+    case 6: return dsp256::String(mix * 100.0f, 0) + "%";
+    default: return "";
+    }
+}
+
+void RotarySpeaker::updateParameters()
+{
+    validateParameters();
+
+    const float fs = static_cast<float>(sampleRate);
+
+    horn.targetHz = horn.slowHz + speed * (horn.fastHz - horn.slowHz);
+    drum.targetHz = drum.slowHz + speed * (drum.fastHz - drum.slowHz);
+
+    designCrossover(400.0f * std::pow(4.0f, crossover));
+
+    // Rotor radius over speed of sound gives the peak path change in samples
+    horn.dopplerSamples = doppler * (0.15f / 343.0f) * fs;
+    drum.dopplerSamples = doppler * (0.10f / 343.0f) * fs;
+    dopplerBaseDelay = horn.dopplerSamples + 2.0f;
+
+    // Each mic sits spread/2 either side of the cabinet front
+    micOffset = spread * 0.25f * static_cast<float>(ANGLE_TABLE_SIZE);
+
+    // Facing away, the horn rolls off near 2.5 kHz and the drum near 400 Hz
+    hornToneFloor = 1.0f - std::exp(-dsp256::MathConstants<float>::twoPi * 2500.0f / fs);
+    drumToneFloor = 1.0f - std::exp(-dsp256::MathConstants<float>::twoPi * 400.0f / fs);
+
+    const float hornWeight = dsp256::jmin(1.0f, 2.0f * balance);
+    const float drumWeight = dsp256::jmin(1.0f, 2.0f * (1.0f - balance));
+    laneWeights = Float4::set(hornWeight, hornWeight, drumWeight, drumWeight);
+}
+
+void RotarySpeaker::buildRotorTables()
+{
+    for (int i = 0; i <= ANGLE_TABLE_SIZE; ++i) {
+        // Angle between the rotor's mouth and the mic; 0 = pointing at the mic
+        const float angle = dsp256::MathConstants<float>::twoPi * static_cast<float>(i)
+            / static_cast<float>(ANGLE_TABLE_SIZE);
+        const float facing = 0.5f + 0.5f * std::cos(angle);
+
+        // Horn is a narrow beam; the drum's baffle is much broader
+        hornTable[i] = { 0.25f + 0.75f * facing * facing, std::sin(angle), facing * facing, 0.0f };
+        drumTable[i] = { 0.6f + 0.4f * facing, std::sin(angle), 0.5f + 0.5f * facing, 0.0f };
+    }
+}
+
+void RotarySpeaker::designCrossover(float frequencyHz)
+{
+    // Butterworth biquads (Q = 1/sqrt(2)); two in series form an LR4 pair
+    const float w0 = dsp256::MathConstants<float>::twoPi * frequencyHz / static_cast<float>(sampleRate);
+    const float cosW = std::cos(w0);
+    const float alpha = std::sin(w0) / (2.0f * 0.70710678f);
+    const float a0 = 1.0f + alpha;
+
+    for (auto& bq : lowPass) {
+        bq.b0 = (1.0f - cosW) * 0.5f / a0;
+        bq.b1 = (1.0f - cosW) / a0;
+        bq.b2 = bq.b0;
+        bq.a1 = -2.0f * cosW / a0;
+        bq.a2 = (1.0f - alpha) / a0;
+    }
+    for (auto& bq : highPass) {
+        bq.b0 = (1.0f + cosW) * 0.5f / a0;
+        bq.b1 = -(1.0f + cosW) / a0;
+        bq.b2 = bq.b0;
+        bq.a1 = -2.0f * cosW / a0;
+        bq.a2 = (1.0f - alpha) / a0;
+    }
+}
+
+float RotarySpeaker::processBiquad(Biquad& bq, float input)
+{
+    // Transposed direct form II
+    const float output = bq.b0 * input + bq.z1;
+    bq.z1 = bq.b1 * input - bq.a1 * output + bq.z2;
+    bq.z2 = bq.b2 * input - bq.a2 * output;
+    return output;
+}
+
+Float4 RotarySpeaker::lookup(const AngleTable& table, float position)
+{
+    const size_t index = static_cast<size_t>(position);
+    const float frac = position - static_cast<float>(index);
+    const Float4 a = Float4::load(table[index].data());
+    const Float4 b = Float4::load(table[index + 1].data());
+    return Float4::mulAdd(b - a, Float4::broadcast(frac), a);
+}
+
+//==============================================================================
+void RotarySpeaker::process(FixedPointSample& left, FixedPointSample& right,
+    DelayMemoryPool& delayPool, FixedPointEngine& dspCore)
+{
+    dsp256::ignoreUnused(delayPool);
+
+    const float inL = dspCore.Q12ToFloat(left);
+    const float inR = dspCore.Q12ToFloat(right);
+
+    // The cabinet has a single input; DC block it like the rest of the chain
+    FixedPointSample monoFP = dspCore.floatToQ12((inL + inR) * 0.5f);
+    monoFP = dspCore.dcBlock(monoFP, dcOffsetState);
+    const float mono = dspCore.Q12ToFloat(monoFP);
+
+    // LR4 crossover into the two rotor bands
+    const float low = processBiquad(lowPass[1], processBiquad(lowPass[0], mono));
+    const float high = processBiquad(highPass[1], processBiquad(highPass[0], mono));
+
+    hornDelay.write(dspCore.floatToQ12(high).value, 0);
+    drumDelay.write(dspCore.floatToQ12(low).value, 1);
+
+    // Rotor angle as seen by each mic, in table units
+    const float tableSize = static_cast<float>(ANGLE_TABLE_SIZE);
+    auto wrap = [tableSize](float p) {
+        if (p < 0.0f) p += tableSize;
+        if (p >= tableSize) p -= tableSize;
+        return p;
+    };
+
+    const float hornPos = horn.phase * tableSize;
+    const float drumPos = drum.phase * tableSize;
+    const float pos[4] = { wrap(hornPos + micOffset), wrap(hornPos - micOffset),
+                           wrap(drumPos + micOffset), wrap(drumPos - micOffset) };
+
+    // One interpolated table point per lane, transposed to one vector per quantity
+    Float4 amplitude = lookup(hornTable, pos[0]);
+    Float4 doppler = lookup(hornTable, pos[1]);
+    Float4 brightness = lookup(drumTable, pos[2]);
+    Float4 unused = lookup(drumTable, pos[3]);
+    Float4::transpose(amplitude, doppler, brightness, unused);
+
+    // Doppler: fractional reads at the modulated path length. The delay-line
+    // loads are per lane; offsets and interpolation are one Float4 op each.
+    const Float4 dopplerDepth = Float4::set(horn.dopplerSamples, horn.dopplerSamples,
+                                            drum.dopplerSamples, drum.dopplerSamples);
+    float offsets[4];
+    Float4::mulAdd(dopplerDepth, doppler, Float4::broadcast(dopplerBaseDelay)).store(offsets);
+
+    float nearer[4], further[4], frac[4];
+    hornDelay.readFractionalTaps(offsets[0], nearer[0], further[0], frac[0]);
+    hornDelay.readFractionalTaps(offsets[1], nearer[1], further[1], frac[1]);
+    drumDelay.readFractionalTaps(offsets[2], nearer[2], further[2], frac[2]);
+    drumDelay.readFractionalTaps(offsets[3], nearer[3], further[3], frac[3]);
+    const Float4 nearTaps = Float4::load(nearer);
+    const Float4 dry = Float4::mulAdd(Float4::load(further) - nearTaps, Float4::load(frac), nearTaps);
+
+    // One 4-lane pass: tone filter, directivity and horn/drum balance
+    const Float4 toneFloor = Float4::set(hornToneFloor, hornToneFloor, drumToneFloor, drumToneFloor);
+    const Float4 toneAlpha = Float4::mulAdd(brightness, Float4::broadcast(1.0f) - toneFloor, toneFloor);
+    const Float4 x = dry * Float4::broadcast(1.0f / static_cast<float>(FixedPointSample::Q12_ONE));
+
+    toneState = Float4::mulAdd(toneAlpha, x - toneState, toneState);
+
+    float lanes[4];
+    (toneState * amplitude * laneWeights).store(lanes);
+
+    const float wetL = lanes[0] + lanes[2];
+    const float wetR = lanes[1] + lanes[3];
+
+    const float outL = inL * (1.0f - mix) + wetL * mix;
+    const float outR = inR * (1.0f - mix) + wetR * mix;
+
+    left = dspCore.floatToQ12(outL);
+    right = dspCore.floatToQ12(outR);
+
+    // Advance rotor angles
+    const float invFs = 1.0f / static_cast<float>(sampleRate);
+    horn.phase += horn.rateHz * invFs;
+    if (horn.phase >= 1.0f) horn.phase -= 1.0f;
+    drum.phase += drum.rateHz * invFs;
+    if (drum.phase >= 1.0f) drum.phase -= 1.0f;
+}
+
+void RotarySpeaker::advanceRotor(Rotor& rotor, int numSamples)
+{
+    // Motor inertia: exponential approach, different time constants up and down
+    const float scale = 0.25f * std::pow(16.0f, acceleration);
+    const float tau = (rotor.targetHz > rotor.rateHz ? rotor.spinUpSeconds : rotor.brakeSeconds) * scale;
+    const float coeff = 1.0f - std::exp(-static_cast<float>(numSamples) / (tau * static_cast<float>(sampleRate)));
+    rotor.rateHz += (rotor.targetHz - rotor.rateHz) * coeff;
+}
+
+void RotarySpeaker::updateModulation(int blockCounter)
+{
+    advanceRotor(horn, blockCounter);
+    advanceRotor(drum, blockCounter);
+}
+
+dsp256::String RotarySpeaker::getRealtimeDisplayInfo() const
+{
+    return dsp256::String::formatted("Horn: %.2f Hz  Drum: %.2f Hz", horn.rateHz, drum.rateHz);
+}
+
+void RotarySpeaker::validateParameters()
+{
+    speed = dsp256::jlimit(0.0f, 1.0f, speed);
+    acceleration = dsp256::jlimit(0.0f, 1.0f, acceleration);
+    crossover = dsp256::jlimit(0.0f, 1.0f, crossover);
+    balance = dsp256::jlimit(0.0f, 1.0f, balance);
+    doppler = dsp256::jlimit(0.0f, 1.0f, doppler);
+    spread = dsp256::jlimit(0.0f, 1.0f, spread);
+    mix = dsp256::jlimit(0.0f, 1.0f, mix);
+}
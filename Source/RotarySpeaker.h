@@ -0,0 +1,139 @@
+// RotarySpeaker.h - Rotary Speaker Effect Module
+#pragma once
+
+#include "EffectModule.h"
+#include "FixedPointDSP.h"
+#include "DelayMemoryPool.h"
+#include "SimdLanes.h"
+#include <array>
+
+//==============================================================================
+// Rotary Speaker Effect Module
+// Leslie-style cabinet: a Linkwitz-Riley crossover splits the input into a
+// horn (treble) and drum (bass) band, each spun by its own rotor with
+// acceleration and braking. Doppler comes from modulated fractional delay
+// reads; amplitude and tone modulation come from precomputed rotor tables.
+// Both rotors and both mics run as the four lanes of one Float4 pass: table
+// lookups, Doppler interpolation, tone and directivity; only the delay-line
+// loads behind the Doppler reads are per lane (SSE2/NEON have no gather).
+//==============================================================================
+class RotarySpeaker : public EffectModule {
+public:
+    RotarySpeaker();
+    ~RotarySpeaker() override = default;
+
+    // Module identification
+    dsp256::String getModuleName() const override { return "Rotary Speaker"; }
+    dsp256::String getModuleDescription() const override {
+        return "Leslie-style rotating horn and drum with Doppler. "
+            "Slow/fast with natural acceleration.";
+    }
+
+    // Parameter configuration
+    std::vector<EffectParameter> getParameterDefinitions() const override;
+    int getParameterCount() const override { return 7; }
+
+    // Preset management
+    std::vector<EffectPreset> getFactoryPresets() const override;
+    void loadPreset(const EffectPreset& preset) override;
+    EffectPreset getCurrentPreset() const override;
+
+    // DSP lifecycle
+    void prepare(double sampleRate, int samplesPerBlock) override;
+    void reset() override;
+    void releaseResources() override;
+
+    // Parameter updates
+    void setParameter(int parameterIndex, float value) override;
+    float getParameter(int parameterIndex) const override;
+    dsp256::String getParameterDisplay(int parameterIndex) const override;
+
+    // Audio processing
+    void process(FixedPointSample& left, FixedPointSample& right,
+        DelayMemoryPool& delayPool, FixedPointEngine& dspCore) override;
+
+    // Rotor acceleration/braking (called at control rate)
+    void updateModulation(int blockCounter) override;
+
+    // Real-time display
+    bool hasRealtimeDisplay() const override { return true; }
+    dsp256::String getRealtimeDisplayInfo() const override;
+
+private:
+    // Parameters (0.0 to 1.0 normalized)
+    float speed = 0.0f;           // Rotor speed: 0 = chorale (slow), 1 = tremolo (fast)
+    float acceleration = 0.5f;    // Spin-up/brake time: 0.25x-4x of the stock motor
+    float crossover = 0.5f;       // Crossover: 400-1600 Hz (logarithmic)
+    float balance = 0.5f;         // Horn/drum balance: 0 = drum only, 1 = horn only
+    float doppler = 0.7f;         // Doppler depth: 0-100%
+    float spread = 0.6f;          // Mic angle: 0-180 degrees between mics
+    float mix = 1.0f;             // Dry/Wet Mix: 0-100%
+
+    // Rotor angle tables: one revolution, plus a guard point for interpolation.
+    // Each point packs what a mic sees at that angle, so one lane's lookup is
+    // a single Float4 interpolation:
+    //   [0] amplitude    directivity gain
+    //   [1] doppler      path-length change, -1..1 (sin of angle)
+    //   [2] brightness   0 = facing away (dull), 1 = facing mic
+    //   [3] unused
+    static constexpr int ANGLE_TABLE_SIZE = 1024;
+    using AngleTable = std::array<std::array<float, 4>, ANGLE_TABLE_SIZE + 1>;
+
+    struct Rotor {
+        float phase = 0.0f;       // Revolutions, 0..1
+        float rateHz = 0.0f;      // Current rotation rate
+        float targetHz = 0.0f;    // Rate the motor is heading for
+        float slowHz = 0.0f;
+        float fastHz = 0.0f;
+        float spinUpSeconds = 0.0f;
+        float brakeSeconds = 0.0f;
+        float dopplerSamples = 0.0f;
+    };
+
+    // Linkwitz-Riley 4th order = two identical Butterworth biquads
+    struct Biquad {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+        float z1 = 0.0f, z2 = 0.0f;
+    };
+
+    AngleTable hornTable;
+    AngleTable drumTable;
+    Rotor horn;
+    Rotor drum;
+
+    std::array<Biquad, 2> lowPass;
+    std::array<Biquad, 2> highPass;
+
+    // Doppler delay lines (one per rotor band)
+    DelayMemoryPool hornDelay{ 2048 };
+    DelayMemoryPool drumDelay{ 2048 };
+    float dopplerBaseDelay = 32.0f;
+
+    // Lane order: [hornL, hornR, drumL, drumR]
+    Float4 toneState = Float4::broadcast(0.0f);
+    Float4 laneWeights = Float4::broadcast(0.5f);
+    float micOffset = 0.0f;       // Mic angle offset in table units
+
+    // DC offset filter state
+    float dcOffsetState = 0.0f;
+
+    // Tone filter floor per rotor (one-pole coefficient when facing away)
+    float hornToneFloor = 1.0f;
+    float drumToneFloor = 1.0f;
+
+    // Sample rate and block size
+    double sampleRate = 44100.0;
+    int blockSize = 512;
+
+    // Helper methods
+    void updateParameters();
+    void buildRotorTables();
+    void designCrossover(float frequencyHz);
+    float processBiquad(Biquad& bq, float input);
+    void advanceRotor(Rotor& rotor, int numSamples);
+
+    static Float4 lookup(const AngleTable& table, float position);
+
+    // Parameter validation
+    void validateParameters();
+};
@@ -0,0 +1,109 @@
+// SimdLanes.h - Minimal 4-lane float vector for lane-packed DSP
+#pragma once
+
+//==============================================================================
+// Float4 wraps one 128-bit register (SSE2 on x86/x64, NEON on ARM) and falls
+// back to plain scalar code elsewhere. Modules pack independent voices (e.g.
+// left/right x two rotors) into the four lanes and run one pass per sample.
+// Define DSP256_FORCE_SCALAR to build the scalar fallback on any target.
+//==============================================================================
+#if !defined(DSP256_FORCE_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+ #define DSP256_SIMD_SSE2 1
+ #include <emmintrin.h>
+#elif !defined(DSP256_FORCE_SCALAR) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+ #define DSP256_SIMD_NEON 1
+ #include <arm_neon.h>
+#else
+ #define DSP256_SIMD_SCALAR 1
+#endif
+
+struct Float4 {
+#if DSP256_SIMD_SSE2
+    __m128 v;
+
+    static inline Float4 load(const float* p) { return { _mm_loadu_ps(p) }; }
+    static inline Float4 broadcast(float f) { return { _mm_set1_ps(f) }; }
+    static inline Float4 set(float a, float b, float c, float d) { return { _mm_setr_ps(a, b, c, d) }; }
+    inline void store(float* p) const { _mm_storeu_ps(p, v); }
+
+    friend inline Float4 operator+(Float4 a, Float4 b) { return { _mm_add_ps(a.v, b.v) }; }
+    friend inline Float4 operator-(Float4 a, Float4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+    friend inline Float4 operator*(Float4 a, Float4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+    friend inline Float4 operator/(Float4 a, Float4 b) { return { _mm_div_ps(a.v, b.v) }; }
+    static inline Float4 min(Float4 a, Float4 b) { return { _mm_min_ps(a.v, b.v) }; }
+    static inline Float4 max(Float4 a, Float4 b) { return { _mm_max_ps(a.v, b.v) }; }
+
+    // Rows to columns: lane j of register i swaps with lane i of register j
+    static inline void transpose(Float4& a, Float4& b, Float4& c, Float4& d) {
+        _MM_TRANSPOSE4_PS(a.v, b.v, c.v, d.v);
+    }
+#elif DSP256_SIMD_NEON
+    float32x4_t v;
+
+    static inline Float4 load(const float* p) { return { vld1q_f32(p) }; }
+    static inline Float4 broadcast(float f) { return { vdupq_n_f32(f) }; }
+    static inline Float4 set(float a, float b, float c, float d) {
+        const float lanes[4] = { a, b, c, d };
+        return { vld1q_f32(lanes) };
+    }
+    inline void store(float* p) const { vst1q_f32(p, v); }
+
+    friend inline Float4 operator+(Float4 a, Float4 b) { return { vaddq_f32(a.v, b.v) }; }
+    friend inline Float4 operator-(Float4 a, Float4 b) { return { vsubq_f32(a.v, b.v) }; }
+    friend inline Float4 operator*(Float4 a, Float4 b) { return { vmulq_f32(a.v, b.v) }; }
+  #if defined(__aarch64__) || defined(_M_ARM64)
+    friend inline Float4 operator/(Float4 a, Float4 b) { return { vdivq_f32(a.v, b.v) }; }
+  #else
+    friend inline Float4 operator/(Float4 a, Float4 b) {
+        // ARMv7 NEON has no divide: reciprocal estimate + two Newton steps
+        float32x4_t r = vrecpeq_f32(b.v);
+        r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+        r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+        return { vmulq_f32(a.v, r) };
+    }
+  #endif
+    static inline Float4 min(Float4 a, Float4 b) { return { vminq_f32(a.v, b.v) }; }
+    static inline Float4 max(Float4 a, Float4 b) { return { vmaxq_f32(a.v, b.v) }; }
+
+    static inline void transpose(Float4& a, Float4& b, Float4& c, Float4& d) {
+        const float32x4x2_t ab = vtrnq_f32(a.v, b.v);     // a0 b0 a2 b2 | a1 b1 a3 b3
+        const float32x4x2_t cd = vtrnq_f32(c.v, d.v);
+        a.v = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+        b.v = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+        c.v = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+        d.v = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+    }
+#else
+    float v[4];
+
+    static inline Float4 load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+    static inline Float4 broadcast(float f) { return { { f, f, f, f } }; }
+    static inline Float4 set(float a, float b, float c, float d) { return { { a, b, c, d } }; }
+    inline void store(float* p) const { for (int i = 0; i < 4; ++i) p[i] = v[i]; }
+
+    friend inline Float4 operator+(Float4 a, Float4 b) { for (int i = 0; i < 4; ++i) a.v[i] += b.v[i]; return a; }
+    friend inline Float4 operator-(Float4 a, Float4 b) { for (int i = 0; i < 4; ++i) a.v[i] -= b.v[i]; return a; }
+    friend inline Float4 operator*(Float4 a, Float4 b) { for (int i = 0; i < 4; ++i) a.v[i] *= b.v[i]; return a; }
+    friend inline Float4 operator/(Float4 a, Float4 b) { for (int i = 0; i < 4; ++i) a.v[i] /= b.v[i]; return a; }
+    static inline Float4 min(Float4 a, Float4 b) { for (int i = 0; i < 4; ++i) a.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i]; return a; }
+    static inline Float4 max(Float4 a, Float4 b) { for (int i = 0; i < 4; ++i) a.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i]; return a; }
+
+    static inline void transpose(Float4& a, Float4& b, Float4& c, Float4& d) {
+        Float4* rows[4] = { &a, &b, &c, &d };
+        for (int i = 0; i < 4; ++i)
+            for (int j = i + 1; j < 4; ++j) {
+                const float t = rows[i]->v[j];
+                rows[i]->v[j] = rows[j]->v[i];
+                rows[j]->v[i] = t;
+            }
+    }
+#endif
+
+    // a * b + c (kept as two ops so every target rounds identically)
+    static inline Float4 mulAdd(Float4 a, Float4 b, Float4 c) { return a * b + c; }
+
+    static inline Float4 clamp(Float4 x, float lo, float hi) {
+        return min(max(x, broadcast(lo)), broadcast(hi));
+    }
+};
@@ -0,0 +1,158 @@
+// StageProfiler.h - Optional per-stage timing of a module's block processing
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+//==============================================================================
+// Build with DSP256_STAGE_PROFILING=1 to time each stage of a module's
+// processBlock(). Stage times are summed over one processBlock() call (the
+// processor's control-rate sub-block) and folded into running average and
+// maximum figures, readable from any thread. With profiling off (the
+// default) the DSP256_PROFILE_* macros expand to nothing and no profiler
+// is compiled in, so release builds pay nothing.
+//
+// Clock: the TSC on x86 (converted to ns against steady_clock, calibrated
+// on the reading side), steady_clock (clock_gettime) elsewhere.
+//==============================================================================
+#ifndef DSP256_STAGE_PROFILING
+ #define DSP256_STAGE_PROFILING 0
+#endif
+
+// One stage's cost per processBlock() call; the last entry a module reports
+// is the whole call
+struct StageTiming {
+    const char* name = "";
+    double averageNs = 0.0;
+    double maxNs = 0.0;
+};
+
+#if DSP256_STAGE_PROFILING
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+ #include <intrin.h>
+ #define DSP256_PROFILE_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+ #include <x86intrin.h>
+ #define DSP256_PROFILE_TSC 1
+#else
+ #define DSP256_PROFILE_TSC 0
+#endif
+
+template <int NumStages>
+class StageProfiler {
+public:
+    static constexpr int NUM_TIMINGS = NumStages + 1;    // Stages, then the whole block
+
+    explicit StageProfiler(const std::array<const char*, NumStages>& stageNames) noexcept
+        : names(stageNames)
+    {
+        calibrationTicks = now();
+        calibrationTime = std::chrono::steady_clock::now();
+    }
+
+    // Audio thread
+    void beginBlock() noexcept
+    {
+        if (resetRequested.exchange(false, std::memory_order_acquire)) {
+            for (auto& s : statistics) {
+                s.totalTicks.store(0, std::memory_order_relaxed);
+                s.maxTicks.store(0, std::memory_order_relaxed);
+            }
+            blocks.store(0, std::memory_order_release);
+        }
+        blockTicks.fill(0);
+        blockStart = now();
+    }
+
+    void beginStage() noexcept { stageStart = now(); }
+    void endStage(int stage) noexcept { blockTicks[static_cast<size_t>(stage)] += now() - stageStart; }
+
+    void endBlock() noexcept
+    {
+        blockTicks[NumStages] = now() - blockStart;
+        for (size_t i = 0; i < statistics.size(); ++i) {
+            auto& s = statistics[i];
+            s.totalTicks.store(s.totalTicks.load(std::memory_order_relaxed) + blockTicks[i], std::memory_order_relaxed);
+            if (blockTicks[i] > s.maxTicks.load(std::memory_order_relaxed))
+                s.maxTicks.store(blockTicks[i], std::memory_order_relaxed);
+        }
+        blocks.store(blocks.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Any thread; returns the number of entries written (NUM_TIMINGS)
+    int getTimings(StageTiming* timings, int maxTimings) const noexcept
+    {
+        const uint64_t count = blocks.load(std::memory_order_acquire);
+        const double nsPerTick = nanosecondsPerTick();
+        const int n = maxTimings < NUM_TIMINGS ? maxTimings : NUM_TIMINGS;
+
+        for (int i = 0; i < n; ++i) {
+            const auto& s = statistics[static_cast<size_t>(i)];
+            timings[i].name = i < NumStages ? names[static_cast<size_t>(i)] : "block";
+            timings[i].averageNs = count > 0 ? static_cast<double>(s.totalTicks.load(std::memory_order_relaxed)) * nsPerTick / static_cast<double>(count) : 0.0;
+            timings[i].maxNs = static_cast<double>(s.maxTicks.load(std::memory_order_relaxed)) * nsPerTick;
+        }
+        return n;
+    }
+
+    // Any thread; the audio thread clears the figures at its next block
+    void resetStatistics() noexcept { resetRequested.store(true, std::memory_order_release); }
+
+private:
+    struct Statistic {
+        std::atomic<uint64_t> totalTicks{ 0 };
+        std::atomic<uint64_t> maxTicks{ 0 };
+    };
+
+    static uint64_t now() noexcept
+    {
+#if DSP256_PROFILE_TSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // TSC rate from the ticks and nanoseconds elapsed since construction
+    double nanosecondsPerTick() const noexcept
+    {
+#if DSP256_PROFILE_TSC
+        const double elapsedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - calibrationTime).count();
+        const double elapsedTicks = static_cast<double>(now() - calibrationTicks);
+        return elapsedTicks > 0.0 ? elapsedNs / elapsedTicks : 0.0;
+#else
+        return 1.0;
+#endif
+    }
+
+    std::array<const char*, NumStages> names;
+    std::array<Statistic, NUM_TIMINGS> statistics;
+    std::atomic<uint64_t> blocks{ 0 };
+    std::atomic<bool> resetRequested{ false };
+
+    // Audio thread only
+    std::array<uint64_t, NUM_TIMINGS> blockTicks{};
+    uint64_t blockStart = 0;
+    uint64_t stageStart = 0;
+
+    uint64_t calibrationTicks = 0;
+    std::chrono::steady_clock::time_point calibrationTime;
+};
+
+ #define DSP256_PROFILE_BEGIN_BLOCK(profiler) (profiler).beginBlock()
+ #define DSP256_PROFILE_END_BLOCK(profiler) (profiler).endBlock()
+ #define DSP256_PROFILE_BEGIN_STAGE(profiler) (profiler).beginStage()
+ #define DSP256_PROFILE_END_STAGE(profiler, stage) (profiler).endStage(stage)
+
+#else
+
+ #define DSP256_PROFILE_BEGIN_BLOCK(profiler)
+ #define DSP256_PROFILE_END_BLOCK(profiler)
+ #define DSP256_PROFILE_BEGIN_STAGE(profiler)
+ #define DSP256_PROFILE_END_STAGE(profiler, stage)
+
+#endif
@@ -0,0 +1,92 @@
+// StereoWidth.h - Mid/side width with a mono-compatible bass band
+#pragma once
+
+#include "SimdLanes.h"
+
+//==============================================================================
+// Mid/side width for a stereo bus. The side signal is split by a 2-pole TPT
+// low-pass (Butterworth); the low band gets 'lowWidth' (0 = mono bass) and
+// the rest gets 'highWidth'. Low + high always sums back to the side signal,
+// so 100%/100% leaves the image unchanged.
+//
+// processBlock() does the matrix, band split and recombination in one pass:
+// four samples at a time in Float4, with only the filter recursion scalar.
+//==============================================================================
+struct StereoWidth {
+    float lowWidth = 1.0f;        // Side gain below the crossover
+    float highWidth = 1.0f;       // Side gain above the crossover
+
+    // g = tan(pi * fc / fs), e.g. from ZdfTanTable
+    void setCrossover(float g)
+    {
+        a1 = 1.0f / (1.0f + g * (g + K));
+        a2 = g * a1;
+        a3 = g * a2;
+    }
+
+    // 100%/100%: callers skip the stage, so the image is unchanged bit for bit
+    bool isNeutral() const noexcept { return lowWidth == 1.0f && highWidth == 1.0f; }
+
+    void reset()
+    {
+        ic1eq = 0.0f;
+        ic2eq = 0.0f;
+    }
+
+    inline void processSample(float& left, float& right)
+    {
+        const float mid = (left + right) * 0.5f;
+        const float side = (left - right) * 0.5f;
+        const float low = lowPass(side);
+        const float width = lowWidth * low + highWidth * (side - low);
+        left = mid + width;
+        right = mid - width;
+    }
+
+    void processBlock(float* left, float* right, int numSamples)
+    {
+        const Float4 half = Float4::broadcast(0.5f);
+        const Float4 lw = Float4::broadcast(lowWidth);
+        const Float4 hw = Float4::broadcast(highWidth);
+
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4) {
+            const Float4 l = Float4::load(left + i);
+            const Float4 r = Float4::load(right + i);
+            const Float4 mid = (l + r) * half;
+            const Float4 side = (l - r) * half;
+
+            float lanes[4];
+            side.store(lanes);
+            for (float& s : lanes)
+                s = lowPass(s);
+            const Float4 low = Float4::load(lanes);
+
+            const Float4 width = Float4::mulAdd(lw, low, hw * (side - low));
+            (mid + width).store(left + i);
+            (mid - width).store(right + i);
+        }
+
+        for (; i < numSamples; ++i)
+            processSample(left[i], right[i]);
+    }
+
+private:
+    static constexpr float K = 1.41421356f;   // Butterworth damping (Q = 0.707)
+
+    float a1 = 1.0f;
+    float a2 = 0.0f;
+    float a3 = 0.0f;
+    float ic1eq = 0.0f;
+    float ic2eq = 0.0f;
+
+    inline float lowPass(float v0)
+    {
+        const float v3 = v0 - ic2eq;
+        const float v1 = a1 * ic1eq + a2 * v3;
+        const float v2 = ic2eq + a2 * ic1eq + a3 * v3;
+        ic1eq = 2.0f * v1 - ic1eq;
+        ic2eq = 2.0f * v2 - ic2eq;
+        return v2;
+    }
+};
@@ -0,0 +1,141 @@
+// SurroundMatrix.h - Decorrelated multichannel tap matrix for reverb tails
+#pragma once
+
+#include "SimdLanes.h"
+#include "ZdfFilter.h"
+#include "DspCore.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+//==============================================================================
+// Spreads one mono reverb tail over NumChannels outputs. The tail is written
+// to a short delay line and read back at NUM_TAPS shared delays; each tap has
+// a +/-1 gain per channel taken from a Sylvester Hadamard column, so every
+// output hears the same decay with different fine structure and, for a
+// white tail, the outputs are mutually uncorrelated.
+//
+// Because the delays are shared, each tap costs one read plus one Float4
+// multiply-add per group of four channels: 8 outputs take two vector ops per
+// tap where stereo would take one. NumChannels must be a multiple of four;
+// unused lanes (e.g. 5.1 in an 8-lane matrix) and the LFE get gain zero.
+//==============================================================================
+template <int NumChannels>
+class SurroundMatrix {
+public:
+    static_assert(NumChannels > 0 && NumChannels % 4 == 0, "Channel count must be a multiple of 4");
+    static_assert(NumChannels < 16, "Hadamard columns 1..NumChannels must fit NUM_TAPS");
+
+    static constexpr int NUM_GROUPS = NumChannels / 4;
+    static constexpr int NUM_TAPS = 16;
+    static constexpr float MIN_DELAY_MS = 1.5f;
+    static constexpr float MAX_DELAY_MS = 35.0f;
+
+    void prepare(double sampleRate)
+    {
+        const int maxDelay = static_cast<int>(std::ceil(MAX_DELAY_MS * 0.001 * sampleRate)) + 1;
+        const int size = dsp256::nextPowerOfTwo(maxDelay + 1);
+        line.assign(static_cast<size_t>(size), 0.0f);
+        mask = size - 1;
+
+        // Log-spaced delays with a fixed jitter; unit energy per channel
+        uint32_t seed = 0x5EED2A5Du;
+        auto nextRandom = [&seed]() {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<float>(seed >> 8) / 16777216.0f;
+        };
+
+        const float ratio = MAX_DELAY_MS / MIN_DELAY_MS;
+        const float norm = 1.0f / std::sqrt(static_cast<float>(NUM_TAPS));
+        for (int k = 0; k < NUM_TAPS; ++k) {
+            const float position = (static_cast<float>(k) + 0.5f * nextRandom()) / static_cast<float>(NUM_TAPS);
+            const float ms = MIN_DELAY_MS * std::pow(ratio, position);
+            delays[static_cast<size_t>(k)] = dsp256::jlimit(1, mask,
+                static_cast<int>(ms * 0.001f * static_cast<float>(sampleRate)));
+
+            for (int c = 0; c < NumChannels; ++c)
+                baseGains[static_cast<size_t>(k)][static_cast<size_t>(c)] = hadamardSign(k, c + 1) * norm;
+        }
+
+        applyChannelGains();
+        reset();
+    }
+
+    // Per-output level, e.g. 0 for the LFE and for lanes past the layout
+    void setChannelGain(int channel, float gain)
+    {
+        if (channel >= 0 && channel < NumChannels) {
+            channelGains[static_cast<size_t>(channel)] = gain;
+            applyChannelGains();
+        }
+    }
+
+    void reset()
+    {
+        std::fill(line.begin(), line.end(), 0.0f);
+        writeIndex = 0;
+        for (auto& lp : damping)
+            lp.reset();
+    }
+
+    // One sample in, NumChannels damped outputs
+    inline void process(float input, float dampingG, float* outputs)
+    {
+        line[static_cast<size_t>(writeIndex)] = input;
+
+        std::array<Float4, NUM_GROUPS> acc;
+        acc.fill(Float4::broadcast(0.0f));
+
+        for (int k = 0; k < NUM_TAPS; ++k) {
+            const Float4 x = Float4::broadcast(line[static_cast<size_t>((writeIndex - delays[static_cast<size_t>(k)]) & mask)]);
+            const float* g = gains[static_cast<size_t>(k)].data();
+            for (int grp = 0; grp < NUM_GROUPS; ++grp)
+                acc[static_cast<size_t>(grp)] = Float4::mulAdd(Float4::load(g + 4 * grp), x, acc[static_cast<size_t>(grp)]);
+        }
+
+        writeIndex = (writeIndex + 1) & mask;
+
+        const Float4 G = Float4::broadcast(dampingG);
+        for (int grp = 0; grp < NUM_GROUPS; ++grp)
+            damping[static_cast<size_t>(grp)].processLowPass(acc[static_cast<size_t>(grp)], G).store(outputs + 4 * grp);
+    }
+
+private:
+    // Entry (row, column) of the Sylvester Hadamard matrix; column 0 (all
+    // ones) is skipped so no output is a plain sum of the taps.
+    static float hadamardSign(int row, int column)
+    {
+        int bits = row & column;
+        int parity = 0;
+        while (bits != 0) {
+            parity ^= bits & 1;
+            bits >>= 1;
+        }
+        return parity != 0 ? -1.0f : 1.0f;
+    }
+
+    void applyChannelGains()
+    {
+        for (size_t k = 0; k < gains.size(); ++k)
+            for (size_t c = 0; c < static_cast<size_t>(NumChannels); ++c)
+                gains[k][c] = baseGains[k][c] * channelGains[c];
+    }
+
+    std::vector<float> line;
+    int mask = 0;
+    int writeIndex = 0;
+
+    std::array<int, NUM_TAPS> delays{};
+    std::array<std::array<float, NumChannels>, NUM_TAPS> baseGains{};
+    std::array<std::array<float, NumChannels>, NUM_TAPS> gains{};
+    std::array<float, NumChannels> channelGains = makeUnityGains();
+    std::array<ZdfOnePole, NUM_GROUPS> damping;
+
+    static std::array<float, NumChannels> makeUnityGains()
+    {
+        std::array<float, NumChannels> g;
+        g.fill(1.0f);
+        return g;
+    }
+};
@@ -0,0 +1,245 @@
+// Tracer.cpp - Lock-free in-process event tracing with Chrome trace JSON dumps
+#include "Tracer.h"
+
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <vector>
+
+Tracer& Tracer::getInstance()
+{
+    static Tracer instance;
+    return instance;
+}
+
+Tracer::Tracer()
+    : epochNs(now())
+{
+}
+
+Tracer::~Tracer()
+{
+    stop();
+}
+
+//==============================================================================
+void Tracer::start(const std::string& directory, int capacity)
+{
+    std::unique_lock<std::mutex> lock(controlLock);
+    outputDirectory = directory.empty() ? std::string(".") : directory;
+
+    if (slots == nullptr) {
+        uint64_t size = 1;
+        while (size < static_cast<uint64_t>(capacity > 0 ? capacity : DEFAULT_CAPACITY))
+            size <<= 1;
+        slots.reset(new Slot[size]);
+        mask = size - 1;
+    }
+
+    if (!dumpThread.joinable()) {
+        stopDumpThread = false;
+        dumpThread = std::thread([this] { dumpThreadLoop(); });
+    }
+
+    // Publishes 'slots' to the recording threads
+    enabled.store(true, std::memory_order_release);
+}
+
+void Tracer::stop()
+{
+    enabled.store(false, std::memory_order_relaxed);
+
+    std::unique_lock<std::mutex> lock(controlLock);
+    if (!dumpThread.joinable())
+        return;
+
+    stopDumpThread = true;
+    lock.unlock();
+    dumpThreadWake.notify_one();
+    dumpThread.join();
+}
+
+uint32_t Tracer::attach()
+{
+    liveInstances.fetch_add(1, std::memory_order_relaxed);
+    return nextInstanceId.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Tracer::detach()
+{
+    if (liveInstances.fetch_sub(1, std::memory_order_relaxed) == 1)
+        stop();
+}
+
+const char* Tracer::internName(const std::string& name)
+{
+    std::unique_lock<std::mutex> lock(controlLock);
+    for (const auto& existing : names) {
+        if (existing == name)
+            return existing.c_str();
+    }
+    names.push_back(name);
+    return names.back().c_str();
+}
+
+//==============================================================================
+void Tracer::recordSpan(Category category, const char* name, uint32_t instance, uint64_t startNs, int64_t value) noexcept
+{
+    const uint64_t endNs = now();
+    record(static_cast<uint32_t>(category), name, instance, startNs, endNs - startNs, value);
+}
+
+void Tracer::recordInstant(Category category, const char* name, uint32_t instance, int64_t value) noexcept
+{
+    record(static_cast<uint32_t>(category) | INSTANT, name, instance, now(), 0, value);
+}
+
+void Tracer::record(uint32_t kind, const char* name, uint32_t instance, uint64_t startNs, uint64_t durationNs, int64_t value) noexcept
+{
+    if (!enabled.load(std::memory_order_acquire))
+        return;
+
+    const uint64_t index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots[index & mask];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.timestamp.store(startNs, std::memory_order_relaxed);
+    slot.duration.store(durationNs, std::memory_order_relaxed);
+    slot.threadId.store(static_cast<uint64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())), std::memory_order_relaxed);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.instance.store(instance, std::memory_order_relaxed);
+    slot.kind.store(kind, std::memory_order_relaxed);
+
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+//==============================================================================
+namespace {
+    struct TraceEvent {
+        uint64_t timestamp;
+        uint64_t duration;
+        uint64_t threadId;
+        const char* name;
+        int64_t value;
+        uint32_t instance;
+        uint32_t kind;
+    };
+
+    void writeJsonString(std::FILE* file, const char* text)
+    {
+        std::fputc('"', file);
+        for (const char* c = text != nullptr ? text : ""; *c != '\0'; ++c) {
+            if (*c == '"' || *c == '\\')
+                std::fputc('\\', file);
+            if (static_cast<unsigned char>(*c) >= 0x20)
+                std::fputc(*c, file);
+        }
+        std::fputc('"', file);
+    }
+}
+
+bool Tracer::dumpTo(const std::string& path) const
+{
+    if (slots == nullptr)
+        return false;
+
+    // Copy out every slot that holds a whole event of the last 'capacity';
+    // slots being rewritten while we read are skipped
+    const uint64_t end = writeIndex.load(std::memory_order_acquire);
+    const uint64_t capacity = mask + 1;
+    const uint64_t begin = end > capacity ? end - capacity : 0;
+
+    std::vector<TraceEvent> events;
+    events.reserve(static_cast<size_t>(end - begin));
+    for (uint64_t index = begin; index < end; ++index) {
+        const Slot& slot = slots[index & mask];
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * index + 2)
+            continue;
+
+        TraceEvent event;
+        event.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+        event.duration = slot.duration.load(std::memory_order_relaxed);
+        event.threadId = slot.threadId.load(std::memory_order_relaxed);
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.value = slot.value.load(std::memory_order_relaxed);
+        event.instance = slot.instance.load(std::memory_order_relaxed);
+        event.kind = slot.kind.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+            events.push_back(event);
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr)
+        return false;
+
+    // Threads are numbered in order of first appearance
+    std::map<uint64_t, int> threadNumbers;
+    for (const auto& event : events)
+        threadNumbers.emplace(event.threadId, static_cast<int>(threadNumbers.size()) + 1);
+
+    static const char* const categoryNames[] = { "callback", "module", "parameter" };
+    static const char* const valueNames[] = { "samples", "samples", "changed" };
+
+    std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    bool first = true;
+    for (const auto& [threadId, number] : threadNumbers) {
+        std::fprintf(file, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"audio thread %d\"}}",
+            first ? "" : ",\n", number, number);
+        first = false;
+    }
+
+    for (const auto& event : events) {
+        const uint32_t category = (event.kind & ~INSTANT) < 3 ? (event.kind & ~INSTANT) : 0;
+        const double ts = static_cast<double>(event.timestamp - epochNs) * 0.001;
+
+        std::fprintf(file, "%s{\"name\":", first ? "" : ",\n");
+        first = false;
+        writeJsonString(file, event.name);
+        if (event.kind & INSTANT)
+            std::fprintf(file, ",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f", categoryNames[category], ts);
+        else
+            std::fprintf(file, ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f", categoryNames[category], ts,
+                static_cast<double>(event.duration) * 0.001);
+        std::fprintf(file, ",\"pid\":1,\"tid\":%d,\"args\":{\"instance\":%u,\"%s\":%lld}}",
+            threadNumbers[event.threadId], event.instance, valueNames[category], static_cast<long long>(event.value));
+    }
+    std::fprintf(file, "\n]}\n");
+
+    const bool written = std::ferror(file) == 0;
+    return std::fclose(file) == 0 && written;
+}
+
+//==============================================================================
+void Tracer::dumpThreadLoop()
+{
+    auto lastDump = std::chrono::steady_clock::now() - std::chrono::milliseconds(MIN_DUMP_INTERVAL_MS);
+
+    std::unique_lock<std::mutex> lock(controlLock);
+    while (!stopDumpThread) {
+        dumpThreadWake.wait_for(lock, std::chrono::milliseconds(DUMP_POLL_MS));
+        if (stopDumpThread)
+            break;
+
+        const auto current = std::chrono::steady_clock::now();
+        if (current - lastDump < std::chrono::milliseconds(MIN_DUMP_INTERVAL_MS)
+            || !dumpRequested.exchange(false, std::memory_order_acquire))
+            continue;
+
+        lastDump = current;
+        const auto wallMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        const uint32_t number = dumpCount.fetch_add(1, std::memory_order_relaxed) + 1;
+        const std::string path = outputDirectory + "/dsp256-trace-" + std::to_string(wallMs) + "-" + std::to_string(number) + ".json";
+
+        lock.unlock();
+        if (!dumpTo(path))
+            std::fprintf(stderr, "DSP-256 tracer: cannot write %s\n", path.c_str());
+        lock.lock();
+    }
+}
@@ -0,0 +1,152 @@
+// Tracer.h - Lock-free in-process event tracing with Chrome trace JSON dumps
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+//==============================================================================
+// Records host callbacks, per-module spans and parameter recomputes from
+// every plugin instance and audio thread in the process into one
+// preallocated ring. Recording is wait-free: a fetch_add claims a slot, the
+// event is stored with relaxed atomics and published by the slot's sequence
+// number. While tracing is off, each call costs one relaxed load. Once the
+// ring is full, the oldest events are overwritten.
+//
+// A background thread writes the ring as Chrome trace JSON
+// (chrome://tracing or ui.perfetto.dev) whenever a dump is requested. Any
+// thread may request one; the audio thread only sets a flag.
+//
+// In the plugin, setting DSP256_TRACE to a directory traces every instance
+// from load, and a dump is requested whenever a callback overruns its
+// buffer period.
+//==============================================================================
+class Tracer {
+public:
+    enum class Category : uint32_t { Callback, Module, Parameter };
+
+    static constexpr int DEFAULT_CAPACITY = 1 << 16;      // Events; rounded up to a power of two
+
+    static Tracer& getInstance();
+    ~Tracer();
+
+    // Message thread. start() allocates the ring on first use and starts the
+    // dump thread; later calls only re-enable recording. Dumps are written
+    // to outputDirectory as dsp256-trace-<time>-<n>.json.
+    void start(const std::string& outputDirectory, int capacity = DEFAULT_CAPACITY);
+    void stop();
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+    // Message thread: a name pointer that stays valid for the process
+    // lifetime, for events naming something that can be destroyed (modules)
+    const char* internName(const std::string& name);
+
+    // Message thread: each processor (or offline host) attaches for its
+    // lifetime and gets its instance number in the trace. Tracing stops, and
+    // the dump thread exits, when the last one detaches, so no thread is
+    // left to join while the plugin binary unloads.
+    uint32_t attach();
+    void detach();
+
+    // Any thread
+    static uint64_t now() noexcept
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void recordSpan(Category category, const char* name, uint32_t instance, uint64_t startNs, int64_t value) noexcept;
+    void recordInstant(Category category, const char* name, uint32_t instance, int64_t value) noexcept;
+
+    // Asks the dump thread to write the ring (at most one dump per
+    // MIN_DUMP_INTERVAL_MS, so a run of overruns produces one file)
+    void requestDump() noexcept { dumpRequested.store(true, std::memory_order_release); }
+
+    // Writes the ring now, from the calling thread; false if the file
+    // cannot be written or tracing was never started
+    bool dumpTo(const std::string& path) const;
+
+    uint64_t getRecordedCount() const noexcept { return writeIndex.load(std::memory_order_relaxed); }
+    uint32_t getDumpCount() const noexcept { return dumpCount.load(std::memory_order_relaxed); }
+
+    //==========================================================================
+    // Records [construction, destruction) as a span when tracing is on
+    class ScopedSpan {
+    public:
+        ScopedSpan(Tracer& tracerToUse, Category spanCategory, const char* spanName, uint32_t spanInstance, int64_t spanValue) noexcept
+            : tracer(tracerToUse), category(spanCategory), name(spanName), instance(spanInstance), value(spanValue),
+              startNs(tracerToUse.isEnabled() ? Tracer::now() : 0)
+        {
+        }
+
+        ~ScopedSpan()
+        {
+            if (startNs != 0)
+                tracer.recordSpan(category, name, instance, startNs, value);
+        }
+
+        // 0 when tracing was off at construction
+        uint64_t getStartTime() const noexcept { return startNs; }
+
+    private:
+        Tracer& tracer;
+        Category category;
+        const char* name;
+        uint32_t instance;
+        int64_t value;
+        uint64_t startNs;
+
+        ScopedSpan(const ScopedSpan&) = delete;
+        ScopedSpan& operator=(const ScopedSpan&) = delete;
+    };
+
+private:
+    Tracer();
+
+    static constexpr uint32_t INSTANT = 0x100;            // Flag in Slot::kind, above the category
+    static constexpr int DUMP_POLL_MS = 100;
+    static constexpr int MIN_DUMP_INTERVAL_MS = 1000;
+
+    // All fields are atomics so the dump thread can read a slot while an
+    // audio thread rewrites it; 'sequence' tells it whether the copy is whole
+    struct Slot {
+        std::atomic<uint64_t> sequence{ 0 };              // 2 * (event number + 1) once published, odd while written
+        std::atomic<uint64_t> timestamp{ 0 };
+        std::atomic<uint64_t> duration{ 0 };
+        std::atomic<uint64_t> threadId{ 0 };
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<int64_t> value{ 0 };
+        std::atomic<uint32_t> instance{ 0 };
+        std::atomic<uint32_t> kind{ 0 };
+    };
+
+    void record(uint32_t kind, const char* name, uint32_t instance, uint64_t startNs, uint64_t durationNs, int64_t value) noexcept;
+    void dumpThreadLoop();
+
+    std::unique_ptr<Slot[]> slots;                        // Allocated once, never freed before ~Tracer
+    uint64_t mask = 0;
+    alignas(64) std::atomic<uint64_t> writeIndex{ 0 };
+    alignas(64) std::atomic<bool> enabled{ false };
+    std::atomic<bool> dumpRequested{ false };
+    std::atomic<uint32_t> nextInstanceId{ 0 };
+    std::atomic<int> liveInstances{ 0 };
+    std::atomic<uint32_t> dumpCount{ 0 };
+    const uint64_t epochNs;
+
+    // Message thread and dump thread only
+    std::mutex controlLock;
+    std::condition_variable dumpThreadWake;
+    std::thread dumpThread;
+    bool stopDumpThread = false;
+    std::string outputDirectory;
+    std::deque<std::string> names;
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+};
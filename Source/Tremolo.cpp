@@ -0,0 +1,287 @@
+// Tremolo.cpp - Tremolo Implementation
+#include "Tremolo.h"
+#include "SimdLanes.h"
+#include <cmath>
+
+//==============================================================================
+Tremolo::Tremolo()
+    : holdRandom(0x7E3010)
+{
+    sampleRate = 44100.0;
+    rate = 0.7f;   // ~4 Hz
+
+    for (int i = 0; i <= SINE_TABLE_SIZE; ++i) {
+        sineTable[static_cast<size_t>(i)] = std::sin(dsp256::MathConstants<float>::twoPi
+            * static_cast<float>(i) / static_cast<float>(SINE_TABLE_SIZE));
+    }
+
+    updateParameters();
+    reset();
+}
+
+//==============================================================================
+std::vector<EffectParameter> Tremolo::getParameterDefinitions() const
+{
+    return {
+        EffectParameter("rate", "Rate", "RATE", "Hz", 0.1f, 20.0f, 4.0f, 0.01f, true),
+        EffectParameter("sync", "Tempo Sync", "SYNC", "", 0.0f, 7.0f, 0.0f, 1.0f, false),
+        EffectParameter("shape", "LFO Shape", "SHAPE", "", 0.0f, 3.0f, 0.0f, 1.0f, false),
+        EffectParameter("depth", "Depth", "DEPTH", "%", 0.0f, 100.0f, 50.0f, 0.1f, false),
+        EffectParameter("stereo", "Stereo Phase", "PHASE", "deg", 0.0f, 180.0f, 0.0f, 1.0f, false),
+        EffectParameter("smooth", "Edge Smoothing", "SMOOTH", "ms", 0.0f, 20.0f, 4.0f, 0.1f, false)
+    };
+}
+
+//==============================================================================
+std::vector<EffectPreset> Tremolo::getFactoryPresets() const
+{
+    return {
+        EffectPreset("Vintage Amp", "Tube amp bias tremolo", {0.62f, 0.0f, 0.0f, 0.5f, 0.0f, 0.2f}),
+        EffectPreset("Auto-Pan", "Full-depth stereo sweep", {0.45f, 0.0f, 0.0f, 1.0f, 1.0f, 0.2f}),
+        EffectPreset("Helicopter", "Synced 1/16 triangle chop", {0.7f, 0.857f, 0.333f, 0.9f, 0.0f, 0.1f}),
+        EffectPreset("Choppy Gate", "Synced 1/8 square gate", {0.7f, 0.571f, 0.667f, 1.0f, 0.0f, 0.1f}),
+        EffectPreset("Random Steps", "Sample-and-hold, 1/16", {0.7f, 0.857f, 1.0f, 0.7f, 0.5f, 0.3f})
+    };
+}
+
+void Tremolo::loadPreset(const EffectPreset& preset)
+{
+    if (preset.parameterValues.size() >= 6) {
+        rate = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[0]);
+        sync = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[1]);
+        shape = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[2]);
+        depth = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[3]);
+        stereoPhase = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[4]);
+        smoothing = dsp256::jlimit(0.0f, 1.0f, preset.parameterValues[5]);
+        updateParameters();
+    }
+}
+
+EffectPreset Tremolo::getCurrentPreset() const
+{
+    return EffectPreset("Current Settings", "Current tremolo parameters",
+        { rate, sync, shape, depth, stereoPhase, smoothing });
+}
+
+void Tremolo::prepare(double sr, int samplesPerBlock)
+{
+    sampleRate = sr;
+    blockSize = samplesPerBlock;
+    updateParameters();
+    reset();
+}
+
+void Tremolo::reset()
+{
+    lfoPhase = 0.0f;
+    smoothedL = 1.0f;
+    smoothedR = 1.0f;
+    holdL = 0.0f;
+    holdR = 0.0f;
+}
+
+void Tremolo::releaseResources() {}
+
+void Tremolo::setParameter(int parameterIndex, float value)
+{
+    value = dsp256::jlimit(0.0f, 1.0f, value);
+    switch (parameterIndex) {
+    case 0: rate = value; break;
+    case 1: sync = value; break;
+    case 2: shape = value; break;
+    case 3: depth = value; break;
+    case 4: stereoPhase = value; break;
+    case 5: smoothing = value; break;
+    }
+    updateParameters();
+}
+
+float Tremolo::getParameter(int parameterIndex) const
+{
+    switch (parameterIndex) {
+    case 0: return rate;
+    case 1: return sync;
+    case 2: return shape;
+    case 3: return depth;
+    case 4: return stereoPhase;
+    case 5: return smoothing;
+    default: return 0.0f;
+    }
+}
+
+dsp256::String Tremolo::getParameterDisplay(int parameterIndex) const
+{
+    switch (parameterIndex) {
+    case 0: return dsp256::String(0.1f * std::pow(200.0f, rate), 2) + " Hz";
+    case 1: {
+        static const char* const names[] = { "Off", "1/1", "1/2", "1/4", "1/8", "1/8T", "1/16", "1/16T" };
+        return names[stepIndex(sync, NUM_SYNC_DIVISIONS)];
+    }
+    case 2: {
+        static const char* const names[] = { "Sine", "Triangle", "Square", "S&H" };
+        return names[stepIndex(shape, NUM_SHAPES)];
+    }
+    case 3: return dsp256::String(depth * 100.0f, 0) + "%";
+    case 4: return dsp256::String(stereoPhase * 180.0f, 0) + " deg";
+    case 5: return dsp256::String(smoothing * 20.0f, 1) + " ms";
+    default: return "";
+    }
+}
+
+int Tremolo::stepIndex(float normalized, int numSteps)
+{
+    return dsp256::jlimit(0, numSteps - 1,
+        static_cast<int>(normalized * static_cast<float>(numSteps - 1) + 0.5f));
+}
+
+double Tremolo::beatsPerCycle(int division)
+{
+    static const double beats[] = { 0.0, 4.0, 2.0, 1.0, 0.5, 1.0 / 3.0, 0.25, 1.0 / 6.0 };
+    return beats[dsp256::jlimit(0, NUM_SYNC_DIVISIONS - 1, division)];
+}
+
+void Tremolo::updateParameters()
+{
+    validateParameters();
+
+    shapeIndex = stepIndex(shape, NUM_SHAPES);
+    syncIndex = stepIndex(sync, NUM_SYNC_DIVISIONS);
+
+    double hz = 0.1 * std::pow(200.0, static_cast<double>(rate));
+    if (syncIndex > 0 && transport.hasTempo)
+        hz = transport.bpm / 60.0 / beatsPerCycle(syncIndex);
+    phaseIncrement = static_cast<float>(hz / sampleRate);
+
+    const float smoothingSeconds = smoothing * 0.02f;
+    smoothingCoeff = smoothingSeconds > 0.0f
+        ? 1.0f - std::exp(-1.0f / (smoothingSeconds * static_cast<float>(sampleRate)))
+        : 1.0f;
+}
+
+void Tremolo::setTransportInfo(const TransportInfo& info)
+{
+    const bool tempoChanged = info.hasTempo != transport.hasTempo || info.bpm != transport.bpm;
+    transport = info;
+
+    if (syncIndex == 0 || !transport.hasTempo)
+        return;
+
+    if (tempoChanged)
+        updateParameters();
+
+    // Lock the LFO to the bar grid while the host is running
+    if (transport.isPlaying) {
+        const double cycles = transport.ppqPosition / beatsPerCycle(syncIndex);
+        lfoPhase = static_cast<float>(cycles - std::floor(cycles));
+        if (lfoPhase >= 1.0f) lfoPhase = 0.0f;
+    }
+}
+
+//==============================================================================
+float Tremolo::shapeValue(float phase, float hold) const
+{
+    switch (shapeIndex) {
+    case 0: {
+        const float pos = phase * static_cast<float>(SINE_TABLE_SIZE);
+        const int index = static_cast<int>(pos);
+        const float frac = pos - static_cast<float>(index);
+        return sineTable[static_cast<size_t>(index)]
+            + (sineTable[static_cast<size_t>(index) + 1] - sineTable[static_cast<size_t>(index)]) * frac;
+    }
+    case 1: return phase < 0.5f ? 4.0f * phase - 1.0f : 3.0f - 4.0f * phase;
+    case 2: return phase < 0.5f ? 1.0f : -1.0f;
+    default: return hold;
+    }
+}
+
+void Tremolo::renderGains(int numSamples)
+{
+    const float offset = stereoPhase * 0.5f;
+    const bool smoothEdges = shapeIndex >= 2;
+
+    for (int i = 0; i < numSamples; ++i) {
+        float phaseR = lfoPhase + offset;
+        if (phaseR >= 1.0f) phaseR -= 1.0f;
+
+        // Gain swings between 1 and (1 - depth)
+        const float targetL = 1.0f - depth * 0.5f * (1.0f - shapeValue(lfoPhase, holdL));
+        const float targetR = 1.0f - depth * 0.5f * (1.0f - shapeValue(phaseR, holdR));
+
+        if (smoothEdges) {
+            smoothedL += (targetL - smoothedL) * smoothingCoeff;
+            smoothedR += (targetR - smoothedR) * smoothingCoeff;
+        }
+        else {
+            smoothedL = targetL;
+            smoothedR = targetR;
+        }
+
+        gainL[static_cast<size_t>(i)] = smoothedL;
+        gainR[static_cast<size_t>(i)] = smoothedR;
+
+        // Advance; each side draws a new S&H value when its own phase wraps
+        const float previousR = phaseR;
+        lfoPhase += phaseIncrement;
+        if (lfoPhase >= 1.0f) {
+            lfoPhase -= 1.0f;
+            holdL = holdRandom.nextFloat() * 2.0f - 1.0f;
+        }
+        float nextR = lfoPhase + offset;
+        if (nextR >= 1.0f) nextR -= 1.0f;
+        if (nextR < previousR)
+            holdR = holdRandom.nextFloat() * 2.0f - 1.0f;
+    }
+}
+
+//==============================================================================
+void Tremolo::processBlock(float* left, float* right, int numSamples,
+    DelayMemoryPool& delayPool, FixedPointEngine& dspCore)
+{
+    dsp256::ignoreUnused(delayPool);
+
+    for (int start = 0; start < numSamples; start += GAIN_CHUNK) {
+        const int count = dsp256::jmin(GAIN_CHUNK, numSamples - start);
+        float* l = left + start;
+        float* r = right + start;
+
+        renderGains(count);
+
+        // Same Q12 in/out quantization as the per-sample path
+        dspCore.quantizeBlock(l, count);
+        dspCore.quantizeBlock(r, count);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            (Float4::load(l + i) * Float4::load(gainL.data() + i)).store(l + i);
+            (Float4::load(r + i) * Float4::load(gainR.data() + i)).store(r + i);
+        }
+        for (; i < count; ++i) {
+            l[i] *= gainL[static_cast<size_t>(i)];
+            r[i] *= gainR[static_cast<size_t>(i)];
+        }
+
+        dspCore.quantizeBlock(l, count);
+        dspCore.quantizeBlock(r, count);
+    }
+}
+
+void Tremolo::process(FixedPointSample& left, FixedPointSample& right,
+    DelayMemoryPool& delayPool, FixedPointEngine& dspCore)
+{
+    dsp256::ignoreUnused(delayPool);
+
+    renderGains(1);
+
+    left = dspCore.floatToQ12(dspCore.Q12ToFloat(left) * gainL[0]);
+    right = dspCore.floatToQ12(dspCore.Q12ToFloat(right) * gainR[0]);
+}
+
+void Tremolo::validateParameters()
+{
+    rate = dsp256::jlimit(0.0f, 1.0f, rate);
+    sync = dsp256::jlimit(0.0f, 1.0f, sync);
+    shape = dsp256::jlimit(0.0f, 1.0f, shape);
+    depth = dsp256::jlimit(0.0f, 1.0f, depth);
+    stereoPhase = dsp256::jlimit(0.0f, 1.0f, stereoPhase);
+    smoothing = dsp256::jlimit(0.0f, 1.0f, smoothing);
+}
@@ -0,0 +1,103 @@
+// Tremolo.h - Tremolo Effect Module
+#pragma once
+
+#include "EffectModule.h"
+#include "FixedPointDSP.h"
+#include "DelayMemoryPool.h"
+#include <array>
+
+//==============================================================================
+// Tremolo Effect Module
+// Amplitude modulation with sine, triangle, square and sample-and-hold
+// shapes, free-running or synced to the host tempo. The LFO is rendered once
+// per block into per-channel gain arrays which are then applied with a
+// vectorized multiply, so the per-sample cost is one multiply per channel.
+//==============================================================================
+class Tremolo : public EffectModule {
+public:
+    Tremolo();
+    ~Tremolo() override = default;
+
+    // Module identification
+    dsp256::String getModuleName() const override { return "Tremolo"; }
+    dsp256::String getModuleDescription() const override {
+        return "Classic amplitude tremolo with stereo auto-pan and host sync.";
+    }
+
+    // Parameter configuration
+    std::vector<EffectParameter> getParameterDefinitions() const override;
+    int getParameterCount() const override { return 6; }
+
+    // Preset management
+    std::vector<EffectPreset> getFactoryPresets() const override;
+    void loadPreset(const EffectPreset& preset) override;
+    EffectPreset getCurrentPreset() const override;
+
+    // DSP lifecycle
+    void prepare(double sampleRate, int samplesPerBlock) override;
+    void reset() override;
+    void releaseResources() override;
+
+    // Parameter updates
+    void setParameter(int parameterIndex, float value) override;
+    float getParameter(int parameterIndex) const override;
+    dsp256::String getParameterDisplay(int parameterIndex) const override;
+
+    // Audio processing
+    void process(FixedPointSample& left, FixedPointSample& right,
+        DelayMemoryPool& delayPool, FixedPointEngine& dspCore) override;
+    void processBlock(float* left, float* right, int numSamples,
+        DelayMemoryPool& delayPool, FixedPointEngine& dspCore) override;
+
+    // Tempo sync
+    void setTransportInfo(const TransportInfo& info) override;
+
+private:
+    // Parameters (0.0 to 1.0 normalized)
+    float rate = 0.4f;            // Free rate: 0.1-20 Hz (logarithmic)
+    float sync = 0.0f;            // Sync division: off, 1/1 ... 1/16T
+    float shape = 0.0f;           // Sine / triangle / square / sample-and-hold
+    float depth = 0.5f;           // Depth: 0-100%
+    float stereoPhase = 0.0f;     // L/R phase offset: 0-180 degrees (auto-pan)
+    float smoothing = 0.2f;       // Edge smoothing for square/S&H: 0-20 ms
+
+    static constexpr int NUM_SHAPES = 4;
+    static constexpr int NUM_SYNC_DIVISIONS = 8;
+    static constexpr int SINE_TABLE_SIZE = 1024;
+    static constexpr int GAIN_CHUNK = 256;   // Gain arrays are rendered in chunks of this
+
+    std::array<float, SINE_TABLE_SIZE + 1> sineTable{};
+
+    // Gain arrays for the current chunk
+    alignas(16) std::array<float, GAIN_CHUNK> gainL{};
+    alignas(16) std::array<float, GAIN_CHUNK> gainR{};
+
+    // LFO state
+    float lfoPhase = 0.0f;
+    float phaseIncrement = 0.0f;
+    float smoothedL = 1.0f;
+    float smoothedR = 1.0f;
+    float smoothingCoeff = 1.0f;
+    float holdL = 0.0f;
+    float holdR = 0.0f;
+    dsp256::Random holdRandom;
+
+    // Host transport
+    TransportInfo transport;
+    int shapeIndex = 0;
+    int syncIndex = 0;
+
+    // Sample rate and block size
+    double sampleRate = 44100.0;
+    int blockSize = 512;
+
+    // Helper methods
+    void updateParameters();
+    void renderGains(int numSamples);
+    float shapeValue(float phase, float hold) const;
+    static double beatsPerCycle(int division);
+    static int stepIndex(float normalized, int numSteps);
+
+    // Parameter validation
+    void validateParameters();
+};
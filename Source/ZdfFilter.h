@@ -0,0 +1,110 @@
+// ZdfFilter.h - Zero-delay-feedback (TPT) filter kernels
+#pragma once
+
+#include "SimdLanes.h"
+#include <array>
+#include <cmath>
+
+//==============================================================================
+// Prewarped integrator gain g = tan(pi * fc / fs), tabulated on an octave
+// grid so modulation is an add in octaves plus one interpolated lookup -
+// no tan() or exp2() per sample. Rebuilt in prepare() for the sample rate.
+//==============================================================================
+class ZdfTanTable {
+public:
+    static constexpr float BASE_HZ = 5.0f;            // Octave 0
+    static constexpr int NUM_OCTAVES = 13;            // 5 Hz .. 40.96 kHz
+    static constexpr int STEPS_PER_OCTAVE = 256;
+    static constexpr int TABLE_SIZE = NUM_OCTAVES * STEPS_PER_OCTAVE;
+
+    void prepare(double sampleRate) {
+        const double nyquistLimit = 0.49 * sampleRate;
+        for (int i = 0; i <= TABLE_SIZE; ++i) {
+            const double hz = BASE_HZ * std::exp2(static_cast<double>(i) / STEPS_PER_OCTAVE);
+            const double fc = hz < nyquistLimit ? hz : nyquistLimit;
+            table[static_cast<size_t>(i)] = static_cast<float>(std::tan(3.14159265358979 * fc / sampleRate));
+        }
+    }
+
+    // Octaves above BASE_HZ; clamped to the table range
+    inline float lookup(float octaves) const {
+        float pos = octaves * static_cast<float>(STEPS_PER_OCTAVE);
+        if (pos < 0.0f) pos = 0.0f;
+        if (pos > static_cast<float>(TABLE_SIZE - 1)) pos = static_cast<float>(TABLE_SIZE - 1);
+        const int index = static_cast<int>(pos);
+        const float frac = pos - static_cast<float>(index);
+        return table[static_cast<size_t>(index)]
+            + (table[static_cast<size_t>(index) + 1] - table[static_cast<size_t>(index)]) * frac;
+    }
+
+    inline Float4 lookup(Float4 octaves) const {
+        float oct[4];
+        octaves.store(oct);
+        return Float4::set(lookup(oct[0]), lookup(oct[1]), lookup(oct[2]), lookup(oct[3]));
+    }
+
+    // Control-rate helpers (uses log2, so keep it out of per-sample code)
+    static float octavesForHz(float hz) { return std::log2(hz / BASE_HZ); }
+    float lookupHz(float hz) const { return lookup(octavesForHz(hz)); }
+
+private:
+    std::array<float, TABLE_SIZE + 1> table{};
+};
+
+//==============================================================================
+// TPT state-variable filter (Zavalishin/Simper form), one filter per lane.
+// g and k can change every sample without zipper or stability issues.
+// k = 1/Q: 2 is critically damped, towards 0 self-oscillates.
+//==============================================================================
+struct ZdfSvf {
+    Float4 ic1eq = Float4::broadcast(0.0f);
+    Float4 ic2eq = Float4::broadcast(0.0f);
+
+    struct Outputs {
+        Float4 low;
+        Float4 band;
+        Float4 high;
+    };
+
+    inline Outputs process(Float4 v0, Float4 g, Float4 k) {
+        const Float4 one = Float4::broadcast(1.0f);
+        const Float4 two = Float4::broadcast(2.0f);
+
+        const Float4 a1 = one / (one + g * (g + k));
+        const Float4 a2 = g * a1;
+        const Float4 a3 = g * a2;
+
+        const Float4 v3 = v0 - ic2eq;
+        const Float4 v1 = a1 * ic1eq + a2 * v3;
+        const Float4 v2 = ic2eq + a2 * ic1eq + a3 * v3;
+
+        ic1eq = two * v1 - ic1eq;
+        ic2eq = two * v2 - ic2eq;
+
+        return { v2, v1, v0 - k * v1 - v2 };
+    }
+
+    void reset() {
+        ic1eq = Float4::broadcast(0.0f);
+        ic2eq = Float4::broadcast(0.0f);
+    }
+};
+
+//==============================================================================
+// TPT one-pole low-pass, one filter per lane. Same prewarped g as ZdfSvf;
+// pass G = g / (1 + g) from coefficient() so the divide stays out of the loop.
+//==============================================================================
+struct ZdfOnePole {
+    Float4 state = Float4::broadcast(0.0f);
+
+    static inline Float4 coefficient(Float4 g) { return g / (Float4::broadcast(1.0f) + g); }
+
+    inline Float4 processLowPass(Float4 x, Float4 G) {
+        const Float4 v = (x - state) * G;
+        const Float4 y = v + state;
+        state = y + v;
+        return y;
+    }
+
+    void reset() { state = Float4::broadcast(0.0f); }
+};
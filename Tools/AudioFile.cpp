@@ -0,0 +1,488 @@
+// AudioFile.cpp - Streaming WAV/AIFF reading and writing for the offline tools
+#include "AudioFile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr int64_t MAX_CHUNK_BYTES = 0xffffffffLL - 64;   // 32-bit RIFF/FORM sizes
+
+uint32_t readLE32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24); }
+uint16_t readLE16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+uint32_t readBE32(const uint8_t* p) { return (static_cast<uint32_t>(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3]; }
+uint16_t readBE16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+
+void writeLE32(uint8_t* p, uint32_t v) { p[0] = uint8_t(v); p[1] = uint8_t(v >> 8); p[2] = uint8_t(v >> 16); p[3] = uint8_t(v >> 24); }
+void writeLE16(uint8_t* p, uint16_t v) { p[0] = uint8_t(v); p[1] = uint8_t(v >> 8); }
+void writeBE32(uint8_t* p, uint32_t v) { p[0] = uint8_t(v >> 24); p[1] = uint8_t(v >> 16); p[2] = uint8_t(v >> 8); p[3] = uint8_t(v); }
+void writeBE16(uint8_t* p, uint16_t v) { p[0] = uint8_t(v >> 8); p[1] = uint8_t(v); }
+
+bool readExactly(std::FILE* file, void* destination, size_t numBytes)
+{
+    return std::fread(destination, 1, numBytes, file) == numBytes;
+}
+
+bool seekTo(std::FILE* file, int64_t position)
+{
+#if defined(_WIN32)
+    return _fseeki64(file, position, SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(position), SEEK_SET) == 0;
+#endif
+}
+
+// AIFF stores the sample rate as an 80-bit IEEE extended float
+double readExtended(const uint8_t* p)
+{
+    const int exponent = ((p[0] & 0x7f) << 8) | p[1];
+    uint64_t mantissa = 0;
+    for (int i = 0; i < 8; ++i)
+        mantissa = (mantissa << 8) | p[2 + i];
+
+    if (exponent == 0 && mantissa == 0)
+        return 0.0;
+    const double value = std::ldexp(static_cast<double>(mantissa), exponent - 16383 - 63);
+    return (p[0] & 0x80) != 0 ? -value : value;
+}
+
+void writeExtended(uint8_t* p, double value)
+{
+    std::memset(p, 0, 10);
+    if (value <= 0.0)
+        return;
+
+    int exponent = 0;
+    const double fraction = std::frexp(value, &exponent);      // value = fraction * 2^exponent
+    const uint64_t mantissa = static_cast<uint64_t>(std::ldexp(fraction, 64));
+    const int biased = exponent - 1 + 16383;
+    p[0] = static_cast<uint8_t>(biased >> 8);
+    p[1] = static_cast<uint8_t>(biased);
+    for (int i = 0; i < 8; ++i)
+        p[2 + i] = static_cast<uint8_t>(mantissa >> (56 - 8 * i));
+}
+
+// Integer sample in 'bits' (sign-extended) from the raw bytes
+int32_t readInt(const uint8_t* p, int bytes, bool bigEndian)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < bytes; ++i)
+        v |= static_cast<uint32_t>(p[bigEndian ? bytes - 1 - i : i]) << (8 * i);
+    const int shift = 32 - 8 * bytes;
+    return static_cast<int32_t>(v << shift) >> shift;
+}
+
+void writeInt(uint8_t* p, int32_t value, int bytes, bool bigEndian)
+{
+    const uint32_t v = static_cast<uint32_t>(value);
+    for (int i = 0; i < bytes; ++i)
+        p[bigEndian ? bytes - 1 - i : i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+// Rounded to nearest and clipped to +/- full scale
+int32_t floatToInt(float sample, int bits)
+{
+    const double scale = std::ldexp(1.0, bits - 1);
+    const long long maxValue = static_cast<long long>(scale) - 1;
+    const long long v = std::llrint(static_cast<double>(sample) * scale);
+    return static_cast<int32_t>(v < -maxValue ? -maxValue : (v > maxValue ? maxValue : v));
+}
+
+} // namespace
+
+//==============================================================================
+bool AudioFileFormat::containerForPath(const std::string& path, Container& container)
+{
+    const auto dot = path.find_last_of('.');
+    if (dot == std::string::npos)
+        return false;
+
+    std::string extension = path.substr(dot + 1);
+    for (auto& c : extension)
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+    if (extension == "wav" || extension == "wave") {
+        container = Container::Wav;
+        return true;
+    }
+    if (extension == "aif" || extension == "aiff" || extension == "aifc") {
+        container = Container::Aiff;
+        return true;
+    }
+    return false;
+}
+
+//==============================================================================
+AudioFileReader::~AudioFileReader()
+{
+    if (file != nullptr)
+        std::fclose(file);
+}
+
+bool AudioFileReader::open(const std::string& path, std::string& error)
+{
+    file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    uint8_t header[12];
+    if (!readExactly(file, header, sizeof(header))) {
+        error = "not an audio file: " + path;
+        return false;
+    }
+
+    bool ok = false;
+    if (std::memcmp(header, "RIFF", 4) == 0 && std::memcmp(header + 8, "WAVE", 4) == 0)
+        ok = parseWav(error);
+    else if (std::memcmp(header, "FORM", 4) == 0
+        && (std::memcmp(header + 8, "AIFF", 4) == 0 || std::memcmp(header + 8, "AIFC", 4) == 0))
+        ok = parseAiff(error);
+    else
+        error = "not a WAV or AIFF file";
+
+    if (!ok) {
+        error = path + ": " + error;
+        return false;
+    }
+
+    const int bytesPerSample = format.bitsPerSample / 8;
+    bytesPerFrame = bytesPerSample * format.numChannels;
+    return true;
+}
+
+bool AudioFileReader::parseWav(std::string& error)
+{
+    format.container = AudioFileFormat::Container::Wav;
+    bigEndian = false;
+    bool haveFormat = false;
+    int64_t dataStart = -1;
+    int64_t dataBytes = 0;
+    int64_t position = 12;
+
+    uint8_t chunk[8];
+    while (readExactly(file, chunk, sizeof(chunk))) {
+        const int64_t size = readLE32(chunk + 4);
+        position += 8;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            uint8_t fmt[40] = {};
+            if (size < 16 || !readExactly(file, fmt, static_cast<size_t>(std::min<int64_t>(size, 40)))) {
+                error = "bad fmt chunk";
+                return false;
+            }
+
+            uint16_t tag = readLE16(fmt);
+            if (tag == 0xfffe && size >= 40)
+                tag = readLE16(fmt + 24);          // Extensible: first two bytes of the subformat GUID
+
+            format.numChannels = readLE16(fmt + 2);
+            format.sampleRate = readLE32(fmt + 4);
+            format.bitsPerSample = readLE16(fmt + 14);
+            format.isFloat = tag == 3;
+            haveFormat = true;
+
+            if ((tag != 1 && tag != 3) || (format.isFloat && format.bitsPerSample != 32 && format.bitsPerSample != 64)) {
+                error = "unsupported WAV encoding";
+                return false;
+            }
+        }
+        else if (std::memcmp(chunk, "data", 4) == 0) {
+            dataStart = position;
+            dataBytes = size;
+            break;
+        }
+
+        position += size + (size & 1);
+        if (!seekTo(file, position))
+            break;
+    }
+
+    if (!haveFormat || dataStart < 0) {
+        error = "missing fmt or data chunk";
+        return false;
+    }
+    if (format.numChannels < 1 || format.bitsPerSample % 8 != 0 || format.bitsPerSample < 8 || format.bitsPerSample > 64) {
+        error = "unsupported WAV layout";
+        return false;
+    }
+
+    totalFrames = dataBytes / (format.numChannels * (format.bitsPerSample / 8));
+    return seekTo(file, dataStart);
+}
+
+bool AudioFileReader::parseAiff(std::string& error)
+{
+    format.container = AudioFileFormat::Container::Aiff;
+    bigEndian = true;
+    bool haveFormat = false;
+    int64_t dataStart = -1;
+    int64_t position = 12;
+
+    uint8_t chunk[8];
+    while (readExactly(file, chunk, sizeof(chunk))) {
+        const int64_t size = readBE32(chunk + 4);
+        position += 8;
+
+        if (std::memcmp(chunk, "COMM", 4) == 0) {
+            uint8_t comm[22] = {};
+            if (size < 18 || !readExactly(file, comm, static_cast<size_t>(std::min<int64_t>(size, 22)))) {
+                error = "bad COMM chunk";
+                return false;
+            }
+
+            format.numChannels = readBE16(comm);
+            totalFrames = readBE32(comm + 2);
+            format.bitsPerSample = readBE16(comm + 6);
+            format.sampleRate = readExtended(comm + 8);
+            format.isFloat = false;
+            haveFormat = true;
+
+            if (size >= 22) {
+                if (std::memcmp(comm + 18, "sowt", 4) == 0) {
+                    bigEndian = false;
+                }
+                else if (std::memcmp(comm + 18, "fl32", 4) == 0 || std::memcmp(comm + 18, "FL32", 4) == 0) {
+                    format.isFloat = true;
+                    format.bitsPerSample = 32;
+                }
+                else if (std::memcmp(comm + 18, "fl64", 4) == 0 || std::memcmp(comm + 18, "FL64", 4) == 0) {
+                    format.isFloat = true;
+                    format.bitsPerSample = 64;
+                }
+                else if (std::memcmp(comm + 18, "NONE", 4) != 0 && std::memcmp(comm + 18, "twos", 4) != 0) {
+                    error = "unsupported AIFC compression";
+                    return false;
+                }
+            }
+        }
+        else if (std::memcmp(chunk, "SSND", 4) == 0) {
+            uint8_t ssnd[8];
+            if (!readExactly(file, ssnd, sizeof(ssnd))) {
+                error = "bad SSND chunk";
+                return false;
+            }
+            dataStart = position + 8 + readBE32(ssnd);
+        }
+
+        position += size + (size & 1);
+        if (!seekTo(file, position))
+            break;
+    }
+
+    if (!haveFormat || dataStart < 0) {
+        error = "missing COMM or SSND chunk";
+        return false;
+    }
+    if (format.numChannels < 1 || format.bitsPerSample % 8 != 0 || format.bitsPerSample < 8 || format.bitsPerSample > 64) {
+        error = "unsupported AIFF layout";
+        return false;
+    }
+
+    return seekTo(file, dataStart);
+}
+
+int AudioFileReader::read(float* const* channels, int numFrames)
+{
+    const int frames = static_cast<int>(std::min<int64_t>(numFrames, totalFrames - framesRead));
+    if (frames <= 0)
+        return 0;
+
+    ioBuffer.resize(static_cast<size_t>(frames) * static_cast<size_t>(bytesPerFrame));
+    const size_t bytesRead = std::fread(ioBuffer.data(), 1, ioBuffer.size(), file);
+    const int framesAvailable = static_cast<int>(bytesRead / static_cast<size_t>(bytesPerFrame));
+
+    const int bytesPerSample = format.bitsPerSample / 8;
+    const float intScale = 1.0f / static_cast<float>(std::ldexp(1.0, format.bitsPerSample - 1));
+
+    for (int ch = 0; ch < format.numChannels; ++ch) {
+        const uint8_t* source = ioBuffer.data() + ch * bytesPerSample;
+        float* destination = channels[ch];
+
+        for (int i = 0; i < framesAvailable; ++i, source += bytesPerFrame) {
+            if (format.isFloat && bytesPerSample == 4) {
+                const uint32_t bits = bigEndian ? readBE32(source) : readLE32(source);
+                std::memcpy(&destination[i], &bits, sizeof(float));
+            }
+            else if (format.isFloat) {
+                uint64_t bits = 0;
+                for (int b = 0; b < 8; ++b)
+                    bits |= static_cast<uint64_t>(source[bigEndian ? 7 - b : b]) << (8 * b);
+                double value;
+                std::memcpy(&value, &bits, sizeof(double));
+                destination[i] = static_cast<float>(value);
+            }
+            else if (bytesPerSample == 1 && !bigEndian) {
+                destination[i] = static_cast<float>(static_cast<int>(source[0]) - 128) * intScale;   // WAV 8-bit is unsigned
+            }
+            else {
+                destination[i] = static_cast<float>(readInt(source, bytesPerSample, bigEndian)) * intScale;
+            }
+        }
+    }
+
+    framesRead += framesAvailable;
+    return framesAvailable;
+}
+
+//==============================================================================
+AudioFileWriter::~AudioFileWriter()
+{
+    close();
+}
+
+bool AudioFileWriter::open(const std::string& path, const AudioFileFormat& newFormat, std::string& error)
+{
+    format = newFormat;
+    const bool validBits = format.isFloat ? format.bitsPerSample == 32
+                                          : (format.bitsPerSample == 16 || format.bitsPerSample == 24 || format.bitsPerSample == 32);
+    if (!validBits || format.numChannels < 1) {
+        error = "unsupported output format for " + path;
+        return false;
+    }
+
+    file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        error = "cannot create " + path;
+        return false;
+    }
+
+    bytesPerFrame = format.bitsPerSample / 8 * format.numChannels;
+    framesWritten = 0;
+    failed = !writeHeader();
+    if (failed)
+        error = "cannot write " + path;
+    return !failed;
+}
+
+bool AudioFileWriter::write(const float* const* channels, int numFrames)
+{
+    if (file == nullptr || failed)
+        return false;
+    if ((framesWritten + numFrames) * bytesPerFrame > MAX_CHUNK_BYTES) {
+        failed = true;                                     // Beyond what 32-bit headers can describe
+        return false;
+    }
+
+    const bool bigEndian = format.container == AudioFileFormat::Container::Aiff;
+    const int bytesPerSample = format.bitsPerSample / 8;
+    ioBuffer.resize(static_cast<size_t>(numFrames) * static_cast<size_t>(bytesPerFrame));
+
+    for (int ch = 0; ch < format.numChannels; ++ch) {
+        uint8_t* destination = ioBuffer.data() + ch * bytesPerSample;
+        const float* source = channels[ch];
+
+        for (int i = 0; i < numFrames; ++i, destination += bytesPerFrame) {
+            if (format.isFloat) {
+                uint32_t bits;
+                std::memcpy(&bits, &source[i], sizeof(float));
+                if (bigEndian)
+                    writeBE32(destination, bits);
+                else
+                    writeLE32(destination, bits);
+            }
+            else {
+                writeInt(destination, floatToInt(source[i], format.bitsPerSample), bytesPerSample, bigEndian);
+            }
+        }
+    }
+
+    failed = std::fwrite(ioBuffer.data(), 1, ioBuffer.size(), file) != ioBuffer.size();
+    framesWritten += failed ? 0 : numFrames;
+    return !failed;
+}
+
+bool AudioFileWriter::close()
+{
+    if (file == nullptr)
+        return !failed;
+
+    const int64_t dataBytes = framesWritten * bytesPerFrame;
+    if (!failed && (dataBytes & 1) != 0)
+        failed = std::fputc(0, file) == EOF;               // Chunks are padded to an even size
+
+    if (!failed)
+        failed = !seekTo(file, 0) || !writeHeader();
+
+    failed = std::fclose(file) != 0 || failed;
+    file = nullptr;
+    return !failed;
+}
+
+bool AudioFileWriter::writeHeader()
+{
+    const uint32_t dataBytes = static_cast<uint32_t>(framesWritten * bytesPerFrame);
+    const uint32_t padding = dataBytes & 1;
+    uint8_t header[80] = {};
+    size_t length = 0;
+
+    if (format.container == AudioFileFormat::Container::Wav) {
+        const uint16_t tag = format.isFloat ? 3 : 1;
+        const uint32_t factBytes = format.isFloat ? 12 : 0;   // Required for non-PCM data
+
+        std::memcpy(header, "RIFF", 4);
+        writeLE32(header + 4, 4 + 24 + factBytes + 8 + dataBytes + padding);
+        std::memcpy(header + 8, "WAVEfmt ", 8);
+        writeLE32(header + 16, 16);
+        writeLE16(header + 20, tag);
+        writeLE16(header + 22, static_cast<uint16_t>(format.numChannels));
+        writeLE32(header + 24, static_cast<uint32_t>(format.sampleRate));
+        writeLE32(header + 28, static_cast<uint32_t>(format.sampleRate) * static_cast<uint32_t>(bytesPerFrame));
+        writeLE16(header + 32, static_cast<uint16_t>(bytesPerFrame));
+        writeLE16(header + 34, static_cast<uint16_t>(format.bitsPerSample));
+        length = 36;
+
+        if (format.isFloat) {
+            std::memcpy(header + length, "fact", 4);
+            writeLE32(header + length + 4, 4);
+            writeLE32(header + length + 8, static_cast<uint32_t>(framesWritten));
+            length += 12;
+        }
+
+        std::memcpy(header + length, "data", 4);
+        writeLE32(header + length + 4, dataBytes);
+        length += 8;
+    }
+    else {
+        // Float needs AIFC: a version chunk and a compression type in COMM
+        const bool aifc = format.isFloat;
+        const uint32_t commBytes = aifc ? 18 + 4 + 10 : 18;
+        const uint32_t fverBytes = aifc ? 12 : 0;
+
+        std::memcpy(header, "FORM", 4);
+        writeBE32(header + 4, 4 + fverBytes + 8 + commBytes + 16 + dataBytes + padding);
+        std::memcpy(header + 8, aifc ? "AIFC" : "AIFF", 4);
+        length = 12;
+
+        if (aifc) {
+            std::memcpy(header + length, "FVER", 4);
+            writeBE32(header + length + 4, 4);
+            writeBE32(header + length + 8, 0xa2805140);
+            length += 12;
+        }
+
+        std::memcpy(header + length, "COMM", 4);
+        writeBE32(header + length + 4, commBytes);
+        writeBE16(header + length + 8, static_cast<uint16_t>(format.numChannels));
+        writeBE32(header + length + 10, static_cast<uint32_t>(framesWritten));
+        writeBE16(header + length + 14, static_cast<uint16_t>(format.bitsPerSample));
+        writeExtended(header + length + 16, format.sampleRate);
+        length += 26;
+
+        if (aifc) {
+            std::memcpy(header + length, "fl32", 4);
+            header[length + 4] = 8;                         // Pascal string, padded to even
+            std::memcpy(header + length + 5, "Float 32", 8);
+            length += 14;
+        }
+
+        std::memcpy(header + length, "SSND", 4);
+        writeBE32(header + length + 4, 8 + dataBytes);
+        length += 16;                                       // Offset and block size stay 0
+    }
+
+    return std::fwrite(header, 1, length, file) == length;
+}
@@ -0,0 +1,83 @@
+// AudioFile.h - Streaming WAV/AIFF reading and writing for the offline tools
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+//==============================================================================
+// Plain C++ replacement for the few juce::AudioFormat features the command
+// line tools need. Reads PCM 8/16/24/32-bit and 32/64-bit float from WAV
+// (including WAVE_FORMAT_EXTENSIBLE) and AIFF/AIFC (NONE, sowt, fl32, fl64);
+// writes PCM 16/24/32-bit or 32-bit float to WAV or AIFF (float as AIFC).
+// Samples are deinterleaved to float with JUCE's scaling (int / 2^(bits-1)),
+// and written back with JUCE's rounding and clipping, so a float file passes
+// through bit-exactly.
+//==============================================================================
+struct AudioFileFormat {
+    enum class Container { Wav, Aiff };
+
+    Container container = Container::Wav;
+    double sampleRate = 44100.0;
+    int numChannels = 2;
+    int bitsPerSample = 32;
+    bool isFloat = true;
+
+    // .wav/.wave or .aif/.aiff/.aifc; false for anything else
+    static bool containerForPath(const std::string& path, Container& container);
+};
+
+class AudioFileReader {
+public:
+    AudioFileReader() = default;
+    ~AudioFileReader();
+
+    bool open(const std::string& path, std::string& error);
+    const AudioFileFormat& getFormat() const { return format; }
+    int64_t getLengthInFrames() const { return totalFrames; }
+
+    // Deinterleaves up to numFrames into 'channels' (one per file channel);
+    // returns the frames read, 0 at the end of the data
+    int read(float* const* channels, int numFrames);
+
+private:
+    std::FILE* file = nullptr;
+    AudioFileFormat format;
+    bool bigEndian = false;
+    int bytesPerFrame = 0;
+    int64_t totalFrames = 0;
+    int64_t framesRead = 0;
+    std::vector<uint8_t> ioBuffer;
+
+    bool parseWav(std::string& error);
+    bool parseAiff(std::string& error);
+
+    AudioFileReader(const AudioFileReader&) = delete;
+    AudioFileReader& operator=(const AudioFileReader&) = delete;
+};
+
+class AudioFileWriter {
+public:
+    AudioFileWriter() = default;
+    ~AudioFileWriter();
+
+    // Creates 'path'; the header is completed by close()
+    bool open(const std::string& path, const AudioFileFormat& format, std::string& error);
+
+    bool write(const float* const* channels, int numFrames);
+    bool close();
+
+private:
+    std::FILE* file = nullptr;
+    AudioFileFormat format;
+    int bytesPerFrame = 0;
+    int64_t framesWritten = 0;
+    bool failed = false;
+    std::vector<uint8_t> ioBuffer;
+
+    bool writeHeader();
+
+    AudioFileWriter(const AudioFileWriter&) = delete;
+    AudioFileWriter& operator=(const AudioFileWriter&) = delete;
+};
@@ -0,0 +1,542 @@
+// Benchmark.cpp - Microbenchmarks for the reverb network and fixed-point kernels
+//
+// Times ReverbHall (per-sample process(), processBlock(), processBlockMultichannel()
+// on quad, 5.1 and 7.1, and each network stage), the FixedPointEngine ops and DelayMemoryPool reads/writes across
+// block sizes and sample rates, and writes the results as JSON so runs from
+// different releases can be diffed. Built by CMake as dsp256_bench:
+//
+//     dsp256_bench [--quick] [--filter text] [--min-time-ms n]
+//                  [--repetitions n] [--output file.json]
+
+#include "ReverbHall.h"
+#include "FixedPointDSP.h"
+#include "DelayMemoryPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+ #include <intrin.h>
+ #define DSP256_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+ #include <x86intrin.h>
+ #define DSP256_HAS_TSC 1
+#else
+ #define DSP256_HAS_TSC 0
+#endif
+
+#ifndef DSP256_VERSION
+ #define DSP256_VERSION "unknown"
+#endif
+
+namespace {
+
+//==============================================================================
+// Timing
+//==============================================================================
+struct Options {
+    std::vector<double> sampleRates{ 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+    std::vector<int> blockSizes{ 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+    std::string filter;
+    std::string outputPath;
+    double minTimeMs = 20.0;       // Per repetition
+    int repetitions = 5;           // The median is reported
+};
+
+struct Measurement {
+    double nsPerSample = 0.0;
+    double cyclesPerSample = 0.0;  // TSC (reference) cycles; 0 without a TSC
+    long long samples = 0;         // Samples processed across all repetitions
+};
+
+struct Result {
+    std::string group;
+    std::string name;
+    double sampleRate = 0.0;       // 0 for kernels that do not depend on it
+    int blockSize = 0;
+    Measurement measurement;
+};
+
+volatile float sink = 0.0f;        // Keeps results observable to the optimizer
+
+inline unsigned long long readCycles() noexcept
+{
+#if DSP256_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// Runs 'runBlock' (one block of 'blockSize' samples per call) until each
+// repetition has lasted at least minTimeMs; reports the median repetition.
+template <typename BlockFn>
+Measurement measure(BlockFn&& runBlock, int blockSize, const Options& options)
+{
+    using Clock = std::chrono::steady_clock;
+
+    for (int i = 0; i < 4; ++i)
+        runBlock();
+
+    std::vector<double> nsPerSample;
+    std::vector<double> cyclesPerSample;
+    Measurement result;
+
+    for (int rep = 0; rep < options.repetitions; ++rep) {
+        long long blocks = 0;
+        double elapsedNs = 0.0;
+        const auto start = Clock::now();
+        const unsigned long long startCycles = readCycles();
+
+        do {
+            for (int i = 0; i < 16; ++i)
+                runBlock();
+            blocks += 16;
+            elapsedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        } while (elapsedNs < options.minTimeMs * 1.0e6);
+
+        const double cycles = static_cast<double>(readCycles() - startCycles);
+        const double samples = static_cast<double>(blocks) * blockSize;
+        nsPerSample.push_back(elapsedNs / samples);
+        cyclesPerSample.push_back(cycles / samples);
+        result.samples += blocks * blockSize;
+    }
+
+    auto median = [](std::vector<double>& values) {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    };
+    result.nsPerSample = median(nsPerSample);
+    result.cyclesPerSample = median(cyclesPerSample);
+    return result;
+}
+
+std::vector<float> makeNoise(int numSamples, int64_t seed)
+{
+    dsp256::Random random(seed);
+    std::vector<float> samples(static_cast<size_t>(numSamples));
+    for (auto& s : samples)
+        s = (random.nextFloat() * 2.0f - 1.0f) * 0.25f;
+    return samples;
+}
+
+} // namespace
+
+//==============================================================================
+// ReverbHall: the whole module and its network stages in isolation. Each
+// stage is fed noise directly, so its figure is its own cost without the
+// stages ahead of it.
+//==============================================================================
+class ReverbHallBenchmark {
+public:
+    ReverbHallBenchmark(double sampleRate, int blockSize)
+        : numSamples(blockSize),
+          inputL(makeNoise(blockSize, 1)),
+          inputR(makeNoise(blockSize, 2)),
+          left(static_cast<size_t>(blockSize)),
+          right(static_cast<size_t>(blockSize))
+    {
+        engine.prepare(sampleRate);
+        pool.prepare(sampleRate);
+        hall.prepare(sampleRate, blockSize);
+    }
+
+    void process()
+    {
+        for (int i = 0; i < numSamples; ++i) {
+            FixedPointSample l = engine.floatToQ12(inputL[static_cast<size_t>(i)]);
+            FixedPointSample r = engine.floatToQ12(inputR[static_cast<size_t>(i)]);
+            hall.process(l, r, pool, engine);
+            left[static_cast<size_t>(i)] = engine.Q12ToFloat(l);
+            right[static_cast<size_t>(i)] = engine.Q12ToFloat(r);
+        }
+        sink = left[0] + right[0];
+    }
+
+    void processBlock()
+    {
+        std::copy(inputL.begin(), inputL.end(), left.begin());
+        std::copy(inputR.begin(), inputR.end(), right.begin());
+        hall.processBlock(left.data(), right.data(), numSamples, pool, engine);
+        sink = left[0] + right[0];
+    }
+
+    void inputStage()
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+            sum += hall.processInputStage(inputL[static_cast<size_t>(i)], inputR[static_cast<size_t>(i)], engine);
+        sink = sum;
+    }
+
+    void earlyReflections()
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+            sum += hall.processEarlyReflections(inputL[static_cast<size_t>(i)], engine);
+        sink = sum;
+    }
+
+    void combBank()
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < numSamples; ++i) {
+            float side = 0.0f;
+            sum += hall.processCombBank(inputL[static_cast<size_t>(i)], engine, side) + side;
+        }
+        sink = sum;
+    }
+
+    void allpassChain()
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+            sum += hall.processAllpassChain(inputL[static_cast<size_t>(i)], engine);
+        sink = sum;
+    }
+
+    void damping()
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < numSamples; ++i) {
+            float wetL = 0.0f;
+            float wetR = 0.0f;
+            hall.processDamping(inputL[static_cast<size_t>(i)], inputR[static_cast<size_t>(i)], wetL, wetR);
+            sum += wetL + wetR;
+        }
+        sink = sum;
+    }
+
+private:
+    ReverbHall hall;
+    FixedPointEngine engine;
+    DelayMemoryPool pool;
+    int numSamples;
+    std::vector<float> inputL, inputR;
+    std::vector<float> left, right;
+};
+
+//==============================================================================
+// ReverbHall on a surround bus: processBlockMultichannel() with every channel
+// carrying input. Figures are per frame, so they compare directly with the
+// stereo processBlock() case.
+//==============================================================================
+class ReverbHallMultichannelBenchmark {
+public:
+    ReverbHallMultichannelBenchmark(double sampleRate, int blockSize, const OutputLayout& layout)
+        : numSamples(blockSize),
+          numChannels(layout.numChannels)
+    {
+        for (int c = 0; c < numChannels; ++c) {
+            inputs.push_back(makeNoise(blockSize, 1 + c));
+            outputs.emplace_back(static_cast<size_t>(blockSize));
+        }
+        for (int c = 0; c < numChannels; ++c)
+            channels[c] = outputs[static_cast<size_t>(c)].data();
+        engine.prepare(sampleRate);
+        pool.prepare(sampleRate);
+        hall.prepare(sampleRate, blockSize);
+        hall.setOutputLayout(layout);
+    }
+
+    void processBlockMultichannel()
+    {
+        for (int c = 0; c < numChannels; ++c)
+            std::copy(inputs[static_cast<size_t>(c)].begin(), inputs[static_cast<size_t>(c)].end(), channels[c]);
+        hall.processBlockMultichannel(channels, numChannels, numSamples, pool, engine);
+        sink = channels[0][0] + channels[1][0];
+    }
+
+private:
+    ReverbHall hall;
+    FixedPointEngine engine;
+    DelayMemoryPool pool;
+    int numSamples;
+    int numChannels;
+    std::vector<std::vector<float>> inputs;
+    std::vector<std::vector<float>> outputs;
+    float* channels[OutputLayout::MAX_CHANNELS] = {};
+};
+
+namespace {
+
+//==============================================================================
+// FixedPointEngine and DelayMemoryPool kernels (sample-rate independent)
+//==============================================================================
+struct KernelBenchmark {
+    explicit KernelBenchmark(int blockSize)
+        : numSamples(blockSize),
+          input(makeNoise(blockSize, 3)),
+          work(static_cast<size_t>(blockSize))
+    {
+        engine.prepare(48000.0);
+        pool.prepare(48000.0);
+        for (int i = 0; i < blockSize; ++i)
+            inputQ12.push_back(engine.floatToQ12(input[static_cast<size_t>(i)]));
+    }
+
+    void mac()
+    {
+        FixedPointSample acc;
+        const FixedPointSample coeff = engine.floatToQ12(0.7f);
+        bool overflow = false;
+        for (const auto& q : inputQ12)
+            acc = engine.mac(q, coeff, acc, overflow);
+        sink = static_cast<float>(acc.value) + (overflow ? 1.0f : 0.0f);
+    }
+
+    void multiply()
+    {
+        int32_t sum = 0;
+        const FixedPointSample coeff = engine.floatToQ12(0.7f);
+        bool overflow = false;
+        for (const auto& q : inputQ12)
+            sum += engine.multiply(q, coeff, overflow).value;
+        sink = static_cast<float>(sum) + (overflow ? 1.0f : 0.0f);
+    }
+
+    void floatToQ12()
+    {
+        int32_t sum = 0;
+        for (float f : input)
+            sum += engine.floatToQ12(f).value;
+        sink = static_cast<float>(sum);
+    }
+
+    void q12ToFloat()
+    {
+        float sum = 0.0f;
+        for (const auto& q : inputQ12)
+            sum += engine.Q12ToFloat(q);
+        sink = sum;
+    }
+
+    void quantizeBlock()
+    {
+        std::copy(input.begin(), input.end(), work.begin());
+        engine.quantizeBlock(work.data(), numSamples);
+        sink = work[0];
+    }
+
+    void dcBlock()
+    {
+        int32_t sum = 0;
+        for (const auto& q : inputQ12)
+            sum += engine.dcBlock(q, dcState).value;
+        sink = static_cast<float>(sum);
+    }
+
+    void poolWrite()
+    {
+        for (const auto& q : inputQ12)
+            pool.write(q.value, 0);
+        sink = static_cast<float>(pool.getSize());
+    }
+
+    void poolReadContended()
+    {
+        int32_t sum = 0;
+        bool contention = false;
+        for (int i = 0; i < numSamples; ++i)
+            sum += pool.readContended(1 + (i * 37 & 4095), i, contention);
+        sink = static_cast<float>(sum) + (contention ? 1.0f : 0.0f);
+    }
+
+    void poolReadFractional()
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+            sum += pool.readFractional(1.5f + static_cast<float>(i * 37 & 4095));
+        sink = sum;
+    }
+
+    int numSamples;
+    std::vector<float> input;
+    std::vector<float> work;
+    std::vector<FixedPointSample> inputQ12;
+    FixedPointEngine engine;
+    DelayMemoryPool pool;
+    float dcState = 0.0f;
+};
+
+//==============================================================================
+// Driver
+//==============================================================================
+bool selected(const Options& options, const char* group, const char* name)
+{
+    if (options.filter.empty())
+        return true;
+    const std::string id = std::string(group) + "/" + name;
+    return id.find(options.filter) != std::string::npos;
+}
+
+template <typename Fixture, typename Method>
+void run(std::vector<Result>& results, const Options& options, Fixture& fixture, Method method,
+    const char* group, const char* name, double sampleRate, int blockSize)
+{
+    if (!selected(options, group, name))
+        return;
+
+    Result result;
+    result.group = group;
+    result.name = name;
+    result.sampleRate = sampleRate;
+    result.blockSize = blockSize;
+    result.measurement = measure([&] { (fixture.*method)(); }, blockSize, options);
+
+    char rate[16] = "-";
+    if (sampleRate > 0.0)
+        std::snprintf(rate, sizeof(rate), "%.0f Hz", sampleRate);
+    std::fprintf(stderr, "%-16s %-17s %9s %5d  %8.2f ns/sample  %8.1f cycles/sample\n",
+        group, name, rate, blockSize, result.measurement.nsPerSample, result.measurement.cyclesPerSample);
+    results.push_back(result);
+}
+
+std::vector<Result> runAll(const Options& options)
+{
+    std::vector<Result> results;
+
+    for (double sampleRate : options.sampleRates) {
+        for (int blockSize : options.blockSizes) {
+            // A fresh module per case, so every case starts from the same state
+            ReverbHallBenchmark hall(sampleRate, blockSize);
+            run(results, options, hall, &ReverbHallBenchmark::process, "ReverbHall", "process", sampleRate, blockSize);
+            run(results, options, hall, &ReverbHallBenchmark::processBlock, "ReverbHall", "processBlock", sampleRate, blockSize);
+
+            ReverbHallMultichannelBenchmark quad(sampleRate, blockSize, OutputLayout{ 4, -1, false });
+            ReverbHallMultichannelBenchmark surround51(sampleRate, blockSize, OutputLayout{ 6, 3, false });
+            ReverbHallMultichannelBenchmark surround71(sampleRate, blockSize, OutputLayout{ 8, 3, false });
+            run(results, options, quad, &ReverbHallMultichannelBenchmark::processBlockMultichannel, "ReverbHall", "processBlock4ch", sampleRate, blockSize);
+            run(results, options, surround51, &ReverbHallMultichannelBenchmark::processBlockMultichannel, "ReverbHall", "processBlock6ch", sampleRate, blockSize);
+            run(results, options, surround71, &ReverbHallMultichannelBenchmark::processBlockMultichannel, "ReverbHall", "processBlock8ch", sampleRate, blockSize);
+            run(results, options, hall, &ReverbHallBenchmark::inputStage, "ReverbHall", "inputStage", sampleRate, blockSize);
+            run(results, options, hall, &ReverbHallBenchmark::earlyReflections, "ReverbHall", "earlyReflections", sampleRate, blockSize);
+            run(results, options, hall, &ReverbHallBenchmark::combBank, "ReverbHall", "combBank", sampleRate, blockSize);
+            run(results, options, hall, &ReverbHallBenchmark::allpassChain, "ReverbHall", "allpassChain", sampleRate, blockSize);
+            run(results, options, hall, &ReverbHallBenchmark::damping, "ReverbHall", "damping", sampleRate, blockSize);
+        }
+    }
+
+    for (int blockSize : options.blockSizes) {
+        KernelBenchmark kernels(blockSize);
+        run(results, options, kernels, &KernelBenchmark::mac, "FixedPoint", "mac", 0.0, blockSize);
+        run(results, options, kernels, &KernelBenchmark::multiply, "FixedPoint", "multiply", 0.0, blockSize);
+        run(results, options, kernels, &KernelBenchmark::floatToQ12, "FixedPoint", "floatToQ12", 0.0, blockSize);
+        run(results, options, kernels, &KernelBenchmark::q12ToFloat, "FixedPoint", "Q12ToFloat", 0.0, blockSize);
+        run(results, options, kernels, &KernelBenchmark::quantizeBlock, "FixedPoint", "quantizeBlock", 0.0, blockSize);
+        run(results, options, kernels, &KernelBenchmark::dcBlock, "FixedPoint", "dcBlock", 0.0, blockSize);
+        run(results, options, kernels, &KernelBenchmark::poolWrite, "DelayMemoryPool", "write", 0.0, blockSize);
+        run(results, options, kernels, &KernelBenchmark::poolReadContended, "DelayMemoryPool", "readContended", 0.0, blockSize);
+        run(results, options, kernels, &KernelBenchmark::poolReadFractional, "DelayMemoryPool", "readFractional", 0.0, blockSize);
+    }
+
+    return results;
+}
+
+const char* simdName()
+{
+#if DSP256_SIMD_SSE2
+    return "sse2";
+#elif DSP256_SIMD_NEON
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+void writeJson(std::FILE* out, const std::vector<Result>& results, const Options& options)
+{
+    std::fprintf(out, "{\n");
+    std::fprintf(out, "  \"suite\": \"dsp256_bench\",\n");
+    std::fprintf(out, "  \"version\": \"%s\",\n", DSP256_VERSION);
+    std::fprintf(out, "  \"simd\": \"%s\",\n", simdName());
+    std::fprintf(out, "  \"tsc\": %s,\n", DSP256_HAS_TSC ? "true" : "false");
+    std::fprintf(out, "  \"min_time_ms\": %g,\n", options.minTimeMs);
+    std::fprintf(out, "  \"repetitions\": %d,\n", options.repetitions);
+    std::fprintf(out, "  \"results\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        std::fprintf(out, "    { \"group\": \"%s\", \"name\": \"%s\", ", r.group.c_str(), r.name.c_str());
+        if (r.sampleRate > 0.0)
+            std::fprintf(out, "\"sample_rate\": %.0f, ", r.sampleRate);
+        else
+            std::fprintf(out, "\"sample_rate\": null, ");
+        std::fprintf(out, "\"block_size\": %d, \"ns_per_sample\": %.4f, ", r.blockSize, r.measurement.nsPerSample);
+        if (DSP256_HAS_TSC)
+            std::fprintf(out, "\"cycles_per_sample\": %.3f, ", r.measurement.cyclesPerSample);
+        else
+            std::fprintf(out, "\"cycles_per_sample\": null, ");
+        std::fprintf(out, "\"samples\": %lld }%s\n", r.measurement.samples, i + 1 < results.size() ? "," : "");
+    }
+
+    std::fprintf(out, "  ]\n}\n");
+}
+
+void printUsage()
+{
+    std::fprintf(stderr,
+        "usage: dsp256_bench [options]\n"
+        "  --quick             48k/192k and blocks 64/512/4096 only, 5 ms repetitions\n"
+        "  --filter text       only run benchmarks whose group/name contains text\n"
+        "  --min-time-ms n     minimum duration of each repetition (default 20)\n"
+        "  --repetitions n     repetitions per case, median reported (default 5)\n"
+        "  --output file       write JSON to file instead of stdout\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(arg, "--quick") == 0) {
+            options.sampleRates = { 48000.0, 192000.0 };
+            options.blockSizes = { 64, 512, 4096 };
+            options.minTimeMs = 5.0;
+            options.repetitions = 3;
+        }
+        else if (std::strcmp(arg, "--filter") == 0 && hasValue) {
+            options.filter = argv[++i];
+        }
+        else if (std::strcmp(arg, "--min-time-ms") == 0 && hasValue) {
+            options.minTimeMs = std::max(0.1, std::atof(argv[++i]));
+        }
+        else if (std::strcmp(arg, "--repetitions") == 0 && hasValue) {
+            options.repetitions = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(arg, "--output") == 0 && hasValue) {
+            options.outputPath = argv[++i];
+        }
+        else {
+            printUsage();
+            return std::strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    const auto results = runAll(options);
+
+    std::FILE* out = stdout;
+    if (!options.outputPath.empty()) {
+        out = std::fopen(options.outputPath.c_str(), "w");
+        if (out == nullptr) {
+            std::fprintf(stderr, "dsp256_bench: cannot write %s\n", options.outputPath.c_str());
+            return 1;
+        }
+    }
+
+    writeJson(out, results, options);
+
+    if (out != stdout)
+        std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,575 @@
+// Differential.cpp - Reference vs optimized kernel differential test
+//
+// Runs every registered module twice on the same randomized streams: once
+// through its optimized processBlock() (block, SIMD and integer kernels) and
+// once through the reference kernel, EffectModule::processBlockReference()
+// (the straightforward per-sample Q12 path). Each trial draws a starting
+// preset and parameter set, input made of noise, tones, clicks, silence and
+// over-range segments, random host block sizes, and parameter automation
+// and preset changes between blocks. Both hosts see the same stream in lock
+// step. The report gives the largest deviation, the first sample where the
+// outputs differ at all and the first where they differ by more than
+// --tolerance.
+//
+// There is no reference for buses wider than stereo: process() is a stereo
+// Q12 path, so DSP256_KERNELS=reference leaves processBlockMultichannel()
+// as it is. Modules that support 5.1 or first-order ambisonics get extra
+// trials on those layouts, checked across builds only (below).
+//
+// The Float4 kernels are picked when the core is compiled (SimdLanes.h), so
+// each CPU target is its own build: CMake builds dsp256_diff for the native
+// target and dsp256_diff_scalar against a DSP256_FORCE_SCALAR core. One build
+// records its optimized output with --record, the wide layouts included;
+// another replays the same streams with --against and must match it within
+// --target-tolerance (bit for bit by default). Built by CMake as dsp256_diff:
+//
+//     dsp256_diff [--module name] [--trials n] [--seed n] [--seconds s]
+//                 [--tolerance x] [--record file]
+//     dsp256_diff_scalar --against file [--module name] [--target-tolerance x]
+
+#include "OfflineHost.h"
+#include "SimdLanes.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int RECORD_VERSION = 2;
+constexpr int64_t POOL_SEED = 0x256;                     // Delay pool noise floor and bit flips
+constexpr int MAX_BLOCK_SIZE = 2048;
+
+#if DSP256_SIMD_SSE2
+constexpr const char* DISPATCH_TARGET = "sse2";
+#elif DSP256_SIMD_NEON
+constexpr const char* DISPATCH_TARGET = "neon";
+#else
+constexpr const char* DISPATCH_TARGET = "scalar";
+#endif
+
+// Output buses a trial can run on. Stereo is compared with the reference
+// kernel; the others exist only in processBlockMultichannel()
+struct Layout {
+    const char* name;
+    OutputLayout layout;
+    const char* channelNames[OutputLayout::MAX_CHANNELS];
+};
+
+const Layout layouts[] = {
+    { "stereo", { 2, -1, false }, { "L", "R" } },
+    { "5.1", { 6, 3, false }, { "L", "R", "C", "LFE", "Ls", "Rs" } },
+    { "foa", { 4, -1, true }, { "W", "Y", "Z", "X" } },
+};
+
+const Layout* findLayout(const std::string& name)
+{
+    for (const auto& layout : layouts)
+        if (name == layout.name)
+            return &layout;
+    return nullptr;
+}
+
+struct Options {
+    std::string moduleName;                              // Empty: every registered module
+    double sampleRate = 44100.0;
+    int trials = 8;                                      // Per module
+    int64_t seed = 1;
+    double seconds = 2.0;                                // Per trial
+    double tolerance = 0.0;                              // Reference vs optimized, absolute
+    double targetTolerance = 0.0;                        // Against another build's recording
+    std::string recordPath;
+    std::string againstPath;
+};
+
+//==============================================================================
+// Randomized streams
+//==============================================================================
+float uniform(dsp256::Random& random, float low, float high)
+{
+    return low + (high - low) * random.nextFloat();
+}
+
+// Every module, trial and seed gets its own stream, the same in every build
+int64_t streamSeed(const std::string& moduleName, int trial, int64_t seed)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (char c : moduleName)
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+    hash ^= static_cast<uint64_t>(seed) * 0x9e3779b97f4a7c15ULL + static_cast<uint64_t>(trial);
+    return static_cast<int64_t>(hash & 0xffffffffffffULL);
+}
+
+// Segments of 5 ms to 400 ms: silence, noise, tones, clicks, a DC step,
+// and noise beyond full scale to reach the clipping and saturation paths
+void makeInput(dsp256::Random& random, double sampleRate, std::vector<float>& left, std::vector<float>& right)
+{
+    const double pi = 3.14159265358979323846;
+    size_t position = 0;
+
+    while (position < left.size()) {
+        const size_t length = std::min(left.size() - position,
+            static_cast<size_t>(sampleRate * uniform(random, 0.005f, 0.4f)));
+        const float level = uniform(random, 0.05f, 1.0f);
+        const float pan = random.nextFloat();
+        const int kind = random.nextInt(6);
+
+        if (kind == 1 || kind == 5) {
+            const float scale = kind == 5 ? uniform(random, 1.0f, 2.0f) : level;
+            for (size_t i = position; i < position + length; ++i) {
+                left[i] = scale * (random.nextFloat() * 2.0f - 1.0f);
+                right[i] = scale * (random.nextFloat() * 2.0f - 1.0f);
+            }
+        }
+        else if (kind == 2) {
+            const double frequency = 20.0 * std::pow(900.0, static_cast<double>(random.nextFloat()));
+            for (size_t i = position; i < position + length; ++i) {
+                const float s = level * static_cast<float>(std::sin(2.0 * pi * frequency * static_cast<double>(i) / sampleRate));
+                left[i] = s * (1.0f - pan);
+                right[i] = s * pan;
+            }
+        }
+        else if (kind == 3) {
+            for (size_t i = position; i < position + length; ++i) {
+                const bool click = random.nextInt(2000) == 0;
+                left[i] = click ? level : 0.0f;
+                right[i] = click ? level * pan : 0.0f;
+            }
+        }
+        else {
+            const float value = kind == 4 ? level * (random.nextInt(2) == 0 ? 1.0f : -1.0f) : 0.0f;
+            std::fill(left.begin() + static_cast<std::ptrdiff_t>(position), left.begin() + static_cast<std::ptrdiff_t>(position + length), value);
+            std::fill(right.begin() + static_cast<std::ptrdiff_t>(position), right.begin() + static_cast<std::ptrdiff_t>(position + length), value);
+        }
+        position += length;
+    }
+}
+
+// Host block sizes: a quarter of the blocks 1-16 samples, the rest up to MAX_BLOCK_SIZE
+int nextBlockSize(dsp256::Random& random)
+{
+    return random.nextInt(4) == 0 ? 1 + random.nextInt(16) : 16 + random.nextInt(MAX_BLOCK_SIZE - 15);
+}
+
+// Before a host block: automate a parameter now and then, load a preset rarely
+void automate(dsp256::Random& random, const EffectModule& module, const std::vector<EffectPreset>& presets,
+    std::vector<OfflineHost*>& hosts)
+{
+    const auto defs = module.getParameterDefinitions();
+    if (!presets.empty() && random.nextInt(50) == 0) {
+        const auto& preset = presets[static_cast<size_t>(random.nextInt(static_cast<int>(presets.size())))];
+        for (auto* host : hosts)
+            host->getParameters().loadPreset(host->getModule(), preset);
+    }
+    else if (!defs.empty() && random.nextInt(3) == 0) {
+        const int index = random.nextInt(static_cast<int>(defs.size()));
+        const auto& def = defs[static_cast<size_t>(index)];
+        const float value = uniform(random, def.minValue, def.maxValue);
+        for (auto* host : hosts)
+            host->getParameters().setValue(index, value);
+    }
+}
+
+//==============================================================================
+// Comparison
+//==============================================================================
+struct Deviation {
+    double maxDeviation = 0.0;
+    int64_t firstDivergent = -1;                          // Frame index, -1 if none
+    const char* firstChannel = "";
+    int64_t firstOverTolerance = -1;
+    const char* overChannel = "";
+    float expected = 0.0f;                                // At firstOverTolerance
+    float actual = 0.0f;
+
+    void add(float expectedSample, float actualSample, int64_t frame, const char* channel, double tolerance)
+    {
+        if (std::memcmp(&expectedSample, &actualSample, sizeof(float)) == 0)
+            return;
+
+        const double deviation = std::isfinite(expectedSample) && std::isfinite(actualSample)
+            ? std::abs(static_cast<double>(expectedSample) - static_cast<double>(actualSample))
+            : HUGE_VAL;
+        maxDeviation = std::max(maxDeviation, deviation);
+        if (firstDivergent < 0) {
+            firstDivergent = frame;
+            firstChannel = channel;
+        }
+        if (deviation > tolerance && firstOverTolerance < 0) {
+            firstOverTolerance = frame;
+            overChannel = channel;
+            expected = expectedSample;
+            actual = actualSample;
+        }
+    }
+
+    std::string describe() const
+    {
+        char text[200];
+        if (firstDivergent < 0)
+            return "bit-exact";
+        if (firstOverTolerance < 0)
+            std::snprintf(text, sizeof(text), "max dev %.3g, first at %lld %s", maxDeviation,
+                static_cast<long long>(firstDivergent), firstChannel);
+        else
+            std::snprintf(text, sizeof(text), "max dev %.3g, first at %lld %s, over tolerance at %lld %s (%.6g vs %.6g)",
+                maxDeviation, static_cast<long long>(firstDivergent), firstChannel,
+                static_cast<long long>(firstOverTolerance), overChannel, expected, actual);
+        return text;
+    }
+};
+
+//==============================================================================
+// One trial: on stereo, the optimized and reference kernels in lock step;
+// on a wider layout, processBlockMultichannel() alone. 'output' receives the
+// optimized render, interleaved, for --record and --against.
+//==============================================================================
+Deviation runTrial(const std::string& moduleName, int trial, const Layout& layout, const Options& options,
+    std::vector<float>& output)
+{
+    const bool stereo = layout.layout.numChannels == 2;
+    const size_t numChannels = static_cast<size_t>(layout.layout.numChannels);
+
+    auto& registry = EffectModuleRegistry::getInstance();
+    OfflineHost optimized(registry.createModule(moduleName.c_str()));
+    OfflineHost reference(registry.createModule(moduleName.c_str()));
+    reference.setReferenceKernels(true);
+    std::vector<OfflineHost*> hosts{ &optimized };
+    if (stereo)
+        hosts.push_back(&reference);
+
+    // Stereo streams keep the seeds they had before wider layouts were added
+    const std::string streamName = stereo ? moduleName : moduleName + "/" + layout.name;
+    dsp256::Random random(streamSeed(streamName, trial, options.seed));
+    const auto presets = optimized.getModule().getFactoryPresets();
+    const double tempo = random.nextInt(2) == 0 ? 0.0 : 60.0 + random.nextInt(121);
+
+    for (auto* host : hosts) {
+        host->prepare(options.sampleRate, MAX_BLOCK_SIZE);
+        host->setNonRealtime(true);
+        host->setRandomSeed(POOL_SEED);
+        host->setTempo(tempo);
+    }
+    if (!stereo)
+        optimized.setOutputLayout(layout.layout);
+
+    // Start from a random preset, then move about half the parameters
+    if (!presets.empty()) {
+        const auto& preset = presets[static_cast<size_t>(random.nextInt(static_cast<int>(presets.size())))];
+        for (auto* host : hosts)
+            host->getParameters().loadPreset(host->getModule(), preset);
+    }
+    const auto defs = optimized.getModule().getParameterDefinitions();
+    for (int i = 0; i < static_cast<int>(defs.size()); ++i) {
+        if (random.nextInt(2) == 0) {
+            const float value = uniform(random, defs[static_cast<size_t>(i)].minValue, defs[static_cast<size_t>(i)].maxValue);
+            for (auto* host : hosts)
+                host->getParameters().setValue(i, value);
+        }
+    }
+
+    const size_t length = static_cast<size_t>(options.sampleRate * options.seconds);
+    std::vector<float> inputLeft(length), inputRight(length);
+    makeInput(random, options.sampleRate, inputLeft, inputRight);
+
+    // Surround inputs carry the stereo input at half level (the LFE too, so
+    // its pass-through is checked); FOA takes a stereo input, as on the plugin
+    std::vector<std::vector<float>> channels(numChannels, std::vector<float>(length, 0.0f));
+    channels[0] = inputLeft;
+    channels[1] = inputRight;
+    if (!layout.layout.ambisonic) {
+        for (size_t ch = 2; ch < numChannels; ++ch)
+            for (size_t i = 0; i < length; ++i)
+                channels[ch][i] = 0.5f * (ch % 2 == 0 ? inputLeft[i] : inputRight[i]);
+    }
+    std::vector<float> referenceLeft(inputLeft), referenceRight(inputRight);
+    Deviation deviation;
+    output.resize(length * numChannels);
+
+    size_t position = 0;
+    while (position < length) {
+        const int count = static_cast<int>(std::min(length - position, static_cast<size_t>(nextBlockSize(random))));
+        automate(random, optimized.getModule(), presets, hosts);
+
+        if (stereo) {
+            optimized.processBlock(channels[0].data() + position, channels[1].data() + position, count);
+            reference.processBlock(referenceLeft.data() + position, referenceRight.data() + position, count);
+
+            for (size_t i = position; i < position + static_cast<size_t>(count); ++i) {
+                deviation.add(referenceLeft[i], channels[0][i], static_cast<int64_t>(i), "L", options.tolerance);
+                deviation.add(referenceRight[i], channels[1][i], static_cast<int64_t>(i), "R", options.tolerance);
+            }
+        }
+        else {
+            float* block[OutputLayout::MAX_CHANNELS] = {};
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                block[ch] = channels[ch].data() + position;
+            optimized.processBlockMultichannel(block, static_cast<int>(numChannels), count);
+        }
+
+        for (size_t i = position; i < position + static_cast<size_t>(count); ++i)
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                output[i * numChannels + ch] = channels[ch][i];
+        position += static_cast<size_t>(count);
+    }
+
+    return deviation;
+}
+
+//==============================================================================
+// Recordings: a text header with the stream settings, then per trial a
+// "case <trial> <layout> <frames> <module>" line and the interleaved float
+// samples, one per channel of the layout
+//==============================================================================
+bool writeHeader(std::FILE* file, const Options& options)
+{
+    std::fprintf(file, "dsp256-diff %d\ntarget %s\nsample_rate %.0f\nseed %lld\nseconds %.17g\n", RECORD_VERSION,
+        DISPATCH_TARGET, options.sampleRate, static_cast<long long>(options.seed), options.seconds);
+    return std::ferror(file) == 0;
+}
+
+bool readLine(std::FILE* file, std::string& line)
+{
+    line.clear();
+    for (int c = std::fgetc(file); c != EOF; c = std::fgetc(file)) {
+        if (c == '\n')
+            return true;
+        line += static_cast<char>(c);
+    }
+    return !line.empty();
+}
+
+bool readHeader(std::FILE* file, Options& options, std::string& target)
+{
+    std::string line;
+    int version = 0;
+    char name[64] = {};
+    long long seed = 0;
+    if (!readLine(file, line) || std::sscanf(line.c_str(), "dsp256-diff %d", &version) != 1 || version != RECORD_VERSION)
+        return false;
+    if (!readLine(file, line) || std::sscanf(line.c_str(), "target %63s", name) != 1)
+        return false;
+    if (!readLine(file, line) || std::sscanf(line.c_str(), "sample_rate %lf", &options.sampleRate) != 1)
+        return false;
+    if (!readLine(file, line) || std::sscanf(line.c_str(), "seed %lld", &seed) != 1)
+        return false;
+    if (!readLine(file, line) || std::sscanf(line.c_str(), "seconds %lf", &options.seconds) != 1)
+        return false;
+
+    target = name;
+    options.seed = seed;
+    return options.sampleRate > 0.0 && options.seconds > 0.0;
+}
+
+void printUsage()
+{
+    std::fprintf(stderr,
+        "usage: dsp256_diff [options]\n"
+        "  --module name          one module only (default: every registered module)\n"
+        "  --trials n             randomized trials per module (default 8)\n"
+        "  --seed n               stream seed (default 1)\n"
+        "  --seconds s            length of each trial (default 2)\n"
+        "  --sample-rate hz       (default 44100)\n"
+        "  --tolerance x          reference vs optimized: largest allowed absolute deviation (default 0, bit-exact)\n"
+        "  --record file          write this build's optimized output for another build to check\n"
+        "                         (stereo, plus 5.1/FOA for modules that support them)\n"
+        "  --against file         replay a recording's streams and compare with its output\n"
+        "  --target-tolerance x   with --against: largest allowed deviation (default 0, bit-exact)\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(arg, "--module") == 0 && hasValue)
+            options.moduleName = argv[++i];
+        else if (std::strcmp(arg, "--trials") == 0 && hasValue)
+            options.trials = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(arg, "--seed") == 0 && hasValue)
+            options.seed = std::atoll(argv[++i]);
+        else if (std::strcmp(arg, "--seconds") == 0 && hasValue)
+            options.seconds = std::clamp(std::atof(argv[++i]), 0.01, 600.0);
+        else if (std::strcmp(arg, "--sample-rate") == 0 && hasValue)
+            options.sampleRate = std::clamp(std::atof(argv[++i]), 8000.0, 384000.0);
+        else if (std::strcmp(arg, "--tolerance") == 0 && hasValue)
+            options.tolerance = std::max(0.0, std::atof(argv[++i]));
+        else if (std::strcmp(arg, "--record") == 0 && hasValue)
+            options.recordPath = argv[++i];
+        else if (std::strcmp(arg, "--against") == 0 && hasValue)
+            options.againstPath = argv[++i];
+        else if (std::strcmp(arg, "--target-tolerance") == 0 && hasValue)
+            options.targetTolerance = std::max(0.0, std::atof(argv[++i]));
+        else {
+            printUsage();
+            return std::strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    if (!options.recordPath.empty() && !options.againstPath.empty()) {
+        std::fprintf(stderr, "dsp256_diff: --record and --against cannot be combined\n");
+        return 1;
+    }
+
+    auto& registry = EffectModuleRegistry::getInstance();
+    std::vector<std::string> modules;
+    for (const auto& name : registry.getAvailableModules())
+        if (options.moduleName.empty() || name.toStdString() == options.moduleName)
+            modules.push_back(name.toStdString());
+    if (modules.empty()) {
+        std::fprintf(stderr, "dsp256_diff: unknown module '%s'\n", options.moduleName.c_str());
+        return 1;
+    }
+
+    // The trials to run: every module x --trials on each layout it supports,
+    // or those in the recording
+    struct Case {
+        std::string moduleName;
+        int trial;
+        const Layout* layout;
+    };
+    std::vector<Case> cases;
+    std::FILE* recording = nullptr;
+    std::string recordedTarget;
+
+    if (!options.againstPath.empty()) {
+        recording = std::fopen(options.againstPath.c_str(), "rb");
+        if (recording == nullptr || !readHeader(recording, options, recordedTarget)) {
+            std::fprintf(stderr, "dsp256_diff: %s is not a version %d recording\n", options.againstPath.c_str(), RECORD_VERSION);
+            return 1;
+        }
+    }
+    else {
+        for (const auto& moduleName : modules) {
+            const auto module = registry.createModule(moduleName.c_str());
+            for (const auto& layout : layouts) {
+                if (layout.layout.numChannels != 2 && !module->supportsOutputLayout(layout.layout))
+                    continue;
+                for (int trial = 0; trial < options.trials; ++trial)
+                    cases.push_back({ moduleName, trial, &layout });
+            }
+        }
+
+        if (!options.recordPath.empty()) {
+            recording = std::fopen(options.recordPath.c_str(), "wb");
+            if (recording == nullptr || !writeHeader(recording, options)) {
+                std::fprintf(stderr, "dsp256_diff: cannot write %s\n", options.recordPath.c_str());
+                return 1;
+            }
+        }
+    }
+
+    std::printf("dispatch target %s", DISPATCH_TARGET);
+    if (!recordedTarget.empty())
+        std::printf(", against %s recording %s", recordedTarget.c_str(), options.againstPath.c_str());
+    std::printf("\n");
+
+    int caseCount = 0;
+    int failures = 0;
+    double largest = 0.0;
+    double largestTarget = 0.0;
+    std::vector<float> output;
+    std::vector<float> recorded;
+    const auto started = Clock::now();
+
+    for (size_t next = 0;; ++next) {
+        Case current;
+        if (!options.againstPath.empty()) {
+            // Next recorded trial; skip modules not asked for
+            std::string line;
+            if (!readLine(recording, line))
+                break;
+
+            int trial = 0;
+            char layoutName[16] = {};
+            long long frames = 0;
+            int nameOffset = 0;
+            const Layout* layout = nullptr;
+            if (std::sscanf(line.c_str(), "case %d %15s %lld %n", &trial, layoutName, &frames, &nameOffset) != 3
+                || nameOffset == 0 || frames < 0 || (layout = findLayout(layoutName)) == nullptr) {
+                std::fprintf(stderr, "dsp256_diff: %s is damaged\n", options.againstPath.c_str());
+                return 1;
+            }
+            current = { line.substr(static_cast<size_t>(nameOffset)), trial, layout };
+
+            recorded.resize(static_cast<size_t>(frames) * static_cast<size_t>(layout->layout.numChannels));
+            if (std::fread(recorded.data(), sizeof(float), recorded.size(), recording) != recorded.size()) {
+                std::fprintf(stderr, "dsp256_diff: %s is truncated\n", options.againstPath.c_str());
+                return 1;
+            }
+            if (std::find(modules.begin(), modules.end(), current.moduleName) == modules.end())
+                continue;
+        }
+        else if (next < cases.size()) {
+            current = cases[next];
+        }
+        else {
+            break;
+        }
+
+        const Layout& layout = *current.layout;
+        const size_t numChannels = static_cast<size_t>(layout.layout.numChannels);
+        const Deviation deviation = runTrial(current.moduleName, current.trial, layout, options, output);
+        ++caseCount;
+        bool failed = deviation.firstOverTolerance >= 0;
+        largest = std::max(largest, deviation.maxDeviation);
+        std::string verdict = numChannels == 2 ? "reference: " + deviation.describe() : std::string("reference: none");
+
+        if (!options.recordPath.empty()) {
+            std::fprintf(recording, "case %d %s %zu %s\n", current.trial, layout.name, output.size() / numChannels,
+                current.moduleName.c_str());
+            std::fwrite(output.data(), sizeof(float), output.size(), recording);
+        }
+        else if (!options.againstPath.empty()) {
+            Deviation target;
+            if (recorded.size() != output.size()) {
+                target.firstOverTolerance = 0;
+                verdict += "  " + recordedTarget + ": length differs";
+            }
+            else {
+                for (size_t i = 0; i < output.size(); ++i)
+                    target.add(recorded[i], output[i], static_cast<int64_t>(i / numChannels),
+                        layout.channelNames[i % numChannels], options.targetTolerance);
+                verdict += "  " + recordedTarget + ": " + target.describe();
+            }
+            failed = failed || target.firstOverTolerance >= 0;
+            largestTarget = std::max(largestTarget, target.maxDeviation);
+        }
+
+        std::printf("%-6s %-18s %-6s trial %-3d %s\n", failed ? "FAIL" : "ok", current.moduleName.c_str(), layout.name,
+            current.trial, verdict.c_str());
+        std::fflush(stdout);
+        failures += failed ? 1 : 0;
+    }
+
+    if (!options.againstPath.empty()) {
+        std::fclose(recording);
+    }
+    else if (recording != nullptr) {
+        const bool written = std::ferror(recording) == 0;
+        if (std::fclose(recording) != 0 || !written) {
+            std::fprintf(stderr, "dsp256_diff: cannot write %s\n", options.recordPath.c_str());
+            return 1;
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - started).count();
+    std::printf("%s: %d case(s), %d failed, largest reference deviation %.3g", failures == 0 ? "PASS" : "FAIL",
+        caseCount, failures, largest);
+    if (!options.againstPath.empty())
+        std::printf(", largest %s deviation %.3g", recordedTarget.c_str(), largestTarget);
+    std::printf(", %.1f s\n", seconds);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,596 @@
+// Golden.cpp - Golden-output regression check for every module and preset
+//
+// Renders fixed test signals (impulse, exponential sweep, noise burst)
+// through every factory preset of every registered module. Each one goes
+// down two paths: the per-sample Q12 entry point, EffectModule::process()
+// (the fixed-point path), and processBlock() (the float/SIMD block path
+// the plugin runs). The fixed-point path must match bit for bit, so the
+// manifest keeps only a hash of each render. The block path must stay within
+// --tolerance of its golden: the manifest keeps its hash too, and a float WAV
+// of every DECIMATION-th frame is what it is held to when the hash differs.
+// The goldens are small enough to live in git (golden/). Render speed is
+// measured in the same run and compared with the speed recorded with them.
+// Built by CMake as dsp256_golden:
+//
+//     dsp256_golden --update [--golden-dir dir]    (record from a trusted build)
+//     dsp256_golden [--golden-dir dir] [--module name] [--tolerance x]
+//                   [--max-slowdown ratio] [--repetitions n]
+
+#include "OfflineHost.h"
+#include "AudioFile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int MANIFEST_VERSION = 2;
+constexpr int DECIMATION = 37;                           // Block-path golden frame stride; prime, so it walks across block boundaries
+constexpr int64_t POOL_SEED = 0x256;                     // Delay pool noise floor and bit flips
+
+struct Options {
+    std::string goldenDir = "golden";
+    std::string moduleName;                              // Empty: every registered module
+    double sampleRate = 44100.0;                         // --update only; a check uses the manifest's
+    int blockSize = 512;
+    double tolerance = 1.0e-5;                           // Block path, absolute
+    double maxSlowdown = 0.0;                            // Fail renders this much slower than recorded; 0 = report only
+    int repetitions = 3;                                 // Fastest is timed; all must agree
+    bool update = false;
+};
+
+enum class RenderPath { FixedPoint, Block };
+
+const char* pathName(RenderPath path) { return path == RenderPath::FixedPoint ? "q12" : "block"; }
+
+//==============================================================================
+// Test signals, 1.5 s each
+//==============================================================================
+struct TestSignal {
+    std::string name;
+    std::vector<float> left;
+    std::vector<float> right;
+};
+
+std::vector<TestSignal> makeSignals(double sampleRate)
+{
+    const size_t length = static_cast<size_t>(sampleRate * 1.5);
+    const double pi = 3.14159265358979323846;
+    std::vector<TestSignal> signals;
+
+    TestSignal impulse{ "impulse", std::vector<float>(length), std::vector<float>(length) };
+    impulse.left[0] = impulse.right[0] = 0.5f;
+    signals.push_back(std::move(impulse));
+
+    // 20 Hz to 20 kHz in 1 s, 10 ms fades, then silence
+    TestSignal sweep{ "sweep", std::vector<float>(length), std::vector<float>(length) };
+    const double sweepSeconds = 1.0;
+    const double logRatio = std::log(20000.0 / 20.0);
+    const size_t sweepLength = static_cast<size_t>(sampleRate * sweepSeconds);
+    const size_t sweepFade = static_cast<size_t>(sampleRate * 0.01);
+    for (size_t i = 0; i < sweepLength; ++i) {
+        const double t = static_cast<double>(i) / sampleRate;
+        const double phase = 2.0 * pi * 20.0 * sweepSeconds / logRatio * (std::exp(t / sweepSeconds * logRatio) - 1.0);
+        const double fade = std::min({ 1.0, static_cast<double>(i) / sweepFade, static_cast<double>(sweepLength - i) / sweepFade });
+        sweep.left[i] = sweep.right[i] = static_cast<float>(0.5 * fade * std::sin(phase));
+    }
+    signals.push_back(std::move(sweep));
+
+    // 250 ms of independent L/R white noise, raised-cosine 5 ms fades
+    TestSignal burst{ "noise-burst", std::vector<float>(length), std::vector<float>(length) };
+    dsp256::Random random(0x5EED);
+    const size_t burstLength = static_cast<size_t>(sampleRate * 0.25);
+    const size_t burstFade = static_cast<size_t>(sampleRate * 0.005);
+    for (size_t i = 0; i < burstLength; ++i) {
+        const size_t edge = std::min(i, burstLength - 1 - i);
+        const double fade = edge < burstFade ? 0.5 - 0.5 * std::cos(pi * static_cast<double>(edge) / burstFade) : 1.0;
+        burst.left[i] = static_cast<float>(0.5 * fade * (random.nextFloat() * 2.0f - 1.0f));
+        burst.right[i] = static_cast<float>(0.5 * fade * (random.nextFloat() * 2.0f - 1.0f));
+    }
+    signals.push_back(std::move(burst));
+
+    return signals;
+}
+
+//==============================================================================
+// Rendering
+//==============================================================================
+struct Rendered {
+    std::vector<float> left;
+    std::vector<float> right;
+    double nsPerSample = 0.0;
+    bool deterministic = true;                           // Every repetition gave the same samples
+};
+
+bool sameBits(const std::vector<float>& a, const std::vector<float>& b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+// FNV-1a over the sample bits, frame by frame (L, R)
+uint64_t hashRender(const Rendered& rendered)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const auto add = [&hash](float sample) {
+        unsigned char bytes[sizeof(float)];
+        std::memcpy(bytes, &sample, sizeof(float));
+        for (unsigned char byte : bytes)
+            hash = (hash ^ byte) * 0x100000001b3ULL;
+    };
+    for (size_t i = 0; i < rendered.left.size(); ++i) {
+        add(rendered.left[i]);
+        add(rendered.right[i]);
+    }
+    return hash;
+}
+
+// Every DECIMATION-th frame, starting with the first
+Rendered decimate(const Rendered& rendered)
+{
+    Rendered result;
+    for (size_t i = 0; i < rendered.left.size(); i += DECIMATION) {
+        result.left.push_back(rendered.left[i]);
+        result.right.push_back(rendered.right[i]);
+    }
+    return result;
+}
+
+// One preset and signal down one path with a fresh host; the module's
+// tail is inside the signal's silence
+Rendered renderOnce(const std::string& moduleName, const EffectPreset& preset, const TestSignal& signal,
+    RenderPath path, double sampleRate, int blockSize, double& seconds)
+{
+    OfflineHost host(EffectModuleRegistry::getInstance().createModule(moduleName.c_str()));
+    host.prepare(sampleRate, blockSize);
+    host.setNonRealtime(true);
+    host.setRandomSeed(POOL_SEED);
+    host.getParameters().loadPreset(host.getModule(), preset);
+
+    Rendered result;
+    result.left = signal.left;
+    result.right = signal.right;
+    const int length = static_cast<int>(result.left.size());
+
+    if (path == RenderPath::Block) {
+        const auto start = Clock::now();
+        for (int position = 0; position < length; position += blockSize) {
+            const int count = std::min(blockSize, length - position);
+            host.processBlock(result.left.data() + position, result.right.data() + position, count);
+        }
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+    else {
+        auto& engine = host.getEngine();
+        std::vector<FixedPointSample> left(result.left.size());
+        std::vector<FixedPointSample> right(result.right.size());
+        for (size_t i = 0; i < left.size(); ++i) {
+            left[i] = engine.floatToQ12(result.left[i]);
+            right[i] = engine.floatToQ12(result.right[i]);
+        }
+
+        const auto start = Clock::now();
+        for (int position = 0; position < length; position += blockSize) {
+            const int count = std::min(blockSize, length - position);
+            host.processBlockFixedPoint(left.data() + position, right.data() + position, count);
+        }
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        for (size_t i = 0; i < left.size(); ++i) {
+            result.left[i] = engine.Q12ToFloat(left[i]);
+            result.right[i] = engine.Q12ToFloat(right[i]);
+        }
+    }
+
+    return result;
+}
+
+Rendered render(const std::string& moduleName, const EffectPreset& preset, const TestSignal& signal,
+    RenderPath path, double sampleRate, int blockSize, int repetitions)
+{
+    double seconds = 0.0;
+    Rendered result = renderOnce(moduleName, preset, signal, path, sampleRate, blockSize, seconds);
+    double fastest = seconds;
+
+    for (int i = 1; i < repetitions; ++i) {
+        const Rendered again = renderOnce(moduleName, preset, signal, path, sampleRate, blockSize, seconds);
+        fastest = std::min(fastest, seconds);
+        if (!sameBits(again.left, result.left) || !sameBits(again.right, result.right))
+            result.deterministic = false;
+    }
+
+    result.nsPerSample = fastest * 1.0e9 / static_cast<double>(result.left.size());
+    return result;
+}
+
+//==============================================================================
+// Goldens on disk
+//==============================================================================
+std::string caseNameFor(const std::string& moduleName, const std::string& presetName, const std::string& signal, RenderPath path)
+{
+    std::string name;
+    for (const std::string& part : { moduleName, presetName, signal, std::string(pathName(path)) }) {
+        if (!name.empty())
+            name += "__";
+        bool dash = false;
+        for (char c : part) {
+            if (std::isalnum(static_cast<unsigned char>(c))) {
+                name += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                dash = false;
+            }
+            else if (!dash) {
+                name += '-';
+                dash = true;
+            }
+        }
+    }
+    return name;
+}
+
+// manifest.txt: render settings, then one "render <case> <ns/sample> <frames>
+// <hash>" line per case
+struct GoldenEntry {
+    double nsPerSample = 0.0;
+    size_t frames = 0;
+    uint64_t hash = 0;
+};
+
+struct Manifest {
+    double sampleRate = 0.0;
+    int blockSize = 0;
+    std::map<std::string, GoldenEntry> entries;
+};
+
+bool readManifest(const std::string& path, Manifest& manifest, std::string& error)
+{
+    std::ifstream stream(path);
+    if (!stream) {
+        error = "no goldens in " + path + " (record them with --update)";
+        return false;
+    }
+
+    std::string line;
+    int version = 0;
+    while (std::getline(stream, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        fields >> key;
+        if (key == "dsp256-golden")
+            fields >> version;
+        else if (key == "sample_rate")
+            fields >> manifest.sampleRate;
+        else if (key == "block_size")
+            fields >> manifest.blockSize;
+        else if (key == "render") {
+            std::string name;
+            GoldenEntry entry;
+            fields >> name >> entry.nsPerSample >> entry.frames >> std::hex >> entry.hash;
+            if (fields)
+                manifest.entries[name] = entry;
+        }
+    }
+
+    if (version != MANIFEST_VERSION || manifest.sampleRate <= 0.0 || manifest.blockSize <= 0) {
+        error = path + " is not a version " + std::to_string(MANIFEST_VERSION) + " golden manifest";
+        return false;
+    }
+    return true;
+}
+
+bool writeManifest(const std::string& path, const Manifest& manifest)
+{
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr)
+        return false;
+
+    std::fprintf(file, "dsp256-golden %d\n", MANIFEST_VERSION);
+    std::fprintf(file, "sample_rate %.0f\n", manifest.sampleRate);
+    std::fprintf(file, "block_size %d\n", manifest.blockSize);
+    for (const auto& [name, entry] : manifest.entries)
+        std::fprintf(file, "render %s %.3f %zu %016llx\n", name.c_str(), entry.nsPerSample, entry.frames,
+            static_cast<unsigned long long>(entry.hash));
+
+    const bool written = std::ferror(file) == 0;
+    return std::fclose(file) == 0 && written;
+}
+
+bool writeGolden(const std::string& path, const Rendered& rendered, double sampleRate, std::string& error)
+{
+    AudioFileFormat format;
+    format.sampleRate = sampleRate;
+    format.numChannels = 2;
+    format.bitsPerSample = 32;
+    format.isFloat = true;
+
+    AudioFileWriter writer;
+    const float* channels[] = { rendered.left.data(), rendered.right.data() };
+    if (!writer.open(path, format, error))
+        return false;
+    if (!writer.write(channels, static_cast<int>(rendered.left.size())) || !writer.close()) {
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+bool readGolden(const std::string& path, std::vector<float>& left, std::vector<float>& right, std::string& error)
+{
+    AudioFileReader reader;
+    if (!reader.open(path, error))
+        return false;
+
+    const auto& format = reader.getFormat();
+    if (format.numChannels != 2 || !format.isFloat || format.bitsPerSample != 32) {
+        error = path + " is not a stereo 32-bit float golden";
+        return false;
+    }
+
+    left.resize(static_cast<size_t>(reader.getLengthInFrames()));
+    right.resize(left.size());
+    float* channels[] = { left.data(), right.data() };
+    if (reader.read(channels, static_cast<int>(left.size())) != static_cast<int>(left.size())) {
+        error = "short read from " + path;
+        return false;
+    }
+    return true;
+}
+
+//==============================================================================
+// Comparison
+//==============================================================================
+struct Comparison {
+    bool identical = true;
+    bool lengthMatches = true;
+    double maxDeviation = 0.0;
+    int64_t firstDivergent = -1;                          // Frame index, -1 if none
+    const char* firstChannel = "";
+};
+
+Comparison compare(const std::vector<float>& goldenLeft, const std::vector<float>& goldenRight, const Rendered& rendered)
+{
+    Comparison result;
+    result.lengthMatches = goldenLeft.size() == rendered.left.size();
+    result.identical = result.lengthMatches;
+
+    const size_t length = std::min(goldenLeft.size(), rendered.left.size());
+    const auto check = [&](const std::vector<float>& golden, const std::vector<float>& actual, size_t i, const char* channel) {
+        if (std::memcmp(&golden[i], &actual[i], sizeof(float)) == 0)
+            return;
+
+        result.identical = false;
+        const double deviation = std::isfinite(golden[i]) && std::isfinite(actual[i])
+            ? std::abs(static_cast<double>(golden[i]) - static_cast<double>(actual[i]))
+            : HUGE_VAL;
+        result.maxDeviation = std::max(result.maxDeviation, deviation);
+        if (result.firstDivergent < 0) {
+            result.firstDivergent = static_cast<int64_t>(i);
+            result.firstChannel = channel;
+        }
+    };
+
+    for (size_t i = 0; i < length; ++i) {
+        check(goldenLeft, rendered.left, i, "L");
+        check(goldenRight, rendered.right, i, "R");
+    }
+    return result;
+}
+
+void printUsage()
+{
+    std::fprintf(stderr,
+        "usage: dsp256_golden [options]\n"
+        "  --update             record goldens (and render speed) from this build\n"
+        "  --golden-dir dir     where goldens live (default ./golden)\n"
+        "  --module name        one module only (default: every registered module)\n"
+        "  --tolerance x        block path: largest allowed absolute deviation (default 1e-5)\n"
+        "  --max-slowdown r     fail renders more than r times slower than recorded (default: report only)\n"
+        "  --repetitions n      renders per case; the fastest is timed, all must agree (default 3)\n"
+        "  --sample-rate hz     with --update (default 44100)\n"
+        "  --block-size n       with --update (default 512)\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(arg, "--update") == 0)
+            options.update = true;
+        else if (std::strcmp(arg, "--golden-dir") == 0 && hasValue)
+            options.goldenDir = argv[++i];
+        else if (std::strcmp(arg, "--module") == 0 && hasValue)
+            options.moduleName = argv[++i];
+        else if (std::strcmp(arg, "--tolerance") == 0 && hasValue)
+            options.tolerance = std::max(0.0, std::atof(argv[++i]));
+        else if (std::strcmp(arg, "--max-slowdown") == 0 && hasValue)
+            options.maxSlowdown = std::max(0.0, std::atof(argv[++i]));
+        else if (std::strcmp(arg, "--repetitions") == 0 && hasValue)
+            options.repetitions = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(arg, "--sample-rate") == 0 && hasValue)
+            options.sampleRate = std::clamp(std::atof(argv[++i]), 8000.0, 384000.0);
+        else if (std::strcmp(arg, "--block-size") == 0 && hasValue)
+            options.blockSize = std::clamp(std::atoi(argv[++i]), 1, 8192);
+        else {
+            printUsage();
+            return std::strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    auto& registry = EffectModuleRegistry::getInstance();
+    std::vector<std::string> modules;
+    for (const auto& name : registry.getAvailableModules())
+        if (options.moduleName.empty() || name.toStdString() == options.moduleName)
+            modules.push_back(name.toStdString());
+    if (modules.empty()) {
+        std::fprintf(stderr, "dsp256_golden: unknown module '%s'\n", options.moduleName.c_str());
+        return 1;
+    }
+
+    // A check renders with the settings the goldens were recorded at; an
+    // update of one module keeps the other modules' entries
+    const std::string manifestPath = options.goldenDir + "/manifest.txt";
+    Manifest manifest;
+    std::string error;
+    const bool haveManifest = readManifest(manifestPath, manifest, error);
+    if (options.update) {
+        if (haveManifest && !options.moduleName.empty()
+            && (manifest.sampleRate != options.sampleRate || manifest.blockSize != options.blockSize)) {
+            std::fprintf(stderr, "dsp256_golden: goldens were recorded at %.0f Hz/%d; update every module to change that\n",
+                manifest.sampleRate, manifest.blockSize);
+            return 1;
+        }
+        if (!haveManifest || options.moduleName.empty())
+            manifest.entries.clear();
+
+        std::error_code created;
+        std::filesystem::create_directories(options.goldenDir, created);
+        if (created) {
+            std::fprintf(stderr, "dsp256_golden: cannot create %s\n", options.goldenDir.c_str());
+            return 1;
+        }
+        manifest.sampleRate = options.sampleRate;
+        manifest.blockSize = options.blockSize;
+    }
+    else if (!haveManifest) {
+        std::fprintf(stderr, "dsp256_golden: %s\n", error.c_str());
+        return 1;
+    }
+
+    const auto signals = makeSignals(manifest.sampleRate);
+    int cases = 0;
+    int failures = 0;
+    double logSpeedRatio[2] = {};
+    int timedCases[2] = {};
+    const auto started = Clock::now();
+
+    for (const auto& moduleName : modules) {
+        const auto presets = registry.createModule(moduleName.c_str())->getFactoryPresets();
+        for (const auto& preset : presets) {
+            for (const auto& signal : signals) {
+                for (RenderPath path : { RenderPath::FixedPoint, RenderPath::Block }) {
+                    const std::string caseName = caseNameFor(moduleName, preset.name.toStdString(), signal.name, path);
+                    const std::string filePath = options.goldenDir + "/" + caseName + ".wav";
+                    const Rendered rendered = render(moduleName, preset, signal, path, manifest.sampleRate,
+                        manifest.blockSize, options.repetitions);
+                    ++cases;
+
+                    std::string verdict;
+                    bool failed = !rendered.deterministic;
+                    if (!rendered.deterministic)
+                        verdict = "differs between runs  ";
+
+                    const GoldenEntry entry{ rendered.nsPerSample, rendered.left.size(), hashRender(rendered) };
+                    if (options.update) {
+                        if (path == RenderPath::Block && !writeGolden(filePath, decimate(rendered), manifest.sampleRate, error)) {
+                            std::fprintf(stderr, "dsp256_golden: %s\n", error.c_str());
+                            return 1;
+                        }
+                        manifest.entries[caseName] = entry;
+                        std::printf("%-6s %-62s %8.1f ns/sample  %s\n", failed ? "FAIL" : "saved",
+                            caseName.c_str(), rendered.nsPerSample, verdict.c_str());
+                        failures += failed ? 1 : 0;
+                        continue;
+                    }
+
+                    const auto recorded = manifest.entries.find(caseName);
+                    if (recorded == manifest.entries.end()) {
+                        std::printf("FAIL   %-62s no golden (record it with --update)\n", caseName.c_str());
+                        ++failures;
+                        continue;
+                    }
+                    const GoldenEntry& golden = recorded->second;
+
+                    // Fixed point: bit for bit. Block path: within the tolerance
+                    // at the decimated frames.
+                    char detail[160];
+                    if (entry.frames != golden.frames) {
+                        std::snprintf(detail, sizeof(detail), "length %zu, golden %zu  ", entry.frames, golden.frames);
+                        failed = true;
+                    }
+                    else if (entry.hash == golden.hash) {
+                        std::snprintf(detail, sizeof(detail), "bit-exact  ");
+                    }
+                    else if (path == RenderPath::FixedPoint) {
+                        std::snprintf(detail, sizeof(detail), "hash %016llx, golden %016llx  ",
+                            static_cast<unsigned long long>(entry.hash), static_cast<unsigned long long>(golden.hash));
+                        failed = true;
+                    }
+                    else {
+                        std::vector<float> goldenLeft, goldenRight;
+                        if (!readGolden(filePath, goldenLeft, goldenRight, error)) {
+                            std::printf("FAIL   %-62s %s\n", caseName.c_str(), error.c_str());
+                            ++failures;
+                            continue;
+                        }
+
+                        const Rendered decimated = decimate(rendered);
+                        const Comparison comparison = compare(goldenLeft, goldenRight, decimated);
+                        if (!comparison.lengthMatches) {
+                            std::snprintf(detail, sizeof(detail), "%s has %zu frames, expected %zu  ", filePath.c_str(),
+                                goldenLeft.size(), decimated.left.size());
+                            failed = true;
+                        }
+                        else if (comparison.identical) {
+                            std::snprintf(detail, sizeof(detail), "hash differs, decimated frames bit-exact  ");
+                        }
+                        else {
+                            std::snprintf(detail, sizeof(detail), "max dev %.3g, first at %lld %s  ", comparison.maxDeviation,
+                                static_cast<long long>(comparison.firstDivergent) * DECIMATION, comparison.firstChannel);
+                            if (comparison.maxDeviation > options.tolerance)
+                                failed = true;
+                        }
+                    }
+                    verdict += detail;
+
+                    // Speed against the recording build
+                    if (golden.nsPerSample > 0.0) {
+                        const double ratio = rendered.nsPerSample / golden.nsPerSample;
+                        char speed[64];
+                        std::snprintf(speed, sizeof(speed), "%.2fx recorded time", ratio);
+                        verdict += speed;
+                        logSpeedRatio[static_cast<int>(path)] += std::log(ratio);
+                        ++timedCases[static_cast<int>(path)];
+                        if (options.maxSlowdown > 0.0 && ratio > options.maxSlowdown)
+                            failed = true;
+                    }
+
+                    std::printf("%-6s %-62s %8.1f ns/sample  %s\n", failed ? "FAIL" : "ok",
+                        caseName.c_str(), rendered.nsPerSample, verdict.c_str());
+                    failures += failed ? 1 : 0;
+                }
+            }
+        }
+    }
+
+    if (options.update && !writeManifest(manifestPath, manifest)) {
+        std::fprintf(stderr, "dsp256_golden: cannot write %s\n", manifestPath.c_str());
+        return 1;
+    }
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - started).count();
+    std::printf("%s: %d case(s), %d failed, %.1f s", failures == 0 ? "PASS" : "FAIL", cases, failures, seconds);
+    for (RenderPath path : { RenderPath::FixedPoint, RenderPath::Block }) {
+        const int index = static_cast<int>(path);
+        if (timedCases[index] > 0)
+            std::printf(", %s %.2fx recorded time (geometric mean)", pathName(path), std::exp(logSpeedRatio[index] / timedCases[index]));
+    }
+    std::printf("\n");
+    return failures == 0 ? 0 : 1;
+}
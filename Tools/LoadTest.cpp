@@ -0,0 +1,421 @@
+// LoadTest.cpp - Multi-instance capacity test for the effect modules
+//
+// Runs N module instances (OfflineHost, the processor's per-block calls)
+// from M simulated host audio threads. Each thread owns every M-th instance
+// and, once per buffer period, processes all of them back to back, as a
+// host processes the plugins on one of its audio threads. Every parameter
+// of every instance is automated. A message thread loads factory presets
+// under each instance's lock, and the audio thread skips a locked
+// instance, as PluginProcessor does with its processing lock. Reported:
+// the share of callbacks that overran their deadline, callback and
+// per-instance p50/p99/p999/max, and the CPU cores the run used.
+// Built by CMake as dsp256_loadtest:
+//
+//     dsp256_loadtest [--module name] [--instances n] [--threads m]
+//                     [--block-size n] [--sample-rate hz] [--seconds s]
+//                     [--deadline fraction] [--preset-interval s]
+//                     [--free-run] [--output file.json] [--trace file.json]
+
+#include "OfflineHost.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+ #define NOMINMAX
+ #include <windows.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string moduleName = "Reverb Hall";
+    std::string outputPath;
+    std::string traceFile;
+    int instances = 16;
+    int threads = 0;                   // 0: one per hardware thread, at most one per instance
+    int blockSize = 256;
+    double sampleRate = 48000.0;
+    double seconds = 10.0;
+    double deadline = 1.0;             // Fraction of the buffer period a callback may take
+    double presetInterval = 2.0;       // Seconds between preset changes on each instance; 0 = none
+    bool freeRun = false;              // Callbacks back to back instead of once per period
+};
+
+// CPU time of the whole process, all threads
+double processCpuSeconds()
+{
+#if defined(_WIN32)
+    FILETIME created, exited, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user))
+        return 0.0;
+    const auto ticks = [](const FILETIME& t) {
+        return static_cast<double>((static_cast<uint64_t>(t.dwHighDateTime) << 32) | t.dwLowDateTime);
+    };
+    return (ticks(kernel) + ticks(user)) * 1.0e-7;
+#else
+    timespec now{};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return static_cast<double>(now.tv_sec) + static_cast<double>(now.tv_nsec) * 1.0e-9;
+#endif
+}
+
+//==============================================================================
+// Instances and host threads
+//==============================================================================
+struct Instance {
+    std::unique_ptr<OfflineHost> host;
+    std::mutex lock;                   // Held by the message thread during preset loads
+    std::vector<EffectParameter> definitions;
+    std::vector<EffectPreset> presets;
+    std::vector<float> left;
+    std::vector<float> right;
+    size_t inputOffset = 0;            // Into the shared input loop
+    float automationRate = 0.0f;       // Radians per block for parameter 0
+    int presetIndex = 0;
+};
+
+struct HostThread {
+    std::vector<Instance*> instances;
+    std::vector<double> callbackNs;
+    std::vector<double> instanceNs;
+    int64_t overruns = 0;
+    int64_t skippedBlocks = 0;         // Instances passed over while a preset was loading
+    std::thread thread;
+};
+
+struct Percentiles {
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double p999 = 0.0;
+    double max = 0.0;
+};
+
+Percentiles percentilesOf(std::vector<double> values)
+{
+    Percentiles result;
+    if (values.empty())
+        return result;
+
+    std::sort(values.begin(), values.end());
+    const auto at = [&](double fraction) {
+        const size_t rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(values.size())));
+        return values[std::min(values.size() - 1, rank > 0 ? rank - 1 : 0)];
+    };
+    result.p50 = at(0.50);
+    result.p99 = at(0.99);
+    result.p999 = at(0.999);
+    result.max = values.back();
+    return result;
+}
+
+// Ten seconds of decaying noise bursts, shared by every instance at its own offset
+std::vector<float> makeInputLoop(double sampleRate)
+{
+    std::vector<float> loop(static_cast<size_t>(sampleRate * 10.0));
+    dsp256::Random random(42);
+    float envelope = 0.0f;
+    const float decay = std::exp(-1.0f / static_cast<float>(sampleRate * 0.3));
+    for (size_t i = 0; i < loop.size(); ++i) {
+        if (i % static_cast<size_t>(sampleRate * 0.75) == 0)
+            envelope = 0.5f;
+        envelope *= decay;
+        loop[i] = (random.nextFloat() * 2.0f - 1.0f) * envelope;
+    }
+    return loop;
+}
+
+// One simulated audio thread: a callback per buffer period until 'callbacks' are done
+void runHostThread(HostThread& hostThread, const Options& options, const std::vector<float>& inputLoop,
+    int64_t callbacks, Clock::time_point start)
+{
+    const auto period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(options.blockSize / options.sampleRate));
+    const double deadlineNs = options.deadline * options.blockSize / options.sampleRate * 1.0e9;
+    const size_t blockSize = static_cast<size_t>(options.blockSize);
+    auto next = start;
+
+    for (int64_t callback = 0; callback < callbacks; ++callback) {
+        if (!options.freeRun)
+            std::this_thread::sleep_until(next);
+
+        const auto callbackStart = Clock::now();
+        for (auto* instance : hostThread.instances) {
+            std::unique_lock<std::mutex> locked(instance->lock, std::try_to_lock);
+            if (!locked.owns_lock()) {
+                ++hostThread.skippedBlocks;
+                continue;
+            }
+
+            // Host input and automation: every parameter on its own slow sine
+            auto& parameters = instance->host->getParameters();
+            for (int i = 0; i < parameters.size(); ++i) {
+                const auto& def = instance->definitions[static_cast<size_t>(i)];
+                const float phase = 0.5f + 0.5f * std::sin(instance->automationRate * static_cast<float>(callback * (i + 1)));
+                parameters.setValue(i, def.minValue + (def.maxValue - def.minValue) * phase);
+            }
+
+            const size_t offset = instance->inputOffset;
+            const size_t first = std::min(blockSize, inputLoop.size() - offset);
+            std::copy_n(inputLoop.data() + offset, first, instance->left.data());
+            std::copy_n(inputLoop.data(), blockSize - first, instance->left.data() + first);
+            std::copy_n(instance->left.data(), blockSize, instance->right.data());
+            instance->inputOffset = (offset + blockSize) % inputLoop.size();
+
+            const auto processStart = Clock::now();
+            instance->host->processBlock(instance->left.data(), instance->right.data(), options.blockSize);
+            hostThread.instanceNs.push_back(std::chrono::duration<double, std::nano>(Clock::now() - processStart).count());
+        }
+
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - callbackStart).count();
+        hostThread.callbackNs.push_back(ns);
+        if (ns > deadlineNs)
+            ++hostThread.overruns;
+
+        // Like a device clock: a late callback does not push the later ones back,
+        // but periods already missed entirely are dropped rather than caught up
+        next += period;
+        const auto now = Clock::now();
+        if (next + period < now)
+            next = now;
+    }
+}
+
+//==============================================================================
+// Report
+//==============================================================================
+struct Report {
+    int64_t callbacks = 0;
+    int64_t overruns = 0;
+    int64_t skippedBlocks = 0;
+    int64_t presetChanges = 0;
+    Percentiles callback;
+    Percentiles instance;
+    double wallSeconds = 0.0;
+    double cpuSeconds = 0.0;
+};
+
+void printReport(const Report& report, const Options& options, int threads)
+{
+    const double periodMs = options.blockSize / options.sampleRate * 1000.0;
+    const auto ms = [](double ns) { return ns * 1.0e-6; };
+
+    std::printf("%s: %d instance(s) on %d thread(s), %d samples @ %.0f Hz (%.3f ms period, deadline %.0f%%)\n",
+        options.moduleName.c_str(), options.instances, threads, options.blockSize, options.sampleRate,
+        periodMs, options.deadline * 100.0);
+    std::printf("callbacks   %lld, %.3f%% over deadline (%lld), %lld block(s) skipped during %lld preset change(s)\n",
+        static_cast<long long>(report.callbacks),
+        report.callbacks > 0 ? 100.0 * static_cast<double>(report.overruns) / static_cast<double>(report.callbacks) : 0.0,
+        static_cast<long long>(report.overruns), static_cast<long long>(report.skippedBlocks),
+        static_cast<long long>(report.presetChanges));
+    std::printf("callback    p50 %.3f ms  p99 %.3f ms  p999 %.3f ms  max %.3f ms\n",
+        ms(report.callback.p50), ms(report.callback.p99), ms(report.callback.p999), ms(report.callback.max));
+    std::printf("instance    p50 %.3f ms  p99 %.3f ms  p999 %.3f ms  max %.3f ms\n",
+        ms(report.instance.p50), ms(report.instance.p99), ms(report.instance.p999), ms(report.instance.max));
+    std::printf("cpu         %.2f core(s) (%.2f s CPU over %.2f s)\n",
+        report.wallSeconds > 0.0 ? report.cpuSeconds / report.wallSeconds : 0.0, report.cpuSeconds, report.wallSeconds);
+}
+
+void writeJson(std::FILE* out, const Report& report, const Options& options, int threads)
+{
+    const auto percentiles = [&](const char* name, const Percentiles& p, const char* separator) {
+        std::fprintf(out, "  \"%s_ns\": { \"p50\": %.0f, \"p99\": %.0f, \"p999\": %.0f, \"max\": %.0f }%s\n",
+            name, p.p50, p.p99, p.p999, p.max, separator);
+    };
+
+    std::fprintf(out, "{\n");
+    std::fprintf(out, "  \"module\": \"%s\",\n", options.moduleName.c_str());
+    std::fprintf(out, "  \"instances\": %d,\n  \"threads\": %d,\n", options.instances, threads);
+    std::fprintf(out, "  \"block_size\": %d,\n  \"sample_rate\": %.0f,\n", options.blockSize, options.sampleRate);
+    std::fprintf(out, "  \"deadline\": %.3f,\n  \"free_run\": %s,\n", options.deadline, options.freeRun ? "true" : "false");
+    std::fprintf(out, "  \"callbacks\": %lld,\n  \"overruns\": %lld,\n",
+        static_cast<long long>(report.callbacks), static_cast<long long>(report.overruns));
+    std::fprintf(out, "  \"overrun_percent\": %.4f,\n",
+        report.callbacks > 0 ? 100.0 * static_cast<double>(report.overruns) / static_cast<double>(report.callbacks) : 0.0);
+    std::fprintf(out, "  \"skipped_blocks\": %lld,\n  \"preset_changes\": %lld,\n",
+        static_cast<long long>(report.skippedBlocks), static_cast<long long>(report.presetChanges));
+    percentiles("callback", report.callback, ",");
+    percentiles("instance", report.instance, ",");
+    std::fprintf(out, "  \"wall_seconds\": %.3f,\n  \"cpu_seconds\": %.3f,\n", report.wallSeconds, report.cpuSeconds);
+    std::fprintf(out, "  \"cores_used\": %.3f\n", report.wallSeconds > 0.0 ? report.cpuSeconds / report.wallSeconds : 0.0);
+    std::fprintf(out, "}\n");
+}
+
+void printUsage()
+{
+    std::fprintf(stderr,
+        "usage: dsp256_loadtest [options]\n"
+        "  --module name         module to load (default \"Reverb Hall\")\n"
+        "  --instances n         instances, 1-256 (default 16)\n"
+        "  --threads m           simulated host audio threads (default: hardware threads)\n"
+        "  --block-size n        host buffer size (default 256)\n"
+        "  --sample-rate hz      (default 48000)\n"
+        "  --seconds s           run length (default 10)\n"
+        "  --deadline fraction   share of the buffer period a callback may use (default 1.0)\n"
+        "  --preset-interval s   seconds between preset changes per instance, 0 = none (default 2)\n"
+        "  --free-run            callbacks back to back rather than once per period\n"
+        "  --output file         also write the results as JSON\n"
+        "  --trace file          record trace events (Source/Tracer.h) and write Chrome trace JSON\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(arg, "--module") == 0 && hasValue)
+            options.moduleName = argv[++i];
+        else if (std::strcmp(arg, "--instances") == 0 && hasValue)
+            options.instances = std::clamp(std::atoi(argv[++i]), 1, 256);
+        else if (std::strcmp(arg, "--threads") == 0 && hasValue)
+            options.threads = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(arg, "--block-size") == 0 && hasValue)
+            options.blockSize = std::clamp(std::atoi(argv[++i]), 1, 8192);
+        else if (std::strcmp(arg, "--sample-rate") == 0 && hasValue)
+            options.sampleRate = std::clamp(std::atof(argv[++i]), 8000.0, 384000.0);
+        else if (std::strcmp(arg, "--seconds") == 0 && hasValue)
+            options.seconds = std::max(0.1, std::atof(argv[++i]));
+        else if (std::strcmp(arg, "--deadline") == 0 && hasValue)
+            options.deadline = std::clamp(std::atof(argv[++i]), 0.01, 1.0);
+        else if (std::strcmp(arg, "--preset-interval") == 0 && hasValue)
+            options.presetInterval = std::max(0.0, std::atof(argv[++i]));
+        else if (std::strcmp(arg, "--free-run") == 0)
+            options.freeRun = true;
+        else if (std::strcmp(arg, "--output") == 0 && hasValue)
+            options.outputPath = argv[++i];
+        else if (std::strcmp(arg, "--trace") == 0 && hasValue)
+            options.traceFile = argv[++i];
+        else {
+            printUsage();
+            return std::strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    auto& registry = EffectModuleRegistry::getInstance();
+    if (registry.createModule(options.moduleName.c_str()) == nullptr) {
+        std::fprintf(stderr, "dsp256_loadtest: unknown module '%s'\n", options.moduleName.c_str());
+        return 1;
+    }
+
+    if (options.threads == 0)
+        options.threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const int threads = std::min(options.threads, options.instances);
+
+    // Attached for the whole run so tracing starts before the first host
+    auto& tracer = Tracer::getInstance();
+    tracer.attach();
+    if (!options.traceFile.empty())
+        tracer.start(".");
+
+    // Everything is allocated and prepared before the clock starts
+    const auto inputLoop = makeInputLoop(options.sampleRate);
+    std::vector<std::unique_ptr<Instance>> instances;
+    for (int i = 0; i < options.instances; ++i) {
+        auto instance = std::make_unique<Instance>();
+        instance->host = std::make_unique<OfflineHost>(registry.createModule(options.moduleName.c_str()));
+        instance->host->prepare(options.sampleRate, options.blockSize);
+        instance->host->setTempo(120.0);
+        instance->definitions = instance->host->getModule().getParameterDefinitions();
+        instance->presets = instance->host->getModule().getFactoryPresets();
+        instance->left.resize(static_cast<size_t>(options.blockSize));
+        instance->right.resize(static_cast<size_t>(options.blockSize));
+        instance->inputOffset = static_cast<size_t>(i) * inputLoop.size() / static_cast<size_t>(options.instances);
+        instance->automationRate = 0.002f * static_cast<float>(1 + i % 7);
+        instance->presetIndex = i;
+        instances.push_back(std::move(instance));
+    }
+
+    const int64_t callbacks = std::max<int64_t>(1, static_cast<int64_t>(options.seconds * options.sampleRate / options.blockSize));
+    std::vector<HostThread> hostThreads(static_cast<size_t>(threads));
+    for (int i = 0; i < options.instances; ++i)
+        hostThreads[static_cast<size_t>(i % threads)].instances.push_back(instances[static_cast<size_t>(i)].get());
+    for (auto& hostThread : hostThreads) {
+        hostThread.callbackNs.reserve(static_cast<size_t>(callbacks));
+        hostThread.instanceNs.reserve(static_cast<size_t>(callbacks) * hostThread.instances.size());
+    }
+
+    const double cpuStart = processCpuSeconds();
+    const auto start = Clock::now() + std::chrono::milliseconds(20);
+    std::atomic<int> running{ threads };
+    for (auto& hostThread : hostThreads) {
+        hostThread.thread = std::thread([&] {
+            runHostThread(hostThread, options, inputLoop, callbacks, start);
+            --running;
+        });
+    }
+
+    // Message thread: staggered preset loads, one instance at a time
+    Report report;
+    if (options.presetInterval > 0.0) {
+        const auto step = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(options.presetInterval / options.instances));
+        auto next = start + step;
+        for (size_t target = 0; running.load() > 0; target = (target + 1) % instances.size()) {
+            std::this_thread::sleep_until(next);
+            next += step;
+
+            auto& instance = *instances[target];
+            if (instance.presets.empty())
+                continue;
+            const std::lock_guard<std::mutex> locked(instance.lock);
+            instance.presetIndex = (instance.presetIndex + 1) % static_cast<int>(instance.presets.size());
+            instance.host->getParameters().loadPreset(instance.host->getModule(),
+                instance.presets[static_cast<size_t>(instance.presetIndex)]);
+            ++report.presetChanges;
+        }
+    }
+
+    std::vector<double> callbackNs;
+    std::vector<double> instanceNs;
+    for (auto& hostThread : hostThreads) {
+        hostThread.thread.join();
+        report.overruns += hostThread.overruns;
+        report.skippedBlocks += hostThread.skippedBlocks;
+        callbackNs.insert(callbackNs.end(), hostThread.callbackNs.begin(), hostThread.callbackNs.end());
+        instanceNs.insert(instanceNs.end(), hostThread.instanceNs.begin(), hostThread.instanceNs.end());
+    }
+    report.wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    report.cpuSeconds = processCpuSeconds() - cpuStart;
+    report.callbacks = static_cast<int64_t>(callbackNs.size());
+    report.callback = percentilesOf(std::move(callbackNs));
+    report.instance = percentilesOf(std::move(instanceNs));
+
+    printReport(report, options, threads);
+
+    int status = 0;
+    if (!options.outputPath.empty()) {
+        std::FILE* out = std::fopen(options.outputPath.c_str(), "w");
+        if (out != nullptr) {
+            writeJson(out, report, options, threads);
+            std::fclose(out);
+        }
+        else {
+            std::fprintf(stderr, "dsp256_loadtest: cannot write %s\n", options.outputPath.c_str());
+            status = 1;
+        }
+    }
+    if (!options.traceFile.empty() && !tracer.dumpTo(options.traceFile)) {
+        std::fprintf(stderr, "dsp256_loadtest: cannot write %s\n", options.traceFile.c_str());
+        status = 1;
+    }
+
+    tracer.detach();
+    return status;
+}
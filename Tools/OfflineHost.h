@@ -0,0 +1,384 @@
+// OfflineHost.h - PluginProcessor's module driving, reproduced for offline tools
+#pragma once
+
+#include "EffectModule.h"
+#include "FixedPointDSP.h"
+#include "DelayMemoryPool.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <xmmintrin.h>
+ #define DSP256_HOST_MXCSR 1
+#else
+ #define DSP256_HOST_MXCSR 0
+#endif
+
+//==============================================================================
+// PluginProcessor keeps one AudioParameterFloat per module parameter, ranged
+// in the parameter's own units (EffectParameter min/max/step, skewed around
+// the geometric centre when logarithmic), and hands each value that changed
+// to setParameter() at the start of a host block, normalized by
+// EffectParameter::toNormalized(). Presets set each parameter to the
+// module's value in units (fromNormalized()). To render the same samples as
+// the plugin, offline tools must start from the very values the parameter
+// objects would hold; this reproduces JUCE's NormalisableRange arithmetic
+// (in float, like the plugin) to get them.
+//==============================================================================
+class HostParameterRange {
+public:
+    explicit HostParameterRange(const EffectParameter& def)
+        : start(def.minValue), end(def.maxValue), interval(def.stepSize)
+    {
+        if (def.isLogarithmic) {
+            const float centre = std::sqrt(def.minValue * def.maxValue);
+            skew = std::log(0.5f) / std::log((centre - start) / (end - start));
+        }
+    }
+
+    float convertTo0to1(float value) const
+    {
+        float proportion = clamp01((value - start) / (end - start));
+        return skew == 1.0f ? proportion : std::pow(proportion, skew);
+    }
+
+    float convertFrom0to1(float proportion) const
+    {
+        proportion = clamp01(proportion);
+        if (skew != 1.0f && proportion > 0.0f)
+            proportion = std::exp(std::log(proportion) / skew);
+        return start + (end - start) * proportion;
+    }
+
+    float snapToLegalValue(float value) const
+    {
+        if (interval > 0.0f)
+            value = start + interval * std::floor((value - start) / interval + 0.5f);
+        return (value <= start || end <= start) ? start : (value >= end ? end : value);
+    }
+
+    // What the parameter holds after the host (or a preset) sets 'normalized'
+    float fromNormalized(float normalized) const
+    {
+        return snapToLegalValue(convertFrom0to1(clamp01(normalized)));
+    }
+
+    // What the parameter holds after being set to 'value' in its own units
+    // (state restore, automation in real units)
+    float fromValue(float value) const { return fromNormalized(convertTo0to1(value)); }
+
+private:
+    static float clamp01(float v) { return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v); }
+
+    float start;
+    float end;
+    float interval;
+    float skew = 1.0f;
+};
+
+//==============================================================================
+// The raw parameter values the processor would pass to the module
+//==============================================================================
+class HostParameters {
+public:
+    explicit HostParameters(const EffectModule& module)
+        : definitions(module.getParameterDefinitions())
+    {
+        for (const auto& def : definitions) {
+            ranges.emplace_back(def);
+            values.push_back(ranges.back().fromValue(def.defaultValue));
+        }
+        applied = values;
+    }
+
+    int size() const { return static_cast<int>(values.size()); }
+    float get(int index) const { return values[static_cast<size_t>(index)]; }
+
+    // State restore or automation, in the parameter's units
+    void setValue(int index, float value)
+    {
+        if (index >= 0 && index < size())
+            values[static_cast<size_t>(index)] = ranges[static_cast<size_t>(index)].fromValue(value);
+    }
+
+    // PluginProcessor::loadPreset(): the module loads the preset, then each
+    // parameter is set to the module's value in units
+    void loadPreset(EffectModule& module, const EffectPreset& preset)
+    {
+        module.loadPreset(preset);
+        const size_t count = std::min(values.size(), preset.parameterValues.size());
+        for (size_t i = 0; i < count; ++i) {
+            const float actual = module.getParameter(static_cast<int>(i));
+            values[i] = ranges[i].fromValue(definitions[i].fromNormalized(actual));
+            applied[i] = values[i];
+        }
+    }
+
+    // Start of a host block, as PluginProcessor::processBlock() does it: only
+    // values that changed since the last block reach the module. Returns how many.
+    int apply(EffectModule& module)
+    {
+        int changed = 0;
+        for (int i = 0; i < module.getParameterCount() && i < size(); ++i) {
+            const size_t index = static_cast<size_t>(i);
+            if (values[index] != applied[index]) {
+                applied[index] = values[index];
+                module.setParameter(i, definitions[index].toNormalized(values[index]));
+                ++changed;
+            }
+        }
+        return changed;
+    }
+
+    // Every value, as the processor does at construction and state restore
+    void applyAll(EffectModule& module)
+    {
+        for (int i = 0; i < module.getParameterCount() && i < size(); ++i) {
+            const size_t index = static_cast<size_t>(i);
+            applied[index] = values[index];
+            module.setParameter(i, definitions[index].toNormalized(values[index]));
+        }
+    }
+
+private:
+    std::vector<EffectParameter> definitions;
+    std::vector<HostParameterRange> ranges;
+    std::vector<float> values;
+    std::vector<float> applied;      // Last values passed to the module
+};
+
+//==============================================================================
+// juce::ScopedNoDenormals: flush-to-zero (and denormals-are-zero on x86) for
+// the scope, as the processor has around every processBlock()
+//==============================================================================
+class ScopedFlushDenormals {
+public:
+    ScopedFlushDenormals() noexcept
+    {
+#if DSP256_HOST_MXCSR
+        previous = _mm_getcsr();
+        _mm_setcsr(previous | 0x8040);
+#elif defined(__aarch64__)
+        asm volatile("mrs %0, fpcr" : "=r"(previous));
+        const uint64_t flushed = previous | (1ULL << 24);
+        asm volatile("msr fpcr, %0" : : "r"(flushed));
+#endif
+    }
+
+    ~ScopedFlushDenormals() noexcept
+    {
+#if DSP256_HOST_MXCSR
+        _mm_setcsr(previous);
+#elif defined(__aarch64__)
+        asm volatile("msr fpcr, %0" : : "r"(previous));
+#endif
+    }
+
+private:
+#if DSP256_HOST_MXCSR
+    unsigned int previous = 0;
+#else
+    uint64_t previous = 0;
+#endif
+
+    ScopedFlushDenormals(const ScopedFlushDenormals&) = delete;
+    ScopedFlushDenormals& operator=(const ScopedFlushDenormals&) = delete;
+};
+
+//==============================================================================
+// One module driven exactly as PluginProcessor drives it: parameters applied
+// at the start of each host block, then sub-blocks that end on the 64-sample
+// modulation boundary, under ScopedFlushDenormals. Stereo by default; wider
+// layouts and a sidechain key are opt-in. Same host block sizes in, same
+// samples out. Each host owns its own engine and
+// delay pool, so separate hosts can run on separate threads.
+//==============================================================================
+class OfflineHost {
+public:
+    static constexpr int MODULATION_UPDATE_RATE = 64;     // PluginProcessor::MODULATION_UPDATE_RATE
+    static constexpr size_t DELAY_POOL_SIZE = 131072;     // The processor's global pool
+
+    explicit OfflineHost(std::unique_ptr<EffectModule> moduleToHost)
+        : module(std::move(moduleToHost)),
+          parameters(*module),
+          pool(DELAY_POOL_SIZE),
+          tracer(Tracer::getInstance())
+    {
+        parameters.applyAll(*module);
+        traceInstance = tracer.attach();
+        traceModuleName = tracer.internName(module->getModuleName().toStdString());
+    }
+
+    ~OfflineHost() { tracer.detach(); }
+
+    EffectModule& getModule() { return *module; }
+    HostParameters& getParameters() { return parameters; }
+
+    void prepare(double newSampleRate, int maxBlockSize)
+    {
+        sampleRate = newSampleRate;
+        engine.prepare(sampleRate);
+        pool.prepare(sampleRate);
+        module->prepare(sampleRate, maxBlockSize);
+        module->setOutputLayout(OutputLayout{});
+        modulationCounter = 0;
+        samplePosition = 0;
+    }
+
+    // Host tempo for tempo-synced modules; 0 means no playhead (the default)
+    void setTempo(double bpm) { tempo = bpm; }
+
+    // Offline renders: the module may do background work in line (see
+    // EffectModule::setNonRealtime), as in a host bounce. Off by default,
+    // which is the real-time behaviour the load and safety tests want.
+    void setNonRealtime(bool isNonRealtime) { module->setNonRealtime(isNonRealtime); }
+
+    // Fixes the delay pool's noise floor and bit flips (seeded from the clock
+    // by default) so renders are repeatable; call before processing
+    void setRandomSeed(int64_t seed) { pool.setRandomSeed(seed); }
+
+    // Runs the module's reference kernel (EffectModule::processBlockReference)
+    // in place of its processBlock(), as the plugin does with
+    // DSP256_KERNELS=reference. Off by default.
+    void setReferenceKernels(bool useReference) { referenceKernels = useReference; }
+
+    // A wider output bus (surround or FOA) for processBlockMultichannel();
+    // prepare() resets it to stereo, as a fresh prepareToPlay() would
+    void setOutputLayout(const OutputLayout& layout) { module->setOutputLayout(layout); }
+
+    // Sidechain key for the next host block(s), as long as the block;
+    // nullptr (the default) keys from the dry input. The processor hands the
+    // module each sub-block's part of it.
+    void setSidechain(const float* left, const float* right)
+    {
+        keyLeft = left;
+        keyRight = right;
+    }
+
+    // One host callback, in place
+    void processBlock(float* left, float* right, int numSamples)
+    {
+        processSubBlocks(numSamples, [&](int sample, int chunk) {
+            if (referenceKernels)
+                module->processBlockReference(left + sample, right + sample, chunk, pool, engine);
+            else
+                module->processBlock(left + sample, right + sample, chunk, pool, engine);
+        });
+    }
+
+    // One host callback on a bus wider than stereo, in place; the processor
+    // takes this path for every layout above two channels
+    void processBlockMultichannel(float* const* channels, int numChannels, int numSamples)
+    {
+        numChannels = std::min(numChannels, OutputLayout::MAX_CHANNELS);
+        processSubBlocks(numSamples, [&](int sample, int chunk) {
+            float* chunkChannels[OutputLayout::MAX_CHANNELS] = {};
+            for (int ch = 0; ch < numChannels; ++ch)
+                chunkChannels[ch] = channels[ch] + sample;
+            module->processBlockMultichannel(chunkChannels, numChannels, chunk, pool, engine);
+        });
+    }
+
+    // The same host block through the module's per-sample Q12 entry point,
+    // EffectModule::process(). The processor never calls it. It is the
+    // fixed-point reference that the regression tools hold the block paths to.
+    void processBlockFixedPoint(FixedPointSample* left, FixedPointSample* right, int numSamples)
+    {
+        ScopedFlushDenormals noDenormals;
+
+        parameters.apply(*module);
+        applyTransport();
+
+        int sample = 0;
+        while (sample < numSamples) {
+            const int chunk = std::min(numSamples - sample, MODULATION_UPDATE_RATE - modulationCounter);
+            for (int i = sample; i < sample + chunk; ++i)
+                module->process(left[i], right[i], pool, engine);
+
+            sample += chunk;
+            modulationCounter += chunk;
+            if (modulationCounter >= MODULATION_UPDATE_RATE) {
+                module->updateModulation(modulationCounter);
+                modulationCounter = 0;
+            }
+        }
+
+        samplePosition += numSamples;
+    }
+
+    FixedPointEngine& getEngine() { return engine; }
+
+private:
+    template <typename ProcessChunk>
+    void processSubBlocks(int numSamples, ProcessChunk&& processChunk)
+    {
+        ScopedFlushDenormals noDenormals;
+        const Tracer::ScopedSpan callbackSpan(tracer, Tracer::Category::Callback, "processBlock", traceInstance, numSamples);
+
+        const auto parameterStart = tracer.isEnabled() ? Tracer::now() : 0;
+        const int changed = parameters.apply(*module);
+        if (parameterStart != 0)
+            tracer.recordSpan(Tracer::Category::Parameter, "parameters", traceInstance, parameterStart, changed);
+
+        applyTransport();
+
+        int sample = 0;
+        while (sample < numSamples) {
+            const int chunk = std::min(numSamples - sample, MODULATION_UPDATE_RATE - modulationCounter);
+            if (keyLeft != nullptr)
+                module->setSidechainInput(keyLeft + sample, keyRight + sample);
+            else
+                module->setSidechainInput(nullptr, nullptr);
+
+            const auto moduleStart = tracer.isEnabled() ? Tracer::now() : 0;
+            processChunk(sample, chunk);
+            if (moduleStart != 0)
+                tracer.recordSpan(Tracer::Category::Module, traceModuleName, traceInstance, moduleStart, chunk);
+
+            sample += chunk;
+            modulationCounter += chunk;
+            if (modulationCounter >= MODULATION_UPDATE_RATE) {
+                module->updateModulation(modulationCounter);
+                modulationCounter = 0;
+            }
+        }
+
+        samplePosition += numSamples;
+    }
+
+    void applyTransport()
+    {
+        if (tempo > 0.0) {
+            TransportInfo transport;
+            transport.bpm = tempo;
+            transport.hasTempo = true;
+            transport.isPlaying = true;
+            transport.ppqPosition = static_cast<double>(samplePosition) / sampleRate * tempo / 60.0;
+            module->setTransportInfo(transport);
+        }
+    }
+
+    std::unique_ptr<EffectModule> module;
+    HostParameters parameters;
+    FixedPointEngine engine;
+    DelayMemoryPool pool;
+    double sampleRate = 44100.0;
+    double tempo = 0.0;
+    int modulationCounter = 0;
+    int64_t samplePosition = 0;
+    bool referenceKernels = false;
+    const float* keyLeft = nullptr;
+    const float* keyRight = nullptr;
+
+    // Same trace events as the processor
+    Tracer& tracer;
+    uint32_t traceInstance = 0;
+    const char* traceModuleName = "";
+
+    OfflineHost(const OfflineHost&) = delete;
+    OfflineHost& operator=(const OfflineHost&) = delete;
+};
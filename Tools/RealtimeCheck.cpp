@@ -0,0 +1,465 @@
+// RealtimeCheck.cpp - Audio-thread safety checker for the effect modules
+//
+// Runs every registered module through OfflineHost::processBlock() (the same
+// calls PluginProcessor makes per host block) with malloc/free, the pthread
+// locking and waiting calls, static initialisation guards and the usual
+// blocking syscalls interposed. Any of them reached while a block is being
+// processed is a violation; the run fails if there is one. Scenarios mirror
+// the plugin's life cycle: after prepare, under automation of every
+// parameter, after each factory preset and after a state restore. Then
+// the other paths the processor can take: a sidechain key, the reference
+// kernel (DSP256_KERNELS=reference), and 5.1 and first-order ambisonic
+// buses through processBlockMultichannel(). Linux (glibc) only: the hooks
+// forward to glibc's own entry points.
+//
+//     dsp256_rtcheck [--module name] [--blocks n] [--backtrace] [--trace file]
+
+#include "OfflineHost.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <sys/select.h>
+#include <time.h>
+#include <unistd.h>
+
+//==============================================================================
+// Violation bookkeeping. Everything here is reachable from inside the hooks,
+// so it only touches atomics, thread_locals and static storage.
+//==============================================================================
+namespace rtcheck {
+
+enum Kind { Allocation, Deallocation, Lock, StaticInit, Syscall, NUM_KINDS };
+
+const char* const kindNames[NUM_KINDS] = { "allocation", "deallocation", "lock/wait", "static init", "syscall" };
+
+constexpr int MAX_FRAMES = 32;
+
+thread_local bool inAudioCallback = false;   // Set around each checked block
+thread_local bool inHook = false;            // Nested hook calls are not counted twice
+
+std::atomic<int> counts[NUM_KINDS];
+bool captureBacktrace = false;
+
+// First violation of the current scenario
+std::atomic<bool> haveFirst{ false };
+const char* firstCall = nullptr;
+void* firstFrames[MAX_FRAMES];
+int firstFrameCount = 0;
+
+void report(Kind kind, const char* call)
+{
+    if (!inAudioCallback || inHook)
+        return;
+
+    inHook = true;
+    counts[kind].fetch_add(1, std::memory_order_relaxed);
+    if (!haveFirst.exchange(true)) {
+        firstCall = call;
+        firstFrameCount = captureBacktrace ? backtrace(firstFrames, MAX_FRAMES) : 0;
+    }
+    inHook = false;
+}
+
+void resetCounts()
+{
+    for (auto& count : counts)
+        count.store(0);
+    haveFirst.store(false);
+    firstCall = nullptr;
+    firstFrameCount = 0;
+}
+
+struct ScopedAudioCallback {
+    ScopedAudioCallback() { inAudioCallback = true; }
+    ~ScopedAudioCallback() { inAudioCallback = false; }
+};
+
+// The real function behind a hook, looked up on first use. 'slot' must be
+// constant-initialized: a function-local static with a guard would recurse
+// through the __cxa_guard_acquire hook.
+template <typename Function>
+Function next(std::atomic<Function>& slot, const char* name)
+{
+    Function real = slot.load(std::memory_order_acquire);
+    if (real == nullptr) {
+        real = reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+        slot.store(real, std::memory_order_release);
+    }
+    return real;
+}
+
+} // namespace rtcheck
+
+//==============================================================================
+// Hooks. Allocation goes straight to glibc's __libc_* functions (dlsym itself
+// may allocate); the rest forward through RTLD_NEXT.
+//==============================================================================
+extern "C" {
+
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void* __libc_memalign(size_t, size_t);
+void __libc_free(void*);
+
+void* malloc(size_t size)
+{
+    rtcheck::report(rtcheck::Allocation, "malloc");
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+    rtcheck::report(rtcheck::Allocation, "calloc");
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size)
+{
+    rtcheck::report(rtcheck::Allocation, "realloc");
+    return __libc_realloc(pointer, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size)
+{
+    rtcheck::report(rtcheck::Allocation, "aligned_alloc");
+    return __libc_memalign(alignment, size);
+}
+
+void* memalign(size_t alignment, size_t size)
+{
+    rtcheck::report(rtcheck::Allocation, "memalign");
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** result, size_t alignment, size_t size)
+{
+    rtcheck::report(rtcheck::Allocation, "posix_memalign");
+    *result = __libc_memalign(alignment, size);
+    return *result != nullptr || size == 0 ? 0 : ENOMEM;
+}
+
+void free(void* pointer)
+{
+    if (pointer != nullptr)
+        rtcheck::report(rtcheck::Deallocation, "free");
+    __libc_free(pointer);
+}
+
+#define DSP256_FORWARD(kind, result, name, params, args)                 \
+    result name params                                                   \
+    {                                                                    \
+        static std::atomic<result (*) params> slot{ nullptr };          \
+        rtcheck::report(rtcheck::kind, #name);                           \
+        return rtcheck::next(slot, #name) args;                          \
+    }
+
+DSP256_FORWARD(Lock, int, pthread_mutex_lock, (pthread_mutex_t* m), (m))
+DSP256_FORWARD(Lock, int, pthread_rwlock_rdlock, (pthread_rwlock_t* l), (l))
+DSP256_FORWARD(Lock, int, pthread_rwlock_wrlock, (pthread_rwlock_t* l), (l))
+DSP256_FORWARD(Lock, int, pthread_cond_wait, (pthread_cond_t* c, pthread_mutex_t* m), (c, m))
+DSP256_FORWARD(Lock, int, pthread_cond_timedwait, (pthread_cond_t* c, pthread_mutex_t* m, const struct timespec* t), (c, m, t))
+DSP256_FORWARD(Lock, int, pthread_join, (pthread_t t, void** r), (t, r))
+DSP256_FORWARD(Lock, int, sem_wait, (sem_t* s), (s))
+DSP256_FORWARD(Syscall, ssize_t, read, (int fd, void* b, size_t n), (fd, b, n))
+DSP256_FORWARD(Syscall, ssize_t, write, (int fd, const void* b, size_t n), (fd, b, n))
+DSP256_FORWARD(Syscall, int, close, (int fd), (fd))
+DSP256_FORWARD(Syscall, FILE*, fopen, (const char* p, const char* m), (p, m))
+DSP256_FORWARD(Syscall, int, nanosleep, (const struct timespec* t, struct timespec* r), (t, r))
+DSP256_FORWARD(Syscall, int, clock_nanosleep, (clockid_t c, int f, const struct timespec* t, struct timespec* r), (c, f, t, r))
+DSP256_FORWARD(Syscall, int, usleep, (useconds_t u), (u))
+DSP256_FORWARD(Syscall, unsigned int, sleep, (unsigned int s), (s))
+DSP256_FORWARD(Syscall, int, sched_yield, (void), ())
+DSP256_FORWARD(Syscall, int, poll, (struct pollfd* f, nfds_t n, int t), (f, n, t))
+DSP256_FORWARD(Syscall, int, select, (int n, fd_set* r, fd_set* w, fd_set* e, struct timeval* t), (n, r, w, e, t))
+
+#undef DSP256_FORWARD
+
+int open(const char* path, int flags, ...)
+{
+    static std::atomic<int (*)(const char*, int, ...)> slot{ nullptr };
+    rtcheck::report(rtcheck::Syscall, "open");
+    va_list args;
+    va_start(args, flags);
+    const mode_t mode = (flags & O_CREAT) != 0 ? static_cast<mode_t>(va_arg(args, int)) : 0;
+    va_end(args);
+    return rtcheck::next(slot, "open")(path, flags, mode);
+}
+
+// First use of a function-local static: may take a lock and usually allocates
+int __cxa_guard_acquire(long long* guard)
+{
+    static std::atomic<int (*)(long long*)> slot{ nullptr };
+    rtcheck::report(rtcheck::StaticInit, "__cxa_guard_acquire");
+    return rtcheck::next(slot, "__cxa_guard_acquire")(guard);
+}
+
+} // extern "C"
+
+//==============================================================================
+// Scenarios
+//==============================================================================
+namespace {
+
+struct Options {
+    std::string moduleName;               // Empty: every registered module
+    std::string traceFile;                // Non-empty: check with the tracer recording
+    int blocks = 200;                     // Checked blocks per scenario and block size
+    std::vector<double> sampleRates{ 44100.0, 96000.0 };
+    std::vector<int> blockSizes{ 32, 480, 1024 };
+};
+
+struct ScenarioResult {
+    std::string name;
+    int counts[rtcheck::NUM_KINDS] = {};
+    const char* firstCall = nullptr;
+    std::vector<void*> frames;
+
+    bool failed() const
+    {
+        for (int count : counts)
+            if (count > 0)
+                return true;
+        return false;
+    }
+};
+
+// Deterministic test signal: decaying noise bursts with silent gaps
+void fillInput(std::vector<float>& left, std::vector<float>& right, dsp256::Random& random, int64_t& position)
+{
+    for (size_t i = 0; i < left.size(); ++i, ++position) {
+        const float envelope = (position % 24000) < 4800 ? 0.5f : 0.0f;
+        left[i] = (random.nextFloat() * 2.0f - 1.0f) * envelope;
+        right[i] = (random.nextFloat() * 2.0f - 1.0f) * envelope;
+    }
+}
+
+// Processes 'blocks' blocks, calling 'beforeBlock(index)' unchecked first.
+// Buses wider than stereo go through processBlockMultichannel(), with the
+// extra channels carrying the input at half level.
+template <typename BeforeBlock>
+ScenarioResult runScenario(const std::string& name, OfflineHost& host, int blockSize, int blocks,
+    int numChannels, BeforeBlock&& beforeBlock)
+{
+    std::vector<std::vector<float>> buffers(static_cast<size_t>(std::max(2, numChannels)),
+        std::vector<float>(static_cast<size_t>(blockSize)));
+    float* channels[OutputLayout::MAX_CHANNELS] = {};
+    for (size_t ch = 0; ch < buffers.size() && ch < OutputLayout::MAX_CHANNELS; ++ch)
+        channels[ch] = buffers[ch].data();
+    dsp256::Random random(42);
+    int64_t position = 0;
+
+    rtcheck::resetCounts();
+    for (int block = 0; block < blocks; ++block) {
+        beforeBlock(block);
+        fillInput(buffers[0], buffers[1], random, position);
+        for (size_t ch = 2; ch < buffers.size(); ++ch)
+            for (int i = 0; i < blockSize; ++i)
+                buffers[ch][static_cast<size_t>(i)] = 0.5f * buffers[ch % 2][static_cast<size_t>(i)];
+
+        rtcheck::ScopedAudioCallback audioThread;
+        if (numChannels > 2)
+            host.processBlockMultichannel(channels, numChannels, blockSize);
+        else
+            host.processBlock(channels[0], channels[1], blockSize);
+    }
+
+    ScenarioResult result;
+    result.name = name;
+    for (int kind = 0; kind < rtcheck::NUM_KINDS; ++kind)
+        result.counts[kind] = rtcheck::counts[kind].load();
+    result.firstCall = rtcheck::firstCall;
+    result.frames.assign(rtcheck::firstFrames, rtcheck::firstFrames + rtcheck::firstFrameCount);
+    return result;
+}
+
+std::vector<ScenarioResult> checkModule(const std::string& moduleName, const Options& options)
+{
+    std::vector<ScenarioResult> results;
+    auto& registry = EffectModuleRegistry::getInstance();
+
+    for (double sampleRate : options.sampleRates) {
+        for (int blockSize : options.blockSizes) {
+            const std::string where = " @ " + std::to_string(static_cast<int>(sampleRate)) + " Hz/" + std::to_string(blockSize);
+
+            OfflineHost host(registry.createModule(moduleName.c_str()));
+            host.prepare(sampleRate, blockSize);
+            host.setTempo(120.0);
+            auto& module = host.getModule();
+            auto& parameters = host.getParameters();
+            const auto definitions = module.getParameterDefinitions();
+
+            // Straight after prepareToPlay()
+            results.push_back(runScenario("prepare" + where, host, blockSize, options.blocks, 2, [](int) {}));
+
+            // Host automation: every parameter moves every block
+            results.push_back(runScenario("automation" + where, host, blockSize, options.blocks, 2, [&](int block) {
+                for (int i = 0; i < parameters.size(); ++i) {
+                    const auto& def = definitions[static_cast<size_t>(i)];
+                    const float phase = 0.5f + 0.5f * std::sin(0.05f * static_cast<float>(block) * static_cast<float>(i + 1));
+                    parameters.setValue(i, def.minValue + (def.maxValue - def.minValue) * phase);
+                }
+            }));
+
+            // Each factory preset, loaded as the message thread would
+            const auto presets = module.getFactoryPresets();
+            results.push_back(runScenario("preset-change" + where, host, blockSize, options.blocks, 2, [&](int block) {
+                if (!presets.empty() && block % 10 == 0)
+                    parameters.loadPreset(module, presets[static_cast<size_t>(block / 10) % presets.size()]);
+            }));
+
+            // setStateInformation(): a fresh set of values, all at once
+            results.push_back(runScenario("state-restore" + where, host, blockSize, options.blocks, 2, [&](int block) {
+                if (block % 25 != 0)
+                    return;
+                dsp256::Random random(block + 1);
+                for (int i = 0; i < parameters.size(); ++i) {
+                    const auto& def = definitions[static_cast<size_t>(i)];
+                    parameters.setValue(i, def.minValue + (def.maxValue - def.minValue) * random.nextFloat());
+                }
+            }));
+
+            // A sidechain bus: a fresh key every block, handed over per sub-block
+            std::vector<float> keyLeft(static_cast<size_t>(blockSize));
+            std::vector<float> keyRight(static_cast<size_t>(blockSize));
+            dsp256::Random keyRandom(7);
+            int64_t keyPosition = 0;
+            results.push_back(runScenario("sidechain" + where, host, blockSize, options.blocks, 2, [&](int) {
+                fillInput(keyLeft, keyRight, keyRandom, keyPosition);
+                host.setSidechain(keyLeft.data(), keyRight.data());
+            }));
+            host.setSidechain(nullptr, nullptr);
+
+            // DSP256_KERNELS=reference
+            host.setReferenceKernels(true);
+            results.push_back(runScenario("reference-kernel" + where, host, blockSize, options.blocks, 2, [](int) {}));
+            host.setReferenceKernels(false);
+
+            // Wider buses, as the processor sets them up in prepareToPlay()
+            const OutputLayout surround{ 6, 3, false };       // 5.1: L R C LFE Ls Rs
+            const OutputLayout ambisonic{ 4, -1, true };      // AmbiX FOA
+            for (const auto* layout : { &surround, &ambisonic }) {
+                if (!module.supportsOutputLayout(*layout))
+                    continue;
+                host.setOutputLayout(*layout);
+                results.push_back(runScenario((layout->ambisonic ? "foa" : "surround-5.1") + where, host, blockSize,
+                    options.blocks, layout->numChannels, [](int) {}));
+            }
+            host.setOutputLayout(OutputLayout{});
+        }
+    }
+
+    return results;
+}
+
+void printUsage()
+{
+    std::fprintf(stderr,
+        "usage: dsp256_rtcheck [options]\n"
+        "  --module name    check one module (default: every registered module)\n"
+        "  --blocks n       checked blocks per scenario (default 200)\n"
+        "  --backtrace      print the call stack of each scenario's first violation\n"
+        "  --trace file     record trace events during the checks (the tracer's audio-thread\n"
+        "                   path is checked too) and write them as Chrome trace JSON\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--module") == 0 && i + 1 < argc) {
+            options.moduleName = argv[++i];
+        }
+        else if (std::strcmp(arg, "--blocks") == 0 && i + 1 < argc) {
+            options.blocks = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(arg, "--backtrace") == 0) {
+            rtcheck::captureBacktrace = true;
+        }
+        else if (std::strcmp(arg, "--trace") == 0 && i + 1 < argc) {
+            options.traceFile = argv[++i];
+        }
+        else {
+            printUsage();
+            return std::strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    // backtrace() loads libgcc on first use; do that outside any checked block
+    void* warmUp[4];
+    backtrace(warmUp, 4);
+
+    auto& registry = EffectModuleRegistry::getInstance();
+    std::vector<std::string> modules;
+    for (const auto& name : registry.getAvailableModules())
+        if (options.moduleName.empty() || name.toStdString() == options.moduleName)
+            modules.push_back(name.toStdString());
+
+    if (modules.empty()) {
+        std::fprintf(stderr, "dsp256_rtcheck: unknown module '%s'\n", options.moduleName.c_str());
+        return 1;
+    }
+
+    // Attached for the whole run so tracing survives each host's teardown
+    auto& tracer = Tracer::getInstance();
+    if (!options.traceFile.empty()) {
+        tracer.attach();
+        tracer.start(".");
+    }
+
+    int failures = 0;
+    for (const auto& moduleName : modules) {
+        const auto results = checkModule(moduleName, options);
+
+        int moduleFailures = 0;
+        for (const auto& result : results) {
+            if (!result.failed())
+                continue;
+
+            ++moduleFailures;
+            std::printf("FAIL  %-16s %-34s", moduleName.c_str(), result.name.c_str());
+            for (int kind = 0; kind < rtcheck::NUM_KINDS; ++kind)
+                if (result.counts[kind] > 0)
+                    std::printf("  %s x%d", rtcheck::kindNames[kind], result.counts[kind]);
+            std::printf("  (first: %s)\n", result.firstCall != nullptr ? result.firstCall : "?");
+
+            if (!result.frames.empty()) {
+                std::fflush(stdout);
+                backtrace_symbols_fd(result.frames.data(), static_cast<int>(result.frames.size()), STDOUT_FILENO);
+            }
+        }
+
+        if (moduleFailures == 0)
+            std::printf("ok    %-16s %zu scenarios\n", moduleName.c_str(), results.size());
+        failures += moduleFailures;
+    }
+
+    if (!options.traceFile.empty()) {
+        if (!tracer.dumpTo(options.traceFile)) {
+            std::fprintf(stderr, "dsp256_rtcheck: cannot write %s\n", options.traceFile.c_str());
+            ++failures;
+        }
+        tracer.detach();
+    }
+
+    std::printf("%s: %d failing scenario(s)\n", failures == 0 ? "PASS" : "FAIL", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,379 @@
+// Render.cpp - Offline batch renderer for the effect modules
+//
+// Streams WAV/AIFF files through any registered module with a factory
+// preset, a saved plugin state and/or explicit parameter values, and writes
+// the result with the module's tail appended. Files are rendered in
+// parallel, one module instance per worker. For a given --block-size the
+// output is bit-identical to the plugin's at that host buffer size (see
+// OfflineHost.h), modules that use DelayMemoryPool's random bit flips aside.
+//
+//     dsp256_render [options] input... (--output file | --out-dir dir)
+
+#include "AudioFile.h"
+#include "OfflineHost.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+//==============================================================================
+struct RenderSettings {
+    std::string moduleName = "Reverb Hall";
+    std::string preset;                                   // Name or index, empty for none
+    std::vector<std::pair<int, float>> parameterValues;   // From --state, then --set
+    int blockSize = 512;
+    double tailSeconds = 2.0;                             // PluginProcessor::getTailLengthSeconds()
+    double tempo = 0.0;
+    int bitsPerSample = 32;
+    bool isFloat = true;
+    bool forceContainer = false;
+    AudioFileFormat::Container container = AudioFileFormat::Container::Wav;
+};
+
+struct RenderJob {
+    std::string input;
+    std::string output;
+};
+
+// Streamed in chunks of about this many frames (a whole number of host blocks)
+constexpr int CHUNK_FRAMES = 65536;
+
+std::mutex logLock;
+
+void logLine(const std::string& text)
+{
+    const std::lock_guard<std::mutex> lock(logLock);
+    std::fprintf(stderr, "%s\n", text.c_str());
+}
+
+//==============================================================================
+// Plugin state: the APVTS XML the processor saves, either as text or wrapped
+// in JUCE's binary header (as hosts store it). Only <PARAM id="paramN"
+// value="..."/> entries matter.
+//==============================================================================
+bool loadState(const std::string& path, std::vector<std::pair<int, float>>& values, std::string& error)
+{
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        error = "cannot open state " + path;
+        return false;
+    }
+
+    std::stringstream contents;
+    contents << stream.rdbuf();
+    std::string xml = contents.str();
+    if (xml.size() >= 8 && static_cast<uint8_t>(xml[0]) == 0x56 && static_cast<uint8_t>(xml[1]) == 0x43
+        && static_cast<uint8_t>(xml[2]) == 0x32 && static_cast<uint8_t>(xml[3]) == 0x21)
+        xml.erase(0, 8);                                  // copyXmlToBinary() magic and size
+
+    auto attribute = [](const std::string& element, const char* name, std::string& value) {
+        const std::string key = std::string(name) + "=\"";
+        const auto start = element.find(key);
+        if (start == std::string::npos)
+            return false;
+        const auto end = element.find('"', start + key.size());
+        value = element.substr(start + key.size(), end - start - key.size());
+        return end != std::string::npos;
+    };
+
+    const size_t before = values.size();
+    for (size_t pos = xml.find("<PARAM"); pos != std::string::npos; pos = xml.find("<PARAM", pos + 1)) {
+        const std::string element = xml.substr(pos, xml.find('>', pos) - pos);
+        std::string id, value;
+        if (attribute(element, "id", id) && attribute(element, "value", value) && id.compare(0, 5, "param") == 0)
+            values.emplace_back(std::atoi(id.c_str() + 5), static_cast<float>(std::atof(value.c_str())));
+    }
+
+    if (values.size() == before) {
+        error = "no parameters in state " + path;
+        return false;
+    }
+    return true;
+}
+
+bool applyPreset(OfflineHost& host, const std::string& preset, std::string& error)
+{
+    auto& module = host.getModule();
+    const auto presets = module.getFactoryPresets();
+
+    for (size_t i = 0; i < presets.size(); ++i) {
+        if (presets[i].name.toStdString() == preset || std::to_string(i) == preset) {
+            host.getParameters().loadPreset(module, presets[i]);
+            return true;
+        }
+    }
+
+    error = "no preset '" + preset + "' in " + module.getModuleName().toStdString();
+    return false;
+}
+
+//==============================================================================
+// One file, start to finish, on the calling thread
+//==============================================================================
+bool renderFile(const RenderSettings& settings, const RenderJob& job, double& realtimeFactor, std::string& error)
+{
+    const auto started = std::chrono::steady_clock::now();
+
+    AudioFileReader reader;
+    if (!reader.open(job.input, error))
+        return false;
+
+    const auto& inputFormat = reader.getFormat();
+    if (inputFormat.numChannels > 2) {
+        error = job.input + ": only mono and stereo files are supported";
+        return false;
+    }
+
+    OfflineHost host(EffectModuleRegistry::getInstance().createModule(settings.moduleName.c_str()));
+    host.prepare(inputFormat.sampleRate, settings.blockSize);
+    host.setNonRealtime(true);
+    host.setTempo(settings.tempo);
+
+    if (!settings.preset.empty() && !applyPreset(host, settings.preset, error))
+        return false;
+    for (const auto& value : settings.parameterValues)
+        host.getParameters().setValue(value.first, value.second);
+
+    AudioFileFormat outputFormat = inputFormat;
+    outputFormat.numChannels = 2;
+    outputFormat.bitsPerSample = settings.bitsPerSample;
+    outputFormat.isFloat = settings.isFloat;
+    if (!AudioFileFormat::containerForPath(job.output, outputFormat.container)) {
+        error = job.output + ": unknown output format";
+        return false;
+    }
+
+    AudioFileWriter writer;
+    if (!writer.open(job.output, outputFormat, error))
+        return false;
+
+    const int chunkFrames = std::max(1, CHUNK_FRAMES / settings.blockSize) * settings.blockSize;
+    std::vector<float> left(static_cast<size_t>(chunkFrames));
+    std::vector<float> right(static_cast<size_t>(chunkFrames));
+    float* channels[2] = { left.data(), right.data() };
+
+    const int64_t inputFrames = reader.getLengthInFrames();
+    const int64_t totalFrames = inputFrames + static_cast<int64_t>(std::ceil(settings.tailSeconds * inputFormat.sampleRate));
+
+    for (int64_t position = 0; position < totalFrames;) {
+        const int frames = static_cast<int>(std::min<int64_t>(chunkFrames, totalFrames - position));
+        const int wanted = static_cast<int>(std::min<int64_t>(frames, std::max<int64_t>(0, inputFrames - position)));
+        const int got = wanted > 0 ? reader.read(channels, wanted) : 0;
+
+        // A short read (truncated file) is treated as silence, like the tail
+        std::fill(left.begin() + got, left.begin() + frames, 0.0f);
+        if (inputFormat.numChannels == 1)
+            std::copy(left.begin(), left.begin() + frames, right.begin());
+        else
+            std::fill(right.begin() + got, right.begin() + frames, 0.0f);
+
+        for (int start = 0; start < frames; start += settings.blockSize) {
+            const int count = std::min(settings.blockSize, frames - start);
+            host.processBlock(left.data() + start, right.data() + start, count);
+        }
+
+        if (!writer.write(channels, frames)) {
+            error = "write failed: " + job.output;
+            return false;
+        }
+        position += frames;
+    }
+
+    if (!writer.close()) {
+        error = "write failed: " + job.output;
+        return false;
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    realtimeFactor = (static_cast<double>(totalFrames) / inputFormat.sampleRate) / std::max(seconds, 1.0e-9);
+    return true;
+}
+
+//==============================================================================
+std::string outputPathFor(const std::string& input, const std::string& outDir, const RenderSettings& settings)
+{
+    const auto slash = input.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? input : input.substr(slash + 1);
+
+    if (settings.forceContainer) {
+        const auto dot = name.find_last_of('.');
+        name = (dot == std::string::npos ? name : name.substr(0, dot))
+            + (settings.container == AudioFileFormat::Container::Wav ? ".wav" : ".aiff");
+    }
+    return outDir + "/" + name;
+}
+
+void printUsage()
+{
+    std::fprintf(stderr,
+        "usage: dsp256_render [options] input... (--output file | --out-dir dir)\n"
+        "  --module name       effect module (default \"Reverb Hall\"; see --list-modules)\n"
+        "  --preset name|n     factory preset, by name or index (see --list-presets)\n"
+        "  --state file        plugin state: the saved APVTS XML or host binary blob\n"
+        "  --set n=value       parameter n in its own units, after preset and state\n"
+        "  --block-size n      host buffer size to reproduce (default 512)\n"
+        "  --tail seconds      silence rendered after the input (default 2)\n"
+        "  --tempo bpm         host tempo for tempo-synced modules\n"
+        "  --bits 16|24|32|float   output sample format (default float)\n"
+        "  --format wav|aiff   output container (default: the input's)\n"
+        "  --jobs n            files rendered in parallel (default: hardware threads)\n"
+        "  --list-modules, --list-presets\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    RenderSettings settings;
+    std::vector<std::string> inputs;
+    std::string outputPath;
+    std::string outDir;
+    int jobs = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    bool listModules = false;
+    bool listPresets = false;
+    std::string error;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--module" && hasValue) {
+            settings.moduleName = argv[++i];
+        }
+        else if (arg == "--preset" && hasValue) {
+            settings.preset = argv[++i];
+        }
+        else if (arg == "--state" && hasValue) {
+            if (!loadState(argv[++i], settings.parameterValues, error)) {
+                std::fprintf(stderr, "dsp256_render: %s\n", error.c_str());
+                return 1;
+            }
+        }
+        else if (arg == "--set" && hasValue) {
+            const std::string assignment = argv[++i];
+            const auto equals = assignment.find('=');
+            if (equals == std::string::npos) {
+                printUsage();
+                return 1;
+            }
+            settings.parameterValues.emplace_back(std::atoi(assignment.c_str()),
+                static_cast<float>(std::atof(assignment.c_str() + equals + 1)));
+        }
+        else if (arg == "--block-size" && hasValue) {
+            settings.blockSize = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--tail" && hasValue) {
+            settings.tailSeconds = std::max(0.0, std::atof(argv[++i]));
+        }
+        else if (arg == "--tempo" && hasValue) {
+            settings.tempo = std::max(0.0, std::atof(argv[++i]));
+        }
+        else if (arg == "--bits" && hasValue) {
+            const std::string bits = argv[++i];
+            settings.isFloat = bits == "float";
+            settings.bitsPerSample = settings.isFloat ? 32 : std::atoi(bits.c_str());
+        }
+        else if (arg == "--format" && hasValue) {
+            const std::string format = argv[++i];
+            settings.forceContainer = true;
+            if (!AudioFileFormat::containerForPath("." + format, settings.container)) {
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "--jobs" && hasValue) {
+            jobs = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--output" && hasValue) {
+            outputPath = argv[++i];
+        }
+        else if (arg == "--out-dir" && hasValue) {
+            outDir = argv[++i];
+        }
+        else if (arg == "--list-modules") {
+            listModules = true;
+        }
+        else if (arg == "--list-presets") {
+            listPresets = true;
+        }
+        else if (!arg.empty() && arg[0] != '-') {
+            inputs.push_back(arg);
+        }
+        else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    auto& registry = EffectModuleRegistry::getInstance();
+    if (listModules) {
+        for (const auto& name : registry.getAvailableModules())
+            std::printf("%s\n", name.toRawUTF8());
+        return 0;
+    }
+
+    auto probe = registry.createModule(settings.moduleName.c_str());
+    if (probe == nullptr) {
+        std::fprintf(stderr, "dsp256_render: unknown module '%s' (see --list-modules)\n", settings.moduleName.c_str());
+        return 1;
+    }
+    if (listPresets) {
+        const auto presets = probe->getFactoryPresets();
+        for (size_t i = 0; i < presets.size(); ++i)
+            std::printf("%zu  %s\n", i, presets[i].name.toRawUTF8());
+        return 0;
+    }
+
+    if (inputs.empty() || (outputPath.empty() == outDir.empty()) || (!outputPath.empty() && inputs.size() > 1)) {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<RenderJob> renderJobs;
+    for (const auto& input : inputs)
+        renderJobs.push_back({ input, outputPath.empty() ? outputPathFor(input, outDir, settings) : outputPath });
+
+    // Workers take the next file until none are left
+    std::atomic<size_t> nextJob{ 0 };
+    std::atomic<int> failures{ 0 };
+    auto worker = [&] {
+        for (size_t index = nextJob++; index < renderJobs.size(); index = nextJob++) {
+            const auto& job = renderJobs[index];
+            double realtimeFactor = 0.0;
+            std::string jobError;
+            if (renderFile(settings, job, realtimeFactor, jobError)) {
+                char speed[32];
+                std::snprintf(speed, sizeof(speed), "%.1fx realtime", realtimeFactor);
+                logLine(job.input + " -> " + job.output + "  (" + speed + ")");
+            }
+            else {
+                logLine("dsp256_render: " + jobError);
+                ++failures;
+            }
+        }
+    };
+
+    const auto started = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int i = 1; i < std::min<int>(jobs, static_cast<int>(renderJobs.size())); ++i)
+        workers.emplace_back(worker);
+    worker();
+    for (auto& thread : workers)
+        thread.join();
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    std::fprintf(stderr, "%zu file(s), %d failed, %.2f s\n", renderJobs.size(), failures.load(), seconds);
+    return failures.load() == 0 ? 0 : 1;
+}